@@ -259,8 +259,11 @@ Variable* calcWaterPress = new Variable(
 // For this, we're using the conversion between mbar and mm pure water at 4°C
 // This calculation gives a final result in mm of water
 float calculateWaterDepthRaw(void) {
-    float waterDepth = calculateWaterPressure() * 10.1972;
-    if (calculateWaterPressure() == -9999) waterDepth = -9999;
+    // The water pressure is only calculated once per update; after that the
+    // variable returns the same value
+    float waterPressure = calcWaterPress->getValue();
+    float waterDepth    = waterPressure * 10.1972;
+    if (waterPressure == -9999) waterDepth = -9999;
     // Serial.print(F("'Raw' water depth is "));  // for debugging
     // Serial.println(waterDepth);  // for debugging
     return waterDepth;
@@ -289,7 +292,8 @@ float calculateWaterDepthTempCorrected(void) {
     const float gravitationalConstant =
         9.80665;  // m/s2, meters per second squared
     // First get water pressure in Pa for the calculation: 1 mbar = 100 Pa
-    float waterPressurePa  = 100 * calculateWaterPressure();
+    float waterPressure    = calcWaterPress->getValue();
+    float waterPressurePa  = 100 * waterPressure;
     float waterTempertureC = ms5803Temp->getValue();
     // Converting water depth for the changes of pressure with depth
     // Water density (kg/m3) from equation 6 from
@@ -302,7 +306,7 @@ float calculateWaterDepthTempCorrected(void) {
     // from P = rho * g * h
     float rhoDepth = 1000 * waterPressurePa /
         (waterDensity * gravitationalConstant);
-    if (calculateWaterPressure() == -9999 || waterTempertureC == -9999) {
+    if (waterPressure == -9999 || waterTempertureC == -9999) {
         rhoDepth = -9999;
     }
     // Serial.print(F("Temperature corrected water depth is "));  // for
@@ -444,6 +448,14 @@ void setup() {
     dataLogger.setLoggerPins(wakePin, sdCardSSPin, sdCardPwrPin, buttonPin,
                              greenLED);
 
+    // Declare what each calculated variable is calculated from, so the water
+    // pressure is always calculated first and only once for both depths
+    calcWaterPress->addDependency(ms5803Press);
+    calcWaterPress->addDependency(bme280Press);
+    calcRawDepth->addDependency(calcWaterPress);
+    calcCorrDepth->addDependency(calcWaterPress);
+    calcCorrDepth->addDependency(ms5803Temp);
+
     // Begin the logger
     dataLogger.begin();
 
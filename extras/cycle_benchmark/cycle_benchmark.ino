@@ -0,0 +1,209 @@
+/** =========================================================================
+ * @file cycle_benchmark.ino
+ * @brief Benchmark the cost of a logging cycle for synthetic sensor
+ * configurations of 1 to 64 variables.
+ *
+ * For each configuration, this times VariableArray::completeUpdate(),
+ * Logger::logToSD(), and EnviroDIYPublisher::publishData() and prints the wall
+ * time, processor awake time, and number of passes through the sensor polling
+ * loop.  The synthetic sensors do no real communication, so the results
+ * reflect only the time and work spent inside the library.  Publishing is done
+ * to a client that discards everything written to it.
+ *
+ * The sketch also builds on a host with the minimal Arduino core in the host
+ * folder.  Its clock is virtual: delays and idling skip ahead at once, so a
+ * run takes only the time spent in the library, and the awake time shows how
+ * much of each cycle that is.  The SD card is kept in memory.  Build and run
+ * it from this folder with:
+ * @code{.sh}
+ * S=../../src
+ * g++ -std=c++11 -O2 -D__AVR__ -Ihost -I$S -x c++ cycle_benchmark.ino -x none \
+ *     host/host_arduino.cpp $S/LoggerBase.cpp $S/LoggerModem.cpp \
+ *     $S/VariableArray.cpp $S/VariableBase.cpp $S/SensorBase.cpp \
+ *     $S/SampleBuffer.cpp $S/PowerRail.cpp $S/RecordPipeline.cpp \
+ *     $S/dataPublisherBase.cpp $S/publishers/EnviroDIYPublisher.cpp \
+ *     -o cycle_benchmark
+ * ./cycle_benchmark
+ * @endcode
+ *
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ * @copyright (c) 2017-2022 Stroud Water Research Center (SWRC)
+ *                          and the EnviroDIY Development Team
+ *            This example is published under the BSD-3 license.
+ *
+ * Build Environment: Visual Studios Code with PlatformIO
+ * Hardware Platform: EnviroDIY Mayfly Arduino Datalogger
+ *
+ * DISCLAIMER:
+ * THIS CODE IS PROVIDED "AS IS" - NO WARRANTY IS GIVEN.
+ * ======================================================================= */
+
+#include <Arduino.h>
+#include <EnableInterrupt.h>
+#include <ModularSensors.h>
+#include <publishers/EnviroDIYPublisher.h>
+
+// The largest number of variables to benchmark
+#define BENCHMARK_MAX_VARS 64
+// The number of values returned by each synthetic sensor
+#define BENCHMARK_VARS_PER_SENSOR 4
+// The number of update cycles to average for each configuration
+#define BENCHMARK_REPEATS 3
+
+const int8_t sdCardSSPin = 12;  // SD card chip select/slave select pin
+
+
+// A sensor that returns predictable values on a fixed schedule without talking
+// to any hardware.
+class SyntheticSensor : public Sensor {
+ public:
+    SyntheticSensor(uint8_t sensorNumber, uint8_t numValues,
+                    uint32_t warmUpTime_ms, uint32_t stabilizationTime_ms,
+                    uint32_t measurementTime_ms, uint8_t measurementsToAverage)
+        : Sensor("SyntheticSensor", numValues, warmUpTime_ms,
+                 stabilizationTime_ms, measurementTime_ms, -1, -1,
+                 measurementsToAverage),
+          _sensorNumber(sensorNumber) {}
+
+    String getSensorLocation(void) override {
+        return String(F("Synthetic")) + String(_sensorNumber);
+    }
+
+    bool addSingleMeasurementResult(void) override {
+        for (uint8_t i = 0; i < _numReturnedValues; i++) {
+            verifyAndAddMeasurementResult(
+                i, static_cast<float>(_sensorNumber * 10 + i));
+        }
+        _millisMeasurementRequested = 0;
+        fallBackToState(SENSOR_AWAKE);
+        return true;
+    }
+
+ private:
+    uint8_t _sensorNumber;
+};
+
+
+// A client that accepts everything written to it and answers every request
+// with a canned HTTP response.
+class NullClient : public Client {
+ public:
+    int connect(IPAddress, uint16_t) override {
+        _responseIndex = 0;
+        return 1;
+    }
+    int connect(const char*, uint16_t) override {
+        _responseIndex = 0;
+        return 1;
+    }
+    size_t write(uint8_t) override {
+        return 1;
+    }
+    size_t write(const uint8_t*, size_t size) override {
+        return size;
+    }
+    int available() override {
+        return strlen(_response) - _responseIndex;
+    }
+    int read() override {
+        return available() > 0 ? _response[_responseIndex++] : -1;
+    }
+    int read(uint8_t* buf, size_t size) override {
+        size_t n = 0;
+        while (n < size && available() > 0) { buf[n++] = read(); }
+        return n;
+    }
+    int peek() override {
+        return available() > 0 ? _response[_responseIndex] : -1;
+    }
+    void flush() override {}
+    void stop() override {}
+    uint8_t connected() override {
+        return 1;
+    }
+    operator bool() override {
+        return true;
+    }
+
+ private:
+    const char* _response      = "HTTP/1.1 201 Created\r\n";
+    size_t      _responseIndex = 0;
+};
+
+
+SyntheticSensor* sensors[BENCHMARK_MAX_VARS / BENCHMARK_VARS_PER_SENSOR];
+Variable*        variableList[BENCHMARK_MAX_VARS];
+
+VariableArray      varArray;
+Logger             dataLogger("benchmark", 1, sdCardSSPin, -1, &varArray);
+NullClient         nullClient;
+EnviroDIYPublisher EnviroDIYPOST(dataLogger, &nullClient,
+                                 "12345678-abcd-1234-ef00-1234567890ab",
+                                 "12345678-abcd-1234-ef00-1234567890ab");
+
+
+void setup() {
+    Serial.begin(115200);
+    PRINTOUT(F("ModularSensors cycle benchmark, library version"),
+             MODULAR_SENSORS_VERSION);
+
+    // Create a mix of fast and slow sensors so that the scheduler has real
+    // work to do overlapping them
+    for (uint8_t s = 0; s < BENCHMARK_MAX_VARS / BENCHMARK_VARS_PER_SENSOR;
+         s++) {
+        sensors[s] = new SyntheticSensor(s, BENCHMARK_VARS_PER_SENSOR,
+                                         100 + 50 * (s % 5), 200 * (s % 3),
+                                         50 + 25 * (s % 4), 1 + (s % 3));
+        for (uint8_t v = 0; v < BENCHMARK_VARS_PER_SENSOR; v++) {
+            variableList[s * BENCHMARK_VARS_PER_SENSOR + v] = new Variable(
+                sensors[s], v, 2, "benchmarkValue", "dimensionless", "bench",
+                "");
+        }
+    }
+
+    varArray.begin(1, variableList);
+    dataLogger.begin();
+    dataLogger.setFileName("benchmark.csv");
+
+    PRINTOUT(F("variables, sensors, update wall ms, update awake us, "
+               "update passes, SD write us, publish us"));
+}
+
+
+void loop() {
+    for (uint8_t nVars = 1; nVars <= BENCHMARK_MAX_VARS; nVars *= 2) {
+        varArray.begin(nVars, variableList);
+        varArray.setupSensors();
+
+        uint32_t updateTime  = 0;
+        uint32_t awakeTime   = 0;
+        uint32_t passes      = 0;
+        uint32_t sdTime      = 0;
+        uint32_t publishTime = 0;
+        for (uint8_t r = 0; r < BENCHMARK_REPEATS; r++) {
+            // Mark the time as the logger does, so the records are stamped
+            Logger::markTime();
+            varArray.completeUpdate();
+            updateTime += varArray.getLastUpdateTime();
+            awakeTime += varArray.getLastUpdateAwakeTime();
+            passes += varArray.getLastUpdatePasses();
+
+            uint32_t start = micros();
+            dataLogger.logToSD();
+            sdTime += micros() - start;
+
+            start = micros();
+            EnviroDIYPOST.publishData(&nullClient);
+            publishTime += micros() - start;
+        }
+
+        PRINTOUT(nVars, ',', varArray.getSensorCount(), ',',
+                 updateTime / BENCHMARK_REPEATS, ',',
+                 static_cast<float>(awakeTime) / BENCHMARK_REPEATS, ',',
+                 passes / BENCHMARK_REPEATS, ',', sdTime / BENCHMARK_REPEATS,
+                 ',', publishTime / BENCHMARK_REPEATS);
+    }
+
+    PRINTOUT(F("Benchmark complete.\n"));
+    delay(60000L);
+}
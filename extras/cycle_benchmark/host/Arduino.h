@@ -0,0 +1,387 @@
+/**
+ * @file Arduino.h
+ * @brief A minimal Arduino core for building the cycle benchmark on a host.
+ *
+ * The clock is virtual: delay() and the processor idle sleep advance it at
+ * once instead of waiting, while the time actually spent running library code
+ * still passes on it.  A cycle that would take minutes on the board runs in
+ * the time the host takes for the library's own work.  Serial writes to the
+ * standard output.
+ *
+ * Only the parts of the core used by the library's base classes, the
+ * EnviroDIY publisher, and the benchmark are here.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_ARDUINO_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_ARDUINO_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define strcpy_P strcpy
+#define strcat_P strcat
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncpy_P strncpy
+#define snprintf_P snprintf
+#define sprintf_P sprintf
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) \
+    ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define _BV(bit) (1 << (bit))
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#ifndef abs
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#endif
+#define constrain(amt, low, high) \
+    ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+char* itoa(int value, char* str, int base);
+char* ltoa(long value, char* str, int base);
+char* utoa(unsigned int value, char* str, int base);
+char* ultoa(unsigned long value, char* str, int base);
+char* dtostrf(double value, signed char width, unsigned char prec, char* str);
+
+uint32_t millis(void);
+uint32_t micros(void);
+void     delay(uint32_t ms);
+void     delayMicroseconds(uint32_t us);
+void     yield(void);
+/**
+ * @brief Jump the virtual clock forward without waiting.
+ *
+ * @param ms The time to skip, in ms.
+ */
+void hostAdvanceClock(uint32_t ms);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+/**
+ * @brief The level last written to each pin, read back through the port
+ * input registers as on an AVR board.  Every pin is bit 0 of its own port.
+ */
+extern volatile uint8_t hostPinLevels[256];
+#define digitalPinToPort(pin) (pin)
+#define digitalPinToBitMask(pin) (1)
+#define portInputRegister(port) (&hostPinLevels[port])
+#define portOutputRegister(port) (&hostPinLevels[port])
+
+inline void noInterrupts(void) {}
+inline void interrupts(void) {}
+
+class __FlashStringHelper;
+#define F(string_literal) \
+    (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+
+class String {
+ public:
+    String(const char* cstr = "") : _s(cstr != nullptr ? cstr : "") {}
+    String(const std::string& s) : _s(s) {}  // NOLINT
+    String(const __FlashStringHelper* str)   // NOLINT
+        : _s(reinterpret_cast<const char*>(str)) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = DEC);
+    explicit String(int value, unsigned char base = DEC);
+    explicit String(unsigned int value, unsigned char base = DEC);
+    explicit String(long value, unsigned char base = DEC);
+    explicit String(unsigned long value, unsigned char base = DEC);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    String& operator=(char c) {
+        _s.assign(1, c);
+        return *this;
+    }
+
+    unsigned int length(void) const {
+        return static_cast<unsigned int>(_s.length());
+    }
+    const char* c_str(void) const {
+        return _s.c_str();
+    }
+    bool reserve(unsigned int size) {
+        _s.reserve(size);
+        return true;
+    }
+
+    bool concat(const String& str) {
+        _s += str._s;
+        return true;
+    }
+    bool concat(const char* cstr) {
+        _s += cstr;
+        return true;
+    }
+    bool concat(char c) {
+        _s += c;
+        return true;
+    }
+    template <typename T>
+    bool concat(T value) {
+        return concat(String(value));
+    }
+    template <typename T>
+    String& operator+=(const T& rhs) {
+        concat(rhs);
+        return *this;
+    }
+    String& operator+=(const __FlashStringHelper* rhs) {
+        _s += reinterpret_cast<const char*>(rhs);
+        return *this;
+    }
+
+    bool operator==(const String& rhs) const {
+        return _s == rhs._s;
+    }
+    bool operator==(const char* rhs) const {
+        return _s == rhs;
+    }
+    bool operator!=(const String& rhs) const {
+        return _s != rhs._s;
+    }
+    bool operator!=(const char* rhs) const {
+        return _s != rhs;
+    }
+    bool operator<(const String& rhs) const {
+        return _s < rhs._s;
+    }
+    bool equals(const String& rhs) const {
+        return _s == rhs._s;
+    }
+    bool equalsIgnoreCase(const String& rhs) const;
+    int  compareTo(const String& rhs) const {
+        return _s.compare(rhs._s);
+    }
+    bool startsWith(const String& prefix) const {
+        return _s.compare(0, prefix._s.length(), prefix._s) == 0;
+    }
+    bool endsWith(const String& suffix) const {
+        return _s.length() >= suffix._s.length() &&
+            _s.compare(_s.length() - suffix._s.length(), suffix._s.length(),
+                       suffix._s) == 0;
+    }
+
+    char charAt(unsigned int index) const {
+        return index < _s.length() ? _s[index] : 0;
+    }
+    void setCharAt(unsigned int index, char c) {
+        if (index < _s.length()) { _s[index] = c; }
+    }
+    char operator[](unsigned int index) const {
+        return charAt(index);
+    }
+    char& operator[](unsigned int index) {
+        return _s[index];
+    }
+    void toCharArray(char* buf, unsigned int bufsize,
+                     unsigned int index = 0) const;
+    void getBytes(unsigned char* buf, unsigned int bufsize,
+                  unsigned int index = 0) const {
+        toCharArray(reinterpret_cast<char*>(buf), bufsize, index);
+    }
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String& str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(const String& str) const;
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase(void);
+    void toUpperCase(void);
+    void trim(void);
+
+    long toInt(void) const {
+        return atol(_s.c_str());
+    }
+    float toFloat(void) const {
+        return static_cast<float>(atof(_s.c_str()));
+    }
+    double toDouble(void) const {
+        return atof(_s.c_str());
+    }
+
+ private:
+    std::string _s;
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+String operator+(const String& lhs, char rhs);
+String operator+(const String& lhs, const __FlashStringHelper* rhs);
+String operator+(const String& lhs, int rhs);
+String operator+(const String& lhs, unsigned int rhs);
+String operator+(const String& lhs, long rhs);
+String operator+(const String& lhs, unsigned long rhs);
+String operator+(const String& lhs, float rhs);
+String operator+(const String& lhs, double rhs);
+
+
+class Printable;
+
+class Print {
+ public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t         write(const char* str) {
+        return str == nullptr
+                    ? 0
+                    : write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+    }
+    size_t write(const char* buffer, size_t size) {
+        return write(reinterpret_cast<const uint8_t*>(buffer), size);
+    }
+    virtual int availableForWrite(void) {
+        return 0;
+    }
+    virtual void flush(void) {}
+
+    size_t print(const __FlashStringHelper* str);
+    size_t print(const String& str);
+    size_t print(const char* str);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println(void);
+    template <typename T>
+    size_t println(const T& value) {
+        size_t n = print(value);
+        return n + println();
+    }
+    template <typename T>
+    size_t println(const T& value, int format) {
+        size_t n = print(value, format);
+        return n + println();
+    }
+};
+
+
+class Stream : public Print {
+ public:
+    virtual int available(void) = 0;
+    virtual int read(void)      = 0;
+    virtual int peek(void)      = 0;
+
+    void setTimeout(unsigned long timeout) {
+        _timeout = timeout;
+    }
+    unsigned long getTimeout(void) {
+        return _timeout;
+    }
+    size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        return readBytes(reinterpret_cast<char*>(buffer), length);
+    }
+    size_t readBytesUntil(char terminator, char* buffer, size_t length);
+    String readString(void);
+    String readStringUntil(char terminator);
+    long   parseInt(void);
+    float  parseFloat(void);
+    bool   find(const char* target);
+
+ protected:
+    int           timedRead(void);
+    int           timedPeek(void);
+    unsigned long _timeout = 1000;
+};
+
+
+/**
+ * @brief A serial port writing to the standard output, with nothing to read.
+ */
+class HardwareSerial : public Stream {
+ public:
+    void begin(unsigned long) {}
+    void end(void) {}
+    int  available(void) override {
+        return 0;
+    }
+    int read(void) override {
+        return -1;
+    }
+    int peek(void) override {
+        return -1;
+    }
+    size_t write(uint8_t c) override {
+        return fwrite(&c, 1, 1, stdout);
+    }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        return fwrite(buffer, 1, size, stdout);
+    }
+    using Print::write;
+    void flush(void) override {
+        fflush(stdout);
+    }
+    operator bool() {
+        return true;
+    }
+};
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+
+class IPAddress {
+ public:
+    IPAddress() : _address{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : _address{a, b, c, d} {}
+    uint8_t operator[](int index) const {
+        return _address[index];
+    }
+
+ private:
+    uint8_t _address[4];
+};
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_ARDUINO_H_
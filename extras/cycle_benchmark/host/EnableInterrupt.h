@@ -0,0 +1,15 @@
+/**
+ * @file EnableInterrupt.h
+ * @brief The pin interrupt library, for building the cycle benchmark on a
+ * host.  The host board has no pin interrupts, so these do nothing.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_ENABLEINTERRUPT_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_ENABLEINTERRUPT_H_
+
+#include <Arduino.h>
+
+inline void enableInterrupt(uint8_t, void (*)(void), uint8_t) {}
+inline void disableInterrupt(uint8_t) {}
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_ENABLEINTERRUPT_H_
@@ -0,0 +1,86 @@
+/**
+ * @file SdFat.h
+ * @brief The SdFat library, for building the cycle benchmark on a host.
+ *
+ * Files are kept in memory, so writing to them costs the library's own
+ * formatting work and nothing else.  hostFileSize() reports how much has been
+ * written to a file.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_SDFAT_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_SDFAT_H_
+
+#include <Arduino.h>
+
+#define O_READ 0x01
+#define O_WRITE 0x02
+#define O_RDWR (O_READ | O_WRITE)
+#define O_APPEND 0x04
+#define O_AT_END 0x08
+#define O_CREAT 0x10
+#define O_TRUNC 0x20
+#define O_EXCL 0x40
+
+#define T_ACCESS 1
+#define T_CREATE 2
+#define T_WRITE 4
+
+#define SPI_FULL_SPEED 0
+#define SPI_HALF_SPEED 1
+#define SD_SCK_MHZ(maxMhz) (maxMhz)
+
+/**
+ * @brief A handle to a file held in memory.  Copies of the handle refer to
+ * the same file.
+ */
+class File : public Stream {
+ public:
+    bool open(const char* path, int oflag = O_READ);
+    bool close(void);
+    bool isOpen(void) const {
+        return _contents != nullptr;
+    }
+    operator bool() const {
+        return isOpen();
+    }
+    bool timestamp(uint8_t, uint16_t, uint8_t, uint8_t, uint8_t, uint8_t,
+                   uint8_t) {
+        return isOpen();
+    }
+    bool sync(void) {
+        return isOpen();
+    }
+    uint32_t size(void) const;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available(void) override;
+    int read(void) override;
+    int peek(void) override;
+    void flush(void) override {}
+
+ private:
+    std::string* _contents = nullptr;
+    size_t       _position = 0;
+};
+typedef File SdFile;
+
+class SdFat {
+ public:
+    bool begin(int8_t, uint32_t = SPI_FULL_SPEED) {
+        return true;
+    }
+    bool exists(const char* path);
+    bool remove(const char* path);
+};
+
+/**
+ * @brief Get the number of bytes written to a file held in memory.
+ *
+ * @param path The name of the file
+ * @return **uint32_t** The size of the file, or 0 if it doesn't exist.
+ */
+uint32_t hostFileSize(const char* path);
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_SDFAT_H_
@@ -0,0 +1,80 @@
+/**
+ * @file Sodaq_DS3231.h
+ * @brief The DS3231 real time clock library, for building the cycle benchmark
+ * on a host.
+ *
+ * The clock counts from a fixed start time on the virtual clock of the host
+ * core, so timestamps advance with delay() and idling just as the rest of the
+ * cycle does.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_SODAQ_DS3231_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_SODAQ_DS3231_H_
+
+#include <Arduino.h>
+
+enum { EverySecond, EveryMinute, EveryHour };
+
+/**
+ * @brief A date and time, stored as seconds since January 1, 2000.
+ */
+class DateTime {
+ public:
+    explicit DateTime(uint32_t secondsFrom2000 = 0);
+    DateTime(uint16_t year, uint8_t month, uint8_t date, uint8_t hour,
+             uint8_t minute, uint8_t second, uint8_t weekDay = 0);
+
+    uint16_t year() const {
+        return 2000 + _year;
+    }
+    uint8_t month() const {
+        return _month;
+    }
+    uint8_t date() const {
+        return _date;
+    }
+    uint8_t hour() const {
+        return _hour;
+    }
+    uint8_t minute() const {
+        return _minute;
+    }
+    uint8_t second() const {
+        return _second;
+    }
+    uint8_t dayOfWeek() const {
+        return _weekDay;
+    }
+    uint32_t get() const;
+    uint32_t getEpoch() const {
+        return get() + 946684800UL;
+    }
+    void addToString(String& str) const;
+
+ private:
+    uint8_t _year, _month, _date, _hour, _minute, _second, _weekDay;
+};
+
+class Sodaq_DS3231 {
+ public:
+    void begin(void) {}
+    DateTime now(void);
+    void     setEpoch(uint32_t ts);
+    void     setDateTime(const DateTime& dt) {
+        setEpoch(dt.getEpoch());
+    }
+    void  enableInterrupts(uint8_t) {}
+    void  enableInterrupts(uint8_t, uint8_t, uint8_t) {}
+    void  disableInterrupts(void) {}
+    void  clearINTStatus(void) {}
+    float getTemperature(void) {
+        return 20.0;
+    }
+
+ private:
+    uint32_t _setEpoch    = 1609459200UL;  // 2021-01-01 00:00:00
+    uint32_t _setMillis   = 0;
+};
+extern Sodaq_DS3231 rtc;
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_SODAQ_DS3231_H_
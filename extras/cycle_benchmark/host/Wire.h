@@ -0,0 +1,21 @@
+/**
+ * @file Wire.h
+ * @brief The I2C library, for building the cycle benchmark on a host.  There
+ * is nothing on the host I2C bus.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_WIRE_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_WIRE_H_
+
+#include <Arduino.h>
+
+class TwoWire {
+ public:
+    void begin(void) {}
+    void end(void) {}
+    void setClock(uint32_t) {}
+    void setTimeout(uint32_t) {}
+};
+extern TwoWire Wire;
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_WIRE_H_
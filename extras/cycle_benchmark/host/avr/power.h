@@ -0,0 +1,13 @@
+/**
+ * @file power.h
+ * @brief The AVR power reduction functions, for building the cycle benchmark
+ * on a host, where they do nothing.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_AVR_POWER_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_AVR_POWER_H_
+
+inline void power_all_disable(void) {}
+inline void power_all_enable(void) {}
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_AVR_POWER_H_
@@ -0,0 +1,28 @@
+/**
+ * @file sleep.h
+ * @brief The AVR sleep functions, for building the cycle benchmark on a
+ * host.
+ *
+ * Sleeping the processor jumps the virtual clock forward by one millisecond,
+ * the period of the timer tick that would wake it on the board.
+ */
+
+#ifndef EXTRAS_CYCLE_BENCHMARK_HOST_AVR_SLEEP_H_
+#define EXTRAS_CYCLE_BENCHMARK_HOST_AVR_SLEEP_H_
+
+#include <Arduino.h>
+
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_ADC 1
+#define SLEEP_MODE_PWR_SAVE 2
+#define SLEEP_MODE_STANDBY 3
+#define SLEEP_MODE_PWR_DOWN 4
+
+inline void set_sleep_mode(uint8_t) {}
+inline void sleep_enable(void) {}
+inline void sleep_disable(void) {}
+inline void sleep_cpu(void) {
+    hostAdvanceClock(1);
+}
+
+#endif  // EXTRAS_CYCLE_BENCHMARK_HOST_AVR_SLEEP_H_
@@ -0,0 +1,531 @@
+/**
+ * @file host_arduino.cpp
+ * @brief Implements the host Arduino core, clock, SD card, and watchdog for
+ * the cycle benchmark, and runs the sketch.
+ *
+ * The sketch's setup() is run once, followed by a single run of loop().
+ */
+
+#include <chrono>
+#include <map>
+#include <Arduino.h>
+#include <SdFat.h>
+#include <Sodaq_DS3231.h>
+#include <Wire.h>
+#include "WatchDogs/WatchDogAVR.h"
+
+
+// The virtual clock: the real time since the program started plus all of the
+// time skipped by delays and idling
+static const std::chrono::steady_clock::time_point hostStart =
+    std::chrono::steady_clock::now();
+static uint64_t skipped_us = 0;
+
+static uint64_t hostMicros(void) {
+    auto elapsed = std::chrono::steady_clock::now() - hostStart;
+    return static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                   .count()) +
+        skipped_us;
+}
+uint32_t millis(void) {
+    return static_cast<uint32_t>(hostMicros() / 1000);
+}
+uint32_t micros(void) {
+    return static_cast<uint32_t>(hostMicros());
+}
+void delay(uint32_t ms) {
+    skipped_us += static_cast<uint64_t>(ms) * 1000;
+}
+void delayMicroseconds(uint32_t us) {
+    skipped_us += us;
+}
+void yield(void) {}
+void hostAdvanceClock(uint32_t ms) {
+    skipped_us += static_cast<uint64_t>(ms) * 1000;
+}
+
+
+// The pins only remember what was last written to them
+volatile uint8_t hostPinLevels[256];
+void             pinMode(uint8_t, uint8_t) {}
+void             digitalWrite(uint8_t pin, uint8_t value) {
+    hostPinLevels[pin] = value;
+}
+int digitalRead(uint8_t pin) {
+    return hostPinLevels[pin];
+}
+int analogRead(uint8_t) {
+    return 512;
+}
+long random(long howBig) {
+    return howBig > 0 ? rand() % howBig : 0;
+}
+long random(long howSmall, long howBig) {
+    return howBig > howSmall ? howSmall + random(howBig - howSmall) : howSmall;
+}
+void randomSeed(unsigned long seed) {
+    srand(static_cast<unsigned int>(seed));
+}
+
+
+// Number conversions from the AVR C library
+char* itoa(int value, char* str, int base) {
+    return ltoa(value, str, base);
+}
+char* ltoa(long value, char* str, int base) {
+    String converted(value, static_cast<unsigned char>(base));
+    strcpy(str, converted.c_str());
+    return str;
+}
+char* utoa(unsigned int value, char* str, int base) {
+    return ultoa(value, str, base);
+}
+char* ultoa(unsigned long value, char* str, int base) {
+    String converted(value, static_cast<unsigned char>(base));
+    strcpy(str, converted.c_str());
+    return str;
+}
+char* dtostrf(double value, signed char width, unsigned char prec, char* str) {
+    sprintf(str, "%*.*f", width, prec, value);
+    return str;
+}
+
+
+// Strings
+static std::string integerToString(unsigned long value, unsigned char base,
+                                   bool negative) {
+    if (base < 2) { base = 10; }
+    char  buf[8 * sizeof(long) + 2];
+    char* str = &buf[sizeof(buf) - 1];
+    *str      = '\0';
+    do {
+        char digit = static_cast<char>(value % base);
+        *--str     = digit < 10 ? digit + '0' : digit + 'A' - 10;
+        value /= base;
+    } while (value);
+    if (negative) { *--str = '-'; }
+    return std::string(str);
+}
+static std::string signedToString(long value, unsigned char base) {
+    if (base == 10 && value < 0) {
+        return integerToString(0UL - static_cast<unsigned long>(value), base,
+                               true);
+    }
+    return integerToString(static_cast<unsigned long>(value), base, false);
+}
+static std::string floatToString(double value, unsigned char decimalPlaces) {
+    if (isnan(value)) { return "nan"; }
+    if (isinf(value)) { return "inf"; }
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+    return std::string(buf);
+}
+
+String::String(unsigned char value, unsigned char base)
+    : _s(integerToString(value, base, false)) {}
+String::String(int value, unsigned char base)
+    : _s(signedToString(value, base)) {}
+String::String(unsigned int value, unsigned char base)
+    : _s(integerToString(value, base, false)) {}
+String::String(long value, unsigned char base)
+    : _s(signedToString(value, base)) {}
+String::String(unsigned long value, unsigned char base)
+    : _s(integerToString(value, base, false)) {}
+String::String(float value, unsigned char decimalPlaces)
+    : _s(floatToString(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces)
+    : _s(floatToString(value, decimalPlaces)) {}
+
+bool String::equalsIgnoreCase(const String& rhs) const {
+    if (_s.length() != rhs._s.length()) { return false; }
+    for (size_t i = 0; i < _s.length(); i++) {
+        if (tolower(_s[i]) != tolower(rhs._s[i])) { return false; }
+    }
+    return true;
+}
+void String::toCharArray(char* buf, unsigned int bufsize,
+                         unsigned int index) const {
+    if (bufsize == 0 || buf == nullptr) { return; }
+    if (index >= _s.length()) {
+        buf[0] = '\0';
+        return;
+    }
+    size_t n = _s.copy(buf, bufsize - 1, index);
+    buf[n]   = '\0';
+}
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    size_t found = _s.find(ch, fromIndex);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    size_t found = _s.find(str._s, fromIndex);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+int String::lastIndexOf(char ch) const {
+    size_t found = _s.rfind(ch);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+int String::lastIndexOf(const String& str) const {
+    size_t found = _s.rfind(str._s);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+String String::substring(unsigned int beginIndex) const {
+    return substring(beginIndex, length());
+}
+String String::substring(unsigned int beginIndex,
+                         unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        unsigned int temp = endIndex;
+        endIndex          = beginIndex;
+        beginIndex        = temp;
+    }
+    if (beginIndex >= length()) { return String(); }
+    if (endIndex > length()) { endIndex = length(); }
+    return String(_s.substr(beginIndex, endIndex - beginIndex));
+}
+void String::replace(char find, char replace) {
+    for (size_t i = 0; i < _s.length(); i++) {
+        if (_s[i] == find) { _s[i] = replace; }
+    }
+}
+void String::replace(const String& find, const String& replace) {
+    if (find._s.empty()) { return; }
+    size_t pos = 0;
+    while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+        _s.replace(pos, find._s.length(), replace._s);
+        pos += replace._s.length();
+    }
+}
+void String::remove(unsigned int index) {
+    if (index < _s.length()) { _s.erase(index); }
+}
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < _s.length()) { _s.erase(index, count); }
+}
+void String::toLowerCase(void) {
+    for (char& c : _s) { c = static_cast<char>(tolower(c)); }
+}
+void String::toUpperCase(void) {
+    for (char& c : _s) { c = static_cast<char>(toupper(c)); }
+}
+void String::trim(void) {
+    size_t first = _s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        _s.clear();
+        return;
+    }
+    size_t last = _s.find_last_not_of(" \t\r\n");
+    _s          = _s.substr(first, last - first + 1);
+}
+
+String operator+(const String& lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+String operator+(const String& lhs, const char* rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const char* lhs, const String& rhs) {
+    return String(lhs) + rhs;
+}
+String operator+(const String& lhs, char rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, const __FlashStringHelper* rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, int rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, unsigned int rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, long rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, unsigned long rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, float rhs) {
+    return lhs + String(rhs);
+}
+String operator+(const String& lhs, double rhs) {
+    return lhs + String(rhs);
+}
+
+
+// Printing
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (!write(*buffer++)) { break; }
+        n++;
+    }
+    return n;
+}
+size_t Print::print(const __FlashStringHelper* str) {
+    return write(reinterpret_cast<const char*>(str));
+}
+size_t Print::print(const String& str) {
+    return write(str.c_str(), str.length());
+}
+size_t Print::print(const char* str) {
+    return write(str);
+}
+size_t Print::print(char c) {
+    return write(static_cast<uint8_t>(c));
+}
+size_t Print::print(unsigned char value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+size_t Print::print(int value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+size_t Print::print(unsigned int value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+size_t Print::print(long value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+size_t Print::print(unsigned long value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+size_t Print::print(double value, int digits) {
+    return print(String(value, static_cast<unsigned char>(digits)));
+}
+size_t Print::println(void) {
+    return write("\r\n");
+}
+
+
+// Reading a stream gives up once nothing has arrived for the timeout
+int Stream::timedRead(void) {
+    uint32_t start = millis();
+    do {
+        int c = read();
+        if (c >= 0) { return c; }
+    } while (millis() - start < _timeout);
+    return -1;
+}
+int Stream::timedPeek(void) {
+    uint32_t start = millis();
+    do {
+        int c = peek();
+        if (c >= 0) { return c; }
+    } while (millis() - start < _timeout);
+    return -1;
+}
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) { break; }
+        *buffer++ = static_cast<char>(c);
+        count++;
+    }
+    return count;
+}
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0 || c == terminator) { break; }
+        *buffer++ = static_cast<char>(c);
+        count++;
+    }
+    return count;
+}
+String Stream::readString(void) {
+    String ret;
+    int    c;
+    while ((c = timedRead()) >= 0) { ret += static_cast<char>(c); }
+    return ret;
+}
+String Stream::readStringUntil(char terminator) {
+    String ret;
+    int    c;
+    while ((c = timedRead()) >= 0 && c != terminator) {
+        ret += static_cast<char>(c);
+    }
+    return ret;
+}
+long Stream::parseInt(void) {
+    String digits;
+    int    c;
+    while ((c = timedPeek()) >= 0 && !isdigit(c) && c != '-') { read(); }
+    while ((c = timedPeek()) >= 0 && (isdigit(c) || c == '-')) {
+        digits += static_cast<char>(read());
+    }
+    return digits.toInt();
+}
+float Stream::parseFloat(void) {
+    String digits;
+    int    c;
+    while ((c = timedPeek()) >= 0 && !isdigit(c) && c != '-' && c != '.') {
+        read();
+    }
+    while ((c = timedPeek()) >= 0 && (isdigit(c) || c == '-' || c == '.')) {
+        digits += static_cast<char>(read());
+    }
+    return digits.toFloat();
+}
+bool Stream::find(const char* target) {
+    size_t len   = strlen(target);
+    size_t index = 0;
+    if (len == 0) { return true; }
+    int c;
+    while ((c = timedRead()) >= 0) {
+        index = c == target[index] ? index + 1 : (c == target[0] ? 1 : 0);
+        if (index >= len) { return true; }
+    }
+    return false;
+}
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+TwoWire        Wire;
+
+
+// The real time clock runs on the virtual clock
+static const uint8_t daysInMonth[] = {31, 28, 31, 30, 31, 30,
+                                      31, 31, 30, 31, 30, 31};
+
+DateTime::DateTime(uint32_t t) {
+    _second = t % 60;
+    t /= 60;
+    _minute = t % 60;
+    t /= 60;
+    _hour         = t % 24;
+    uint32_t days = t / 24;
+    _weekDay      = (days + 6) % 7;  // January 1, 2000 was a Saturday
+    uint8_t leap;
+    for (_year = 0;; _year++) {
+        leap = _year % 4 == 0;
+        if (days < 365U + leap) { break; }
+        days -= 365 + leap;
+    }
+    for (_month = 1;; _month++) {
+        uint8_t monthDays = daysInMonth[_month - 1] +
+            (leap && _month == 2 ? 1 : 0);
+        if (days < monthDays) { break; }
+        days -= monthDays;
+    }
+    _date = days + 1;
+}
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t date, uint8_t hour,
+                   uint8_t minute, uint8_t second, uint8_t weekDay)
+    : _year(year >= 2000 ? year - 2000 : year),
+      _month(month),
+      _date(date),
+      _hour(hour),
+      _minute(minute),
+      _second(second),
+      _weekDay(weekDay) {}
+uint32_t DateTime::get() const {
+    uint32_t days = _date - 1;
+    for (uint8_t m = 1; m < _month; m++) {
+        days += daysInMonth[m - 1] + (m == 2 && _year % 4 == 0 ? 1 : 0);
+    }
+    days += 365UL * _year + (_year + 3) / 4;
+    return ((days * 24 + _hour) * 60 + _minute) * 60 + _second;
+}
+void DateTime::addToString(String& str) const {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%04u-%02u-%02u %02u:%02u:%02u", year(),
+             month(), date(), hour(), minute(), second());
+    str += buf;
+}
+
+DateTime Sodaq_DS3231::now(void) {
+    uint32_t epoch = _setEpoch + (millis() - _setMillis) / 1000;
+    return DateTime(epoch - 946684800UL);
+}
+void Sodaq_DS3231::setEpoch(uint32_t ts) {
+    _setEpoch  = ts;
+    _setMillis = millis();
+}
+Sodaq_DS3231 rtc;
+
+
+// The SD card is a set of files in memory
+static std::map<std::string, std::string> hostFiles;
+
+bool File::open(const char* path, int oflag) {
+    auto found = hostFiles.find(path);
+    if (found == hostFiles.end()) {
+        if ((oflag & O_CREAT) == 0) { return false; }
+        found = hostFiles.insert(std::make_pair(path, std::string())).first;
+    }
+    _contents = &found->second;
+    if (oflag & O_TRUNC) { _contents->clear(); }
+    _position = (oflag & O_AT_END) ? _contents->size() : 0;
+    return true;
+}
+bool File::close(void) {
+    bool wasOpen = isOpen();
+    _contents    = nullptr;
+    return wasOpen;
+}
+uint32_t File::size(void) const {
+    return isOpen() ? static_cast<uint32_t>(_contents->size()) : 0;
+}
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!isOpen()) { return 0; }
+    _contents->replace(_position, size, reinterpret_cast<const char*>(buffer),
+                       size);
+    _position += size;
+    return size;
+}
+int File::available(void) {
+    return isOpen() ? static_cast<int>(_contents->size() - _position) : 0;
+}
+int File::read(void) {
+    int c = peek();
+    if (c >= 0) { _position++; }
+    return c;
+}
+int File::peek(void) {
+    return available() > 0
+        ? static_cast<uint8_t>((*_contents)[_position])
+        : -1;
+}
+bool SdFat::exists(const char* path) {
+    return hostFiles.count(path) > 0;
+}
+bool SdFat::remove(const char* path) {
+    return hostFiles.erase(path) > 0;
+}
+uint32_t hostFileSize(const char* path) {
+    auto found = hostFiles.find(path);
+    return found == hostFiles.end()
+        ? 0
+        : static_cast<uint32_t>(found->second.size());
+}
+
+
+// There is no watchdog on the host
+volatile uint32_t extendedWatchDogAVR::_barksUntilReset = 0;
+extendedWatchDogAVR::extendedWatchDogAVR() {}
+extendedWatchDogAVR::~extendedWatchDogAVR() {}
+void extendedWatchDogAVR::setupWatchDog(uint32_t resetTime_s) {
+    _resetTime_s = resetTime_s;
+}
+void extendedWatchDogAVR::enableWatchDog() {}
+void extendedWatchDogAVR::disableWatchDog() {}
+void extendedWatchDogAVR::resetWatchDog() {}
+
+
+// The sketch
+void setup(void);
+void loop(void);
+
+int main(void) {
+    setup();
+    loop();
+    return 0;
+}
@@ -0,0 +1,5 @@
+/**
+ * @file pins_arduino.h
+ * @brief The board pin definitions, for building the cycle benchmark on a
+ * host.  The host board has no named pins.
+ */
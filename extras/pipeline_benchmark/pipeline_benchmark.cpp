@@ -0,0 +1,113 @@
+/** =========================================================================
+ * @file pipeline_benchmark.cpp
+ * @brief Benchmark the throughput and latency of the record pipeline with the
+ * cooperative and threaded backends.
+ *
+ * This is a host program, not a sketch.  Each stage sleeps for a fixed time
+ * standing in for the sensor update, the SD card write, and the publication
+ * of a record.  The cooperative backend runs the stages one after another,
+ * as on the board; the threaded backend runs them at the same time.  For each
+ * backend this prints the total time, the records per second, and the mean
+ * and longest time from the start of a measurement to its publication.
+ *
+ * Build and run it from this folder with:
+ * @code{.sh}
+ * g++ -std=c++11 -O2 -DMS_PIPELINE_THREADS -I../../src pipeline_benchmark.cpp \
+ *     ../../src/RecordPipeline.cpp -pthread -o pipeline_benchmark
+ * ./pipeline_benchmark
+ * @endcode
+ *
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ * @copyright (c) 2017-2022 Stroud Water Research Center (SWRC)
+ *                          and the EnviroDIY Development Team
+ *            This example is published under the BSD-3 license.
+ *
+ * DISCLAIMER:
+ * THIS CODE IS PROVIDED "AS IS" - NO WARRANTY IS GIVEN.
+ * ======================================================================= */
+
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include "RecordPipeline.h"
+
+// The number of records to pass through the pipeline for each backend
+#define BENCHMARK_RECORDS 20
+// The number of values in each record
+#define BENCHMARK_VALUES 8
+// The number of records the ring holds
+#define BENCHMARK_CAPACITY 4
+
+// The time each stage takes for one record, in milliseconds
+const uint32_t stageTime_ms[PIPELINE_STAGE_COUNT] = {30, 10, 40};
+const char*    stageName[PIPELINE_STAGE_COUNT]    = {"measure", "store",
+                                                     "publish"};
+
+
+// Every stage just takes its time; the measurement also fills in the values
+bool syntheticStage(PipelineRecord& record, void* context) {
+    auto stage = static_cast<pipelineStage>(
+        reinterpret_cast<uintptr_t>(context));
+    if (stage == PIPELINE_MEASURE) {
+        record.timestamp = RecordPipeline::now();
+        for (uint8_t i = 0; i < record.valueCount; i++) {
+            record.values[i] = static_cast<float>(i);
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(stageTime_ms[stage]));
+    return true;
+}
+
+
+void printResults(const char* backend, RecordPipeline& pipeline,
+                  uint32_t elapsed) {
+    printf("%-12s %8u ms %8.1f rec/s %8u ms %8u ms %6u\n", backend, elapsed,
+           1000.0 * pipeline.getStageCount(PIPELINE_PUBLISH) / elapsed,
+           pipeline.getMeanLatency(), pipeline.getMaxLatency(),
+           pipeline.getDroppedCount());
+}
+
+
+void setStages(RecordPipeline& pipeline) {
+    for (uintptr_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        pipeline.setStage(static_cast<pipelineStage>(s), syntheticStage,
+                          reinterpret_cast<void*>(s));
+    }
+}
+
+
+int main() {
+    printf("Stage times:");
+    for (uint8_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        printf(" %s %u ms", stageName[s], stageTime_ms[s]);
+    }
+    printf("\n%u records of %u values, ring of %u records\n\n",
+           BENCHMARK_RECORDS, BENCHMARK_VALUES, BENCHMARK_CAPACITY);
+    printf("%-12s %11s %14s %11s %11s %6s\n", "backend", "total",
+           "throughput", "mean lat.", "max lat.", "drops");
+
+    // The cooperative backend, as run on the board: each record is measured,
+    // stored, and published before the next is requested
+    RecordPipelineN<BENCHMARK_VALUES, BENCHMARK_CAPACITY> cooperative;
+    setStages(cooperative);
+    uint32_t start = RecordPipeline::now();
+    for (uint16_t r = 0; r < BENCHMARK_RECORDS; r++) {
+        cooperative.requestMeasurement();
+        while (cooperative.runOnce()) {}
+    }
+    printResults("cooperative", cooperative, RecordPipeline::now() - start);
+
+    // The threaded backend: every record is requested up front and the stages
+    // overlap, limited by the slowest stage and the size of the ring
+    RecordPipelineN<BENCHMARK_VALUES, BENCHMARK_CAPACITY> threaded;
+    setStages(threaded);
+    start = RecordPipeline::now();
+    threaded.startThreads();
+    for (uint16_t r = 0; r < BENCHMARK_RECORDS; r++) {
+        threaded.requestMeasurement();
+    }
+    threaded.stopThreads();
+    printResults("threaded", threaded, RecordPipeline::now() - start);
+
+    return 0;
+}
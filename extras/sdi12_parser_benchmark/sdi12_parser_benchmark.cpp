@@ -0,0 +1,196 @@
+/** =========================================================================
+ * @file sdi12_parser_benchmark.cpp
+ * @brief Benchmark the SDI-12 response parser against the String parsing it
+ * replaced, over a set of recorded SDI-12 transcripts.
+ *
+ * This is a host program, not a sketch.  Each recorded response is parsed
+ * many times by both methods:
+ * - "string" copies the response into a string one character at a time, as
+ * readStringUntil() does, then cuts it up with substrings and converts each
+ * piece, as the old code did with substring(), toInt(), and parseFloat().
+ * - "parser" passes each character to an SDI12Response as it would arrive.
+ *
+ * For each method this prints the time per response and the number of heap
+ * allocations per response, and checks that both found the same values.  The
+ * host's std::string keeps short strings inline, so its count of allocations
+ * is lower than that of the Arduino String, which allocates for every one.  It
+ * also prints the time the board spends reading each response: the old data
+ * request waited 30 ms before reading and 10 ms after every character, while
+ * the parser is done as soon as the last character has arrived at 1200 baud.
+ *
+ * Build and run it from this folder with:
+ * @code{.sh}
+ * g++ -std=c++11 -O2 -I../../src/sensors sdi12_parser_benchmark.cpp \
+ *     ../../src/sensors/SDI12Response.cpp -o sdi12_parser_benchmark
+ * ./sdi12_parser_benchmark
+ * @endcode
+ *
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ * @copyright (c) 2017-2022 Stroud Water Research Center (SWRC)
+ *                          and the EnviroDIY Development Team
+ *            This example is published under the BSD-3 license.
+ *
+ * DISCLAIMER:
+ * THIS CODE IS PROVIDED "AS IS" - NO WARRANTY IS GIVEN.
+ * ======================================================================= */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <string>
+#include "SDI12Response.h"
+
+// The number of times each response is parsed
+#define BENCHMARK_REPEATS 20000
+// The time for one character at 1200 baud (10 bits), in microseconds
+#define SDI12_CHAR_TIME_US 8333
+
+
+// Count every heap allocation
+static uint32_t allocations = 0;
+void*           operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+void operator delete(void* p) noexcept {
+    free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+
+// Replies recorded from sensors on a logger, with their <CR><LF>
+const char* transcripts[] = {
+    // Acknowledgements and replies to measurement commands
+    "1\r\n",
+    "10013\r\n",
+    "20013\r\n",
+    "300205\r\n",
+    // Decagon CTD: depth, temperature, conductivity
+    "1+123+22.5+0\r\n",
+    "1+1287+18.3+1543\r\n",
+    // Decagon 5TM: dielectric permittivity, temperature
+    "2+1.23+22.1\r\n",
+    "2+25.67-3.4\r\n",
+    // Meter Hydros 21: conductivity, temperature, depth
+    "3+0+23.4+45\r\n",
+    // Yosemitech-style many-value response split over D0 and D1
+    "4+7.52+18.734+0.0012+96.44+8.8711\r\n",
+    "4-0.0045+1023.1+12.77\r\n",
+    // Campbell ClariVUE10 with a CRC
+    "5+0.81+0.79+0.93+0.61+1.02+0.86+22.41+0Ox@\r\n",
+    // A noisy line: a stray character in the middle of the values
+    "6+12.34#+5.6\r\n",
+};
+const uint8_t transcriptCount = sizeof(transcripts) / sizeof(transcripts[0]);
+
+
+// The old way: read the whole line into a string, then cut it up
+uint8_t parseWithStrings(const char* transcript, float* values) {
+    std::string line;
+    for (const char* c = transcript; *c != '\0' && *c != '\n'; c++) {
+        line += *c;
+    }
+    // trim()
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) {
+        line.erase(line.size() - 1);
+    }
+    uint8_t count = 0;
+    size_t  start = 1;
+    while (start < line.size() && count < SDI12_RESPONSE_MAX_VALUES) {
+        size_t end = line.find_first_of("+-", start + 1);
+        if (end == std::string::npos) { end = line.size(); }
+        std::string piece = line.substr(start, end - start);
+        char*       stop;
+        float       value = strtof(piece.c_str(), &stop);
+        if (stop != piece.c_str() && (piece[0] == '+' || piece[0] == '-')) {
+            values[count++] = value;
+        }
+        start = end;
+    }
+    return count;
+}
+
+
+// The new way: pass each character to the parser as it arrives
+uint8_t parseWithParser(SDI12Response& response, const char* transcript,
+                        float* values) {
+    response.reset();
+    for (const char* c = transcript; *c != '\0'; c++) {
+        if (response.parse(*c)) { break; }
+    }
+    for (uint8_t i = 0; i < response.getValueCount(); i++) {
+        values[i] = response.getValue(i);
+    }
+    return response.getValueCount();
+}
+
+
+int main() {
+    float    stringValues[SDI12_RESPONSE_MAX_VALUES];
+    float    parserValues[SDI12_RESPONSE_MAX_VALUES];
+    uint32_t mismatches     = 0;
+    uint32_t oldLineTime_us = 0;
+    uint32_t newLineTime_us = 0;
+
+    // Check that both methods agree, and add up the time on the board
+    SDI12Response response;
+    for (uint8_t t = 0; t < transcriptCount; t++) {
+        uint8_t n1   = parseWithStrings(transcripts[t], stringValues);
+        uint8_t n2   = parseWithParser(response, transcripts[t], parserValues);
+        bool    same = n1 == n2;
+        for (uint8_t i = 0; same && i < n1; i++) {
+            same = stringValues[i] == parserValues[i];
+        }
+        if (!same) {
+            mismatches++;
+            printf("Values differ for %s", transcripts[t]);
+        }
+        uint32_t chars = static_cast<uint32_t>(strlen(transcripts[t]));
+        oldLineTime_us += 30000 + chars * 10000;
+        newLineTime_us += chars * SDI12_CHAR_TIME_US;
+    }
+
+    printf("%u recorded responses, each parsed %u times\n\n", transcriptCount,
+           BENCHMARK_REPEATS);
+    printf("%-8s %14s %18s\n", "method", "ns/response", "allocations/resp.");
+
+    volatile uint32_t sink = 0;
+    uint32_t          startAllocations = allocations;
+    auto              start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < BENCHMARK_REPEATS; r++) {
+        for (uint8_t t = 0; t < transcriptCount; t++) {
+            sink += parseWithStrings(transcripts[t], stringValues);
+        }
+    }
+    auto     stop  = std::chrono::steady_clock::now();
+    uint32_t total = BENCHMARK_REPEATS * transcriptCount;
+    printf("%-8s %14.1f %18.2f\n", "string",
+           std::chrono::duration<double, std::nano>(stop - start).count() /
+               total,
+           static_cast<double>(allocations - startAllocations) / total);
+
+    startAllocations = allocations;
+    start            = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < BENCHMARK_REPEATS; r++) {
+        for (uint8_t t = 0; t < transcriptCount; t++) {
+            sink += parseWithParser(response, transcripts[t], parserValues);
+        }
+    }
+    stop = std::chrono::steady_clock::now();
+    printf("%-8s %14.1f %18.2f\n", "parser",
+           std::chrono::duration<double, std::nano>(stop - start).count() /
+               total,
+           static_cast<double>(allocations - startAllocations) / total);
+
+    printf("\nTime reading the responses on the board: %u ms before, %u ms "
+           "now\n",
+           oldLineTime_us / 1000, newLineTime_us / 1000);
+    printf("%u responses parsed differently\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -269,6 +269,11 @@ String Logger::getVarUUIDAtI(uint8_t position_i) {
 // This returns the current value of the variable as a string with the
 // correct number of significant figures
 String Logger::getValueStringAtI(uint8_t position_i) {
+    // While a pipeline record is being stored or published, report its values
+    if (_loadedRecord != nullptr && position_i < _loadedRecord->valueCount) {
+        return _internalArray->arrayOfVars[position_i]->formatValue(
+            _loadedRecord->values[position_i]);
+    }
     return _internalArray->arrayOfVars[position_i]->getValueString();
 }
 
@@ -285,6 +290,131 @@ void Logger::attachModem(loggerModem& modem) {
 }
 
 
+// These functions set and get whether the modem registers on the network while
+// the sensors are being updated
+void Logger::setPipelinedPublishing(bool enable) {
+    _pipelinedPublishing = enable;
+}
+bool Logger::getPipelinedPublishing(void) {
+    return _pipelinedPublishing;
+}
+
+
+// This attaches a record pipeline and sets its stages to the logger's
+void Logger::attachPipeline(RecordPipeline& pipeline) {
+    _pipeline = &pipeline;
+    _pipeline->setStage(PIPELINE_MEASURE, &Logger::measureRecord, this);
+    _pipeline->setStage(PIPELINE_STORE, &Logger::storeRecord, this);
+    _pipeline->setStage(PIPELINE_PUBLISH, &Logger::publishRecord, this);
+}
+
+
+// The record's time replaces the marked time while it is loaded
+void Logger::loadRecord(PipelineRecord* record) {
+    if (record != nullptr && _loadedRecord == nullptr) {
+        _unloadedUTCEpochTime = Logger::markedUTCEpochTime;
+    }
+    _loadedRecord = record;
+    Logger::markedUTCEpochTime =
+        record != nullptr ? record->timestamp : _unloadedUTCEpochTime;
+    Logger::markedLocalEpochTime = Logger::markedUTCEpochTime +
+        ((uint32_t)_loggerRTCOffset) * 3600;
+}
+
+
+// The sensor cadences count logging intervals from the epoch, so they don't
+// restart with the board
+void Logger::markArrayInterval(void) {
+    if (Logger::markedLocalEpochTime == 0) { return; }
+    _internalArray->setIntervalNumber(Logger::markedLocalEpochTime /
+                                      (_loggingIntervalMinutes * 60UL));
+}
+
+
+// The pipeline stages
+bool Logger::measureRecord(PipelineRecord& record, void* logger) {
+    auto* self = static_cast<Logger*>(logger);
+    // Do a complete update on the variable array.
+    MS_DBG(F("Running a complete sensor update..."));
+    self->watchDogTimer.resetWatchDog();
+    self->markArrayInterval();
+    bool success = self->_internalArray->completeUpdate();
+    self->watchDogTimer.resetWatchDog();
+
+// Print out the sensor data
+#if defined(STANDARD_SERIAL_OUTPUT)
+    MS_DBG('\n');
+    self->_internalArray->printSensorData(&STANDARD_SERIAL_OUTPUT);
+    MS_DBG('\n');
+#endif
+
+    record.timestamp = Logger::markedUTCEpochTime;
+    for (uint8_t i = 0; i < record.valueCount; i++) {
+        record.values[i] = i < self->getArrayVarCount()
+            ? self->_internalArray->arrayOfVars[i]->getValue()
+            : -9999;
+    }
+    return success;
+}
+bool Logger::storeRecord(PipelineRecord& record, void* logger) {
+    auto* self = static_cast<Logger*>(logger);
+    self->loadRecord(&record);
+    bool success = self->logToSD();
+    self->loadRecord(nullptr);
+    return success;
+}
+bool Logger::publishRecord(PipelineRecord& record, void* logger) {
+    auto* self = static_cast<Logger*>(logger);
+    if (self->_logModem == nullptr) { return true; }
+    if (!self->_pipelineConnected) {
+        if (!self->_pipelineModemAwake) {
+            // If the modem was to be woken before the sensor update and
+            // wasn't, don't try again now
+            if (self->_pipelinedPublishing) { return false; }
+            MS_DBG(F("Waking up"), self->_logModem->getModemName(), F("..."));
+            if (!self->_logModem->modemWake()) { return false; }
+            self->_pipelineModemAwake = true;
+        }
+        // Connect to the network
+        self->watchDogTimer.resetWatchDog();
+        MS_DBG(F("Connecting to the Internet..."));
+        self->_pipelineConnected = self->_logModem->connectInternet();
+        self->watchDogTimer.resetWatchDog();
+        if (!self->_pipelineConnected) {
+            MS_DBG(F("Could not connect to the internet!"));
+            return false;
+        }
+    }
+    self->loadRecord(&record);
+    bool success = self->publishDataToRemotes();
+    self->loadRecord(nullptr);
+    self->watchDogTimer.resetWatchDog();
+    // A record that any publisher failed to take is kept for the next pass
+    return success;
+}
+
+
+// This syncs the clock and modem metadata and disconnects from the internet
+void Logger::closeInternetConnection(void) {
+    if ((Logger::markedLocalEpochTime != 0 &&
+         Logger::markedLocalEpochTime % 86400 == 43200) ||
+        !isRTCSane(Logger::markedLocalEpochTime)) {
+        // Sync the clock at noon
+        MS_DBG(F("Running a daily clock sync..."));
+        setRTClock(_logModem->getNISTTime());
+        watchDogTimer.resetWatchDog();
+    }
+
+    // Update the modem metadata
+    MS_DBG(F("Updating modem metadata..."));
+    _logModem->updateModemMetadata();
+
+    // Disconnect from the network
+    MS_DBG(F("Disconnecting from the Internet..."));
+    _logModem->disconnectInternet();
+}
+
+
 // Takes advantage of the modem to synchronize the clock
 bool Logger::syncRTC() {
     bool success = false;
@@ -346,17 +476,22 @@ void Logger::registerDataPublisher(dataPublisher* publisher) {
 }
 
 
-void Logger::publishDataToRemotes(void) {
+bool Logger::publishDataToRemotes(void) {
     MS_DBG(F("Sending out remote data."));
 
+    bool success = true;
     for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
         if (dataPublishers[i] != nullptr) {
             PRINTOUT(F("\nSending data to ["), i, F("]"),
                      dataPublishers[i]->getEndpoint());
-            dataPublishers[i]->publishData();
+            int16_t result = dataPublishers[i]->publishData();
+            // The http publishers return the status code of the response; the
+            // MQTT publishers return true or false
+            success &= result == 1 || (result >= 200 && result < 300);
             watchDogTimer.resetWatchDog();
         }
     }
+    return success;
 }
 void Logger::sendDataToRemotes(void) {
     publishDataToRemotes();
@@ -1441,6 +1576,7 @@ void Logger::logData(void) {
         // Do a complete sensor update
         MS_DBG(F("    Running a complete sensor update..."));
         watchDogTimer.resetWatchDog();
+        markArrayInterval();
         _internalArray->completeUpdate();
         watchDogTimer.resetWatchDog();
 
@@ -1486,61 +1622,81 @@ void Logger::logDataAndPublish(void) {
         // the card and writing to it.  Could we turn it on just before writing?
         turnOnSDcard(false);
 
-        // Do a complete update on the variable array.
-        // This this includes powering all of the sensors, getting updated
-        // values, and turing them back off.
-        // NOTE:  The wake function for each sensor should force sensor setup to
-        // run if the sensor was not previously set up.
-        MS_DBG(F("Running a complete sensor update..."));
-        watchDogTimer.resetWatchDog();
-        _internalArray->completeUpdate();
-        watchDogTimer.resetWatchDog();
+        // If pipelining, wake the modem now so it can register on the network
+        // while the sensors are being updated
+        bool modemAwake = false;
+        if (_logModem != nullptr && _pipelinedPublishing) {
+            MS_DBG(F("Waking up"), _logModem->getModemName(),
+                   F("to register during the sensor update..."));
+            modemAwake = _logModem->modemWake();
+            watchDogTimer.resetWatchDog();
+            // Keep the modem's draw out of the sensors' power budget while it
+            // is awake
+            _internalArray->setReservedCurrent(_logModem->getPowerDraw());
+        }
+
+        if (_pipeline != nullptr) {
+            // Pass a new record through the pipeline, along with any earlier
+            // records that have not yet been published
+            _pipelineConnected  = false;
+            _pipelineModemAwake = modemAwake;
+            _pipeline->requestMeasurement();
+            while (_pipeline->runOnce()) { watchDogTimer.resetWatchDog(); }
+
+            if (_logModem != nullptr) {
+                if (_pipelineConnected) { closeInternetConnection(); }
+                // Turn the modem off
+                _logModem->modemSleepPowerDown();
+                _internalArray->setReservedCurrent(0);
+            }
+        } else {
+            // Do a complete update on the variable array.
+            // This this includes powering all of the sensors, getting updated
+            // values, and turing them back off.
+            // NOTE:  The wake function for each sensor should force sensor
+            // setup to run if the sensor was not previously set up.
+            MS_DBG(F("Running a complete sensor update..."));
+            watchDogTimer.resetWatchDog();
+            markArrayInterval();
+            _internalArray->completeUpdate();
+            watchDogTimer.resetWatchDog();
 
 // Print out the sensor data
 #if defined(STANDARD_SERIAL_OUTPUT)
-        MS_DBG('\n');
-        _internalArray->printSensorData(&STANDARD_SERIAL_OUTPUT);
-        MS_DBG('\n');
+            MS_DBG('\n');
+            _internalArray->printSensorData(&STANDARD_SERIAL_OUTPUT);
+            MS_DBG('\n');
 #endif
 
-        // Create a csv data record and save it to the log file
-        logToSD();
+            // Create a csv data record and save it to the log file
+            logToSD();
 
-        if (_logModem != nullptr) {
-            MS_DBG(F("Waking up"), _logModem->getModemName(), F("..."));
-            if (_logModem->modemWake()) {
-                // Connect to the network
-                watchDogTimer.resetWatchDog();
-                MS_DBG(F("Connecting to the Internet..."));
-                if (_logModem->connectInternet()) {
-                    // Publish data to remotes
-                    watchDogTimer.resetWatchDog();
-                    publishDataToRemotes();
+            if (_logModem != nullptr) {
+                if (!_pipelinedPublishing) {
+                    MS_DBG(F("Waking up"), _logModem->getModemName(),
+                           F("..."));
+                    modemAwake = _logModem->modemWake();
+                }
+                if (modemAwake) {
+                    // Connect to the network; if the modem was woken before
+                    // the sensor update, it should already be registered
                     watchDogTimer.resetWatchDog();
-
-                    if ((Logger::markedLocalEpochTime != 0 &&
-                         Logger::markedLocalEpochTime % 86400 == 43200) ||
-                        !isRTCSane(Logger::markedLocalEpochTime)) {
-                        // Sync the clock at noon
-                        MS_DBG(F("Running a daily clock sync..."));
-                        setRTClock(_logModem->getNISTTime());
+                    MS_DBG(F("Connecting to the Internet..."));
+                    if (_logModem->connectInternet()) {
+                        // Publish data to remotes
+                        watchDogTimer.resetWatchDog();
+                        publishDataToRemotes();
+                        watchDogTimer.resetWatchDog();
+                        closeInternetConnection();
+                    } else {
+                        MS_DBG(F("Could not connect to the internet!"));
                         watchDogTimer.resetWatchDog();
                     }
-
-                    // Update the modem metadata
-                    MS_DBG(F("Updating modem metadata..."));
-                    _logModem->updateModemMetadata();
-
-                    // Disconnect from the network
-                    MS_DBG(F("Disconnecting from the Internet..."));
-                    _logModem->disconnectInternet();
-                } else {
-                    MS_DBG(F("Could not connect to the internet!"));
-                    watchDogTimer.resetWatchDog();
                 }
+                // Turn the modem off
+                _logModem->modemSleepPowerDown();
+                _internalArray->setReservedCurrent(0);
             }
-            // Turn the modem off
-            _logModem->modemSleepPowerDown();
         }
 
 
@@ -31,6 +31,7 @@
 #undef MS_DEBUGGING_DEEP
 #include "VariableArray.h"
 #include "LoggerModem.h"
+#include "RecordPipeline.h"
 
 // Bring in the libraries to handle the processor sleep/standby modes
 // The SAMD library can also the built-in clock on those modules
@@ -548,6 +549,46 @@ class Logger {
      * @param modem An instance of the loggerModem class
      */
     void attachModem(loggerModem& modem);
+    /**
+     * @brief Set whether logDataAndPublish() wakes the modem before updating
+     * the sensors instead of after logging the data.
+     *
+     * A cellular modem registers on the network by itself once it is awake,
+     * so waking it first lets registration run while the sensors warm up,
+     * stabilize, and measure.  The data is then published as soon as it has
+     * been saved to the SD card, and the time awake each interval is close to
+     * the longer of the sensor and network times rather than their sum.  The
+     * modem and the sensors are powered at the same time; if the variable
+     * array has a power budget, the modem's draw (see
+     * loggerModem::setPowerDraw()) is reserved out of it while the sensors are
+     * powered.  WiFi modems only join a network once they are given the
+     * credentials in connectInternet(), so they gain little.
+     *
+     * @param enable True to wake the modem before the sensor update
+     */
+    void setPipelinedPublishing(bool enable);
+    /**
+     * @brief Check whether logDataAndPublish() wakes the modem before updating
+     * the sensors.
+     *
+     * @return **bool** True if the modem is woken before the sensor update
+     */
+    bool getPipelinedPublishing(void);
+    /**
+     * @brief Attach a record pipeline to pass the records of
+     * logDataAndPublish() from measurement to storage to publication.
+     *
+     * Each interval, logDataAndPublish() asks the pipeline for a new record
+     * and runs it with the cooperative backend.  The pipeline's stages are set
+     * to update the sensors, save the record to the SD card, and publish it.
+     * A record that could not be published stays in the pipeline and is
+     * published with the record of a later interval.  The pipeline must hold
+     * at least as many values per record as there are variables in the
+     * variable array.
+     *
+     * @param pipeline A record pipeline, such as a RecordPipelineN
+     */
+    void attachPipeline(RecordPipeline& pipeline);
     /**
      * @brief Use the attahed loggerModem to synchronize the real-time clock
      * with NIST time servers.
@@ -564,8 +605,11 @@ class Logger {
     void registerDataPublisher(dataPublisher* publisher);
     /**
      * @brief Publish data to all registered data publishers.
+     *
+     * @return **bool** True if every publisher reported success: an http
+     * status in the 200's, or true from an MQTT publisher.
      */
-    void publishDataToRemotes(void);
+    bool publishDataToRemotes(void);
     /**
      * @brief Retained for backwards compatibility, use publishDataToRemotes()
      * in new code.
@@ -584,6 +628,83 @@ class Logger {
      */
     loggerModem* _logModem = nullptr;
     // ^^ Start with no modem attached
+    /**
+     * @brief True to wake the modem before the sensor update in
+     * logDataAndPublish()
+     */
+    bool _pipelinedPublishing = false;
+    /**
+     * @brief The attached record pipeline, if any
+     */
+    RecordPipeline* _pipeline = nullptr;
+    /**
+     * @brief The pipeline record whose values are reported by
+     * getValueStringAtI() while it is stored or published, if any
+     */
+    PipelineRecord* _loadedRecord = nullptr;
+    /**
+     * @brief The marked UTC epoch time to go back to when no pipeline record
+     * is loaded
+     */
+    uint32_t _unloadedUTCEpochTime = 0;
+    /**
+     * @brief True once the publication stage has connected to the internet
+     * during the current run of the pipeline
+     */
+    bool _pipelineConnected = false;
+    /**
+     * @brief True if the modem is already awake when the pipeline is run
+     *
+     * With pipelined publishing the modem is woken before the sensor update,
+     * so the publication stage must not wake it again.
+     */
+    bool _pipelineModemAwake = false;
+    /**
+     * @brief Make a record the one reported to the SD card and publishers, or
+     * go back to the current values.
+     *
+     * @param record The record, or nullptr for the current values
+     */
+    void loadRecord(PipelineRecord* record);
+    /**
+     * @brief Give the variable array the number of the logging interval the
+     * marked time is in, counting from the epoch, so sensors with a
+     * measurement cadence are measured in step with the clock.
+     */
+    void markArrayInterval(void);
+    /**
+     * @brief The pipeline measurement stage: update the sensors and copy the
+     * values into the record.
+     *
+     * @param record The record to fill in
+     * @param logger The logger
+     * @return **bool** True if the update succeeded
+     */
+    static bool measureRecord(PipelineRecord& record, void* logger);
+    /**
+     * @brief The pipeline storage stage: save the record to the SD card.
+     *
+     * @param record The record to save
+     * @param logger The logger
+     * @return **bool** True if the record was saved
+     */
+    static bool storeRecord(PipelineRecord& record, void* logger);
+    /**
+     * @brief The pipeline publication stage: connect to the internet if not
+     * already connected and send the record to the data publishers.
+     *
+     * @param record The record to publish
+     * @param logger The logger
+     * @return **bool** True if there is no modem, or if every publisher took
+     * the record.  A record any publisher failed to take is published again
+     * to all of them later.
+     */
+    static bool publishRecord(PipelineRecord& record, void* logger);
+    /**
+     * @brief Finish with an internet connection: sync the clock once a day,
+     * update the modem metadata, and disconnect.
+     */
+    void closeInternetConnection(void);
 
     /**
      * @brief An array of all of the attached data publishers
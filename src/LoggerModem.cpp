@@ -269,6 +269,14 @@ void loggerModem::setModemResetLevel(bool level) {
 }
 
 
+void loggerModem::setPowerDraw(uint16_t current_mA) {
+    _powerDraw_mA = current_mA;
+}
+uint16_t loggerModem::getPowerDraw(void) {
+    return _powerDraw_mA;
+}
+
+
 void loggerModem::setModemPinModes(void) {
     // Set-up pin modes
     if (!_pinModesSet) {
@@ -424,6 +424,24 @@ class loggerModem {
      * state _and_ then powered off
      */
     virtual bool modemSleepPowerDown(void);
+    /**
+     * @brief Set the current the modem draws while it is awake.
+     *
+     * A logger that wakes the modem before updating its sensors (see
+     * Logger::setPipelinedPublishing()) reserves this current out of the
+     * power budget of its variable array, so the sensors are staggered around
+     * the modem.  Until it is set it is 0 and the modem does not count
+     * against the budget.
+     *
+     * @param current_mA The current drawn while the modem is awake, in mA.
+     */
+    void setPowerDraw(uint16_t current_mA);
+    /**
+     * @brief Get the current the modem draws while it is awake.
+     *
+     * @return **uint16_t** The current, in mA.
+     */
+    uint16_t getPowerDraw(void);
     /**@}*/
 
     /**
@@ -895,6 +913,10 @@ class loggerModem {
      * Should be set to a negative number if no LED is available.
      */
     int8_t _modemLEDPin;
+    /**
+     * @brief The current drawn while the modem is awake, in mA.
+     */
+    uint16_t _powerDraw_mA = 0;
 
     /**
      * @brief The processor elapsed time when the power was turned on for the
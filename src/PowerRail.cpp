@@ -0,0 +1,67 @@
+/**
+ * @file PowerRail.cpp
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Implements the PowerRail class.
+ */
+
+#include "PowerRail.h"
+
+
+// Constructor
+PowerRail::PowerRail(int8_t powerPin) : _powerPin(powerPin) {}
+// Destructor
+PowerRail::~PowerRail() {}
+
+
+// This adds a sensor to the rail
+void PowerRail::attachSensor(void) {
+    _sensorCount++;
+}
+
+
+// This marks that the rail is on and all of its sensors are using it
+void PowerRail::powerUp(void) {
+    // Only restart the on-time if the rail was actually off
+    if (!_isOn) {
+        _millisPowerOn = millis();
+        _onTime_ms     = 0;
+    }
+    _isOn           = true;
+    _activeSensors  = _sensorCount;
+    _poweredSensors = _sensorCount;
+}
+
+
+// This releases the rail for one finished sensor
+bool PowerRail::release(void) {
+    if (_activeSensors > 0) { _activeSensors--; }
+    if (_activeSensors == 0) {
+        MS_DBG(F("All sensors on pin"), _powerPin, F("have finished."));
+        return true;
+    }
+    return false;
+}
+
+
+// This marks that one sensor on the rail has been powered down
+void PowerRail::sensorPoweredDown(void) {
+    if (_poweredSensors > 0) { _poweredSensors--; }
+    // Once every sensor on the rail is off, so is the rail
+    if (_poweredSensors == 0 && _isOn) {
+        _isOn          = false;
+        _activeSensors = 0;
+        _onTime_ms     = millis() - _millisPowerOn;
+        MS_DBG(F("Power rail on pin"), _powerPin, F("was on for"), _onTime_ms,
+               F("ms."));
+    }
+}
+
+
+// This returns the time the rail has been on
+uint32_t PowerRail::getOnTime(void) {
+    if (_isOn) { return millis() - _millisPowerOn; }
+    return _onTime_ms;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file PowerRail.h
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Contains the PowerRail class.
+ *
+ * @copydetails PowerRail
+ */
+
+// Header Guards
+#ifndef SRC_POWERRAIL_H_
+#define SRC_POWERRAIL_H_
+
+// Debugging Statement
+// #define MS_POWERRAIL_DEBUG
+
+#ifdef MS_POWERRAIL_DEBUG
+#define MS_DEBUGGING_STD "PowerRail"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+
+
+/**
+ * @brief The power rail class keeps track of the sensors sharing a single
+ * switched power pin.
+ *
+ * A power rail is any pin on the mcu used to switch power to one or more
+ * sensors or to an adapter (such as an RS485 converter) used by those sensors.
+ * Each sensor attached to a variable array can be on up to two rails - its
+ * primary power pin and its secondary power pin, if it has one.
+ *
+ * The rail counts the sensors that depend on it.  During an update, each
+ * sensor releases its rails as soon as it has finished all of its
+ * measurements.  Once every sensor on a rail has released it, the rail is
+ * idle.  A sensor is only powered down when all of the rails it is on are idle,
+ * so cutting power to one sensor can never cut power out from under another
+ * sensor that is still measuring.
+ *
+ * The rail does not write to its pin itself; the sensors on it still handle
+ * their own power pins.  The rail only keeps track of when its pin may be
+ * turned off and how long it was on.
+ *
+ * @ingroup base_classes
+ */
+class PowerRail {
+ public:
+    /**
+     * @brief Construct a new Power Rail object
+     *
+     * @param powerPin The pin on the mcu controlling power to the rail.
+     */
+    explicit PowerRail(int8_t powerPin = -1);
+    /**
+     * @brief Destroy the Power Rail object - no action taken.
+     */
+    ~PowerRail();
+
+    /**
+     * @brief Get the pin controlling power to the rail.
+     *
+     * @return **int8_t** The pin on the mcu controlling power to the rail.
+     */
+    int8_t getPowerPin(void) {
+        return _powerPin;
+    }
+
+    /**
+     * @brief Add a sensor to the count of sensors that depend on this rail.
+     */
+    void attachSensor(void);
+    /**
+     * @brief Get the number of sensors that depend on this rail.
+     *
+     * @return **uint8_t** The number of sensors on the rail.
+     */
+    uint8_t getSensorCount(void) {
+        return _sensorCount;
+    }
+
+    /**
+     * @brief Mark that the rail has been powered and that all of its sensors
+     * are now using it.
+     */
+    void powerUp(void);
+    /**
+     * @brief Release the rail for one sensor that has finished all of its
+     * measurements.
+     *
+     * @return **bool** True if this was the last sensor using the rail; that
+     * is, the rail is now idle.
+     */
+    bool release(void);
+    /**
+     * @brief Check whether any sensors are still using the rail.
+     *
+     * @return **bool** True if no sensor is still using the rail.
+     */
+    bool isIdle(void) {
+        return _activeSensors == 0;
+    }
+    /**
+     * @brief Mark that one sensor on the rail has been powered down.  Once all
+     * of the sensors on the rail have been powered down, the rail is
+     * considered off.
+     */
+    void sensorPoweredDown(void);
+    /**
+     * @brief Check whether the rail is currently on.
+     *
+     * @return **bool** True if the rail is on.
+     */
+    bool isOn(void) {
+        return _isOn;
+    }
+
+    /**
+     * @brief Get the length of time the rail was on during the most recent
+     * update, or so far in the current update if the rail is still on.
+     *
+     * @return **uint32_t** The time the rail was on, in ms.
+     */
+    uint32_t getOnTime(void);
+
+ protected:
+    /**
+     * @brief The pin on the mcu controlling power to the rail.
+     */
+    int8_t _powerPin;
+    /**
+     * @brief The number of sensors that depend on the rail.
+     */
+    uint8_t _sensorCount = 0;
+    /**
+     * @brief The number of sensors that have not yet released the rail in the
+     * current update.
+     */
+    uint8_t _activeSensors = 0;
+    /**
+     * @brief The number of sensors on the rail that have not yet been powered
+     * down.
+     */
+    uint8_t _poweredSensors = 0;
+    /**
+     * @brief True while the rail is on.
+     */
+    bool _isOn = false;
+    /**
+     * @brief The processor millis() when the rail was powered.
+     */
+    uint32_t _millisPowerOn = 0;
+    /**
+     * @brief The time the rail was on in the most recent update, in ms.
+     */
+    uint32_t _onTime_ms = 0;
+};
+
+#endif  // SRC_POWERRAIL_H_
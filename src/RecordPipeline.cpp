@@ -0,0 +1,270 @@
+/**
+ * @file RecordPipeline.cpp
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Implements the RecordPipeline class.
+ */
+
+#include "RecordPipeline.h"
+
+#ifdef MS_PIPELINE_THREADS
+#include <chrono>
+#endif
+
+
+// Constructor
+RecordPipeline::RecordPipeline(PipelineRecord* records, float* values,
+                               uint8_t valuesPerRecord, uint8_t capacity)
+    : _records(records),
+      _capacity(capacity),
+      _requested(0),
+      _publishFailed(false) {
+    for (uint8_t r = 0; r < _capacity; r++) {
+        _records[r].timestamp     = 0;
+        _records[r].millisStarted = 0;
+        _records[r].values =
+            &values[static_cast<uint16_t>(r) * valuesPerRecord];
+        _records[r].valueCount = valuesPerRecord;
+    }
+    for (uint8_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        _stageFxn[s]     = nullptr;
+        _stageContext[s] = nullptr;
+        _finished[s]     = 0;
+        _busy[s]         = false;
+    }
+    resetStatistics();
+}
+// Destructor
+RecordPipeline::~RecordPipeline() {
+#ifdef MS_PIPELINE_THREADS
+    stopThreads();
+#endif
+}
+
+
+void RecordPipeline::setStage(pipelineStage stage, pipelineStageFxn fxn,
+                              void* context) {
+    if (stage >= PIPELINE_STAGE_COUNT) { return; }
+    _stageFxn[stage]     = fxn;
+    _stageContext[stage] = context;
+}
+
+
+void RecordPipeline::requestMeasurement(void) {
+#ifdef MS_PIPELINE_THREADS
+    std::lock_guard<std::mutex> guard(_lock);
+#endif
+    if (_requested < 255) { _requested++; }
+#ifdef MS_PIPELINE_THREADS
+    _moved.notify_all();
+#endif
+}
+
+
+// The cooperative backend runs each ready stage in order, so a new record can
+// be measured, stored, and published in a single call
+bool RecordPipeline::runOnce(void) {
+    bool moved = false;
+    for (uint8_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        auto stage = static_cast<pipelineStage>(s);
+        if (isReady(stage)) { moved |= runStage(stage); }
+    }
+    return moved;
+}
+
+
+// This checks if a stage has a record to work on
+bool RecordPipeline::isReady(pipelineStage stage) {
+    if (_busy[stage]) { return false; }
+    switch (stage) {
+        case PIPELINE_MEASURE: {
+            if (_requested == 0) { return false; }
+            uint32_t held = _finished[PIPELINE_MEASURE] -
+                _finished[PIPELINE_PUBLISH];
+            if (held < _capacity) { return true; }
+            // A full ring can only make room by dropping a stored record
+            return _finished[PIPELINE_STORE] > _finished[PIPELINE_PUBLISH] &&
+                !_busy[PIPELINE_PUBLISH];
+        }
+        case PIPELINE_STORE:
+            return _finished[PIPELINE_STORE] < _finished[PIPELINE_MEASURE];
+        case PIPELINE_PUBLISH:
+            return !_publishFailed &&
+                _finished[PIPELINE_PUBLISH] < _finished[PIPELINE_STORE];
+        default: return false;
+    }
+}
+
+
+PipelineRecord& RecordPipeline::recordAt(uint32_t position) {
+    return _records[position % _capacity];
+}
+
+
+// This takes the next record for a stage, making room for a measurement if
+// the ring is full
+PipelineRecord& RecordPipeline::claimRecord(pipelineStage stage) {
+    if (stage == PIPELINE_MEASURE) {
+        if (_finished[PIPELINE_MEASURE] - _finished[PIPELINE_PUBLISH] >=
+            _capacity) {
+            MS_DBG(F("Record pipeline is full; dropping the oldest unpublished "
+                     "record"));
+            _finished[PIPELINE_PUBLISH]++;
+            _dropped++;
+        }
+        _requested--;
+    }
+    _busy[stage]           = true;
+    PipelineRecord& record = recordAt(_finished[stage]);
+    if (stage == PIPELINE_MEASURE) { record.millisStarted = now(); }
+    return record;
+}
+
+
+// This passes a record on to the next stage
+bool RecordPipeline::finishRecord(pipelineStage stage, bool success,
+                                  uint32_t elapsed) {
+    _busy[stage] = false;
+    _stageTime[stage] += elapsed;
+    // A record that failed to publish is kept to try again with the next one
+    if (stage == PIPELINE_PUBLISH && !success) {
+        MS_DBG(F("Record could not be published; keeping it for later"));
+        _publishFailed = true;
+        return false;
+    }
+    if (stage == PIPELINE_PUBLISH) {
+        uint32_t latency =
+            now() - recordAt(_finished[PIPELINE_PUBLISH]).millisStarted;
+        if (latency > _maxLatency) { _maxLatency = latency; }
+        _totalLatency += latency;
+    }
+    // A newly stored record is another chance to publish
+    if (stage == PIPELINE_STORE) { _publishFailed = false; }
+    _finished[stage]++;
+    _stageCount[stage]++;
+    return true;
+}
+
+
+// This runs a stage for its next record on the cooperative backend
+bool RecordPipeline::runStage(pipelineStage stage) {
+    PipelineRecord& record  = claimRecord(stage);
+    uint32_t        start   = now();
+    bool            success = _stageFxn[stage] == nullptr ||
+        _stageFxn[stage](record, _stageContext[stage]);
+    return finishRecord(stage, success, now() - start);
+}
+
+
+uint8_t RecordPipeline::getWaiting(pipelineStage stage) {
+    switch (stage) {
+        case PIPELINE_MEASURE: return _requested;
+        case PIPELINE_STORE:
+            return _finished[PIPELINE_MEASURE] - _finished[PIPELINE_STORE];
+        case PIPELINE_PUBLISH:
+            return _finished[PIPELINE_STORE] - _finished[PIPELINE_PUBLISH];
+        default: return 0;
+    }
+}
+uint32_t RecordPipeline::getStageCount(pipelineStage stage) {
+    if (stage >= PIPELINE_STAGE_COUNT) { return 0; }
+    return _stageCount[stage];
+}
+uint32_t RecordPipeline::getStageTime(pipelineStage stage) {
+    if (stage >= PIPELINE_STAGE_COUNT) { return 0; }
+    return _stageTime[stage];
+}
+uint32_t RecordPipeline::getDroppedCount(void) {
+    return _dropped;
+}
+uint32_t RecordPipeline::getMaxLatency(void) {
+    return _maxLatency;
+}
+uint32_t RecordPipeline::getMeanLatency(void) {
+    uint32_t published = _stageCount[PIPELINE_PUBLISH];
+    return published > 0 ? _totalLatency / published : 0;
+}
+void RecordPipeline::resetStatistics(void) {
+    for (uint8_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        _stageCount[s] = 0;
+        _stageTime[s]  = 0;
+    }
+    _dropped      = 0;
+    _maxLatency   = 0;
+    _totalLatency = 0;
+}
+
+
+uint32_t RecordPipeline::now(void) {
+#ifdef MS_PIPELINE_THREADS
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#else
+    return millis();
+#endif
+}
+
+
+#ifdef MS_PIPELINE_THREADS
+void RecordPipeline::startThreads(void) {
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_running) { return; }
+        _running = true;
+    }
+    for (uint8_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        _threads[s] = std::thread(&RecordPipeline::stageThread, this,
+                                  static_cast<pipelineStage>(s));
+    }
+}
+
+
+// The pipeline is drained when nothing is left to measure or store, no stage
+// is busy, and every record has been published or publication has failed
+void RecordPipeline::stopThreads(void) {
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        if (!_running) { return; }
+        _moved.wait(guard, [this] {
+            return _requested == 0 && !_busy[PIPELINE_MEASURE] &&
+                !_busy[PIPELINE_STORE] && !_busy[PIPELINE_PUBLISH] &&
+                _finished[PIPELINE_STORE] == _finished[PIPELINE_MEASURE] &&
+                (_publishFailed ||
+                 _finished[PIPELINE_PUBLISH] == _finished[PIPELINE_STORE]);
+        });
+        _running = false;
+    }
+    _moved.notify_all();
+    for (uint8_t s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        if (_threads[s].joinable()) { _threads[s].join(); }
+    }
+}
+
+
+// Each thread waits for its stage to have a record, then runs the stage
+// function without holding the lock so the stages overlap
+void RecordPipeline::stageThread(pipelineStage stage) {
+    std::unique_lock<std::mutex> guard(_lock);
+    while (true) {
+        _moved.wait(guard, [this, stage] {
+            return !_running || isReady(stage);
+        });
+        if (!_running) { return; }
+
+        PipelineRecord& record = claimRecord(stage);
+        guard.unlock();
+        uint32_t start   = now();
+        bool     success = _stageFxn[stage] == nullptr ||
+            _stageFxn[stage](record, _stageContext[stage]);
+        uint32_t elapsed = now() - start;
+        guard.lock();
+
+        finishRecord(stage, success, elapsed);
+        _moved.notify_all();
+    }
+}
+#endif
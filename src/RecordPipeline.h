@@ -0,0 +1,379 @@
+/**
+ * @file RecordPipeline.h
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Contains the RecordPipeline and RecordPipelineN classes.
+ *
+ * @copydetails RecordPipeline
+ */
+
+// Header Guards
+#ifndef SRC_RECORDPIPELINE_H_
+#define SRC_RECORDPIPELINE_H_
+
+// Included Dependencies
+#ifdef MS_PIPELINE_THREADS
+// The threaded backend is for host builds, which have no Arduino core
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+// Without the Arduino core there is nowhere to print debugging
+#ifndef MS_DBG
+#define MS_DBG(...)
+#endif
+#else
+// Debugging Statement
+// #define MS_RECORDPIPELINE_DEBUG
+
+#ifdef MS_RECORDPIPELINE_DEBUG
+#define MS_DEBUGGING_STD "RecordPipeline"
+#endif
+
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#endif
+
+
+/**
+ * @brief The stages each record passes through, in order.
+ */
+typedef enum pipelineStage {
+    PIPELINE_MEASURE = 0,  ///< Take the measurements and fill in the record
+    PIPELINE_STORE,        ///< Save the record, usually to the SD card
+    PIPELINE_PUBLISH,      ///< Send the record to the data publishers
+    PIPELINE_STAGE_COUNT   ///< The number of stages
+} pipelineStage;
+
+/**
+ * @brief One record passing through the pipeline.
+ */
+struct PipelineRecord {
+    /**
+     * @brief The timestamp of the record, usually the logger's marked local
+     * epoch time.
+     */
+    uint32_t timestamp;
+    /**
+     * @brief The pipeline clock time when the measurement of the record
+     * started, used to find its latency.
+     */
+    uint32_t millisStarted;
+    /**
+     * @brief The values of the record, one per variable.
+     */
+    float* values;
+    /**
+     * @brief The number of values in the record.
+     */
+    uint8_t valueCount;
+};
+
+/**
+ * @brief The function run by a stage for one record.
+ *
+ * The function returns false if the stage failed.  A failed measurement or
+ * storage still passes the record on, as the serial logging functions do, but
+ * a failed publication leaves the record to be published again later.
+ */
+typedef bool (*pipelineStageFxn)(PipelineRecord& record, void* context);
+
+
+/**
+ * @brief The record pipeline passes records from measurement to storage to
+ * publication through a bounded ring of records.
+ *
+ * The logger's work is otherwise one long serial function.  Splitting it into
+ * stages lets storage and publication of earlier records go on while a new
+ * record is measured, and keeps records that could not be published in the
+ * ring to be published with the next one.
+ *
+ * The ring holds a fixed number of records.  Each record is filled in by the
+ * measurement stage, then saved by the storage stage, then sent by the
+ * publication stage, after which its slot is free again.  When the ring is
+ * full of records that have been saved but not published, the oldest is
+ * dropped to make room for a new measurement - it is already on the SD card.
+ * If the storage stage has fallen behind, the measurement waits instead.
+ *
+ * There are two backends:
+ * - The cooperative backend, for AVR and SAMD, runs each stage in turn on a
+ * single core with runOnce().
+ * - The threaded backend, for host builds with `MS_PIPELINE_THREADS` defined,
+ * runs each stage on its own `std::thread` so the stages overlap.  It is
+ * meant for benchmarking the throughput and latency of the stages.
+ *
+ * The storage for the records is fixed at compile time; create a pipeline
+ * with the RecordPipelineN template.
+ *
+ * @ingroup base_classes
+ */
+class RecordPipeline {
+ public:
+    /**
+     * @brief Construct a new Record Pipeline object on existing storage.
+     *
+     * @note Use RecordPipelineN rather than constructing this directly.
+     *
+     * @param records Storage for capacity records
+     * @param values Storage for capacity * valuesPerRecord values
+     * @param valuesPerRecord The number of values in each record
+     * @param capacity The number of records the ring holds
+     */
+    RecordPipeline(PipelineRecord* records, float* values,
+                   uint8_t valuesPerRecord, uint8_t capacity);
+    /**
+     * @brief Destroy the Record Pipeline object, stopping any threads.
+     */
+    ~RecordPipeline();
+
+    /**
+     * @brief Set the function run by a stage.
+     *
+     * @param stage The stage
+     * @param fxn The function to run for each record
+     * @param context A pointer passed to the function, such as the logger
+     */
+    void setStage(pipelineStage stage, pipelineStageFxn fxn, void* context);
+
+    /**
+     * @brief Ask for a new record to be measured.
+     */
+    void requestMeasurement(void);
+
+    /**
+     * @brief Run each stage once, if it has a record to work on.
+     *
+     * This is the cooperative backend.  Call it until it returns false to
+     * pass every requested record as far through the pipeline as it can go.
+     *
+     * @return **bool** True if any record moved to its next stage.
+     */
+    bool runOnce(void);
+
+#ifdef MS_PIPELINE_THREADS
+    /**
+     * @brief Start a thread for each stage.
+     */
+    void startThreads(void);
+    /**
+     * @brief Wait for every requested record to be published, or for the
+     * publication stage to fail, then stop the threads.
+     */
+    void stopThreads(void);
+#endif
+
+    /**
+     * @brief Get the number of records waiting for a stage.
+     *
+     * @param stage The stage
+     * @return **uint8_t** The number of records waiting for the stage
+     */
+    uint8_t getWaiting(pipelineStage stage);
+    /**
+     * @brief Get the number of records a stage has finished.
+     *
+     * @param stage The stage
+     * @return **uint32_t** The number of records finished
+     */
+    uint32_t getStageCount(pipelineStage stage);
+    /**
+     * @brief Get the total time a stage has spent on records.
+     *
+     * @param stage The stage
+     * @return **uint32_t** The time spent, in milliseconds
+     */
+    uint32_t getStageTime(pipelineStage stage);
+    /**
+     * @brief Get the number of records dropped unpublished to make room for
+     * new measurements.
+     *
+     * @return **uint32_t** The number of records dropped
+     */
+    uint32_t getDroppedCount(void);
+    /**
+     * @brief Get the longest time from the start of a measurement to the
+     * publication of its record.
+     *
+     * @return **uint32_t** The longest latency, in milliseconds
+     */
+    uint32_t getMaxLatency(void);
+    /**
+     * @brief Get the mean time from the start of a measurement to the
+     * publication of its record.
+     *
+     * @return **uint32_t** The mean latency, in milliseconds
+     */
+    uint32_t getMeanLatency(void);
+    /**
+     * @brief Reset the stage counts and times, drops, and latencies.
+     */
+    void resetStatistics(void);
+
+    /**
+     * @brief Get the pipeline clock.
+     *
+     * This is millis() on the board and a steady clock for host builds.
+     *
+     * @return **uint32_t** The pipeline clock time, in milliseconds
+     */
+    static uint32_t now(void);
+
+ protected:
+    /**
+     * @brief Take the next record for a stage, which must be ready for it.
+     *
+     * @param stage The stage
+     * @return **PipelineRecord&** The record
+     */
+    PipelineRecord& claimRecord(pipelineStage stage);
+    /**
+     * @brief Pass a record on from a stage once the stage function is done.
+     *
+     * @param stage The stage
+     * @param success The return from the stage function
+     * @param elapsed The time the stage function took, in milliseconds
+     * @return **bool** True if the record moved on to the next stage
+     */
+    bool finishRecord(pipelineStage stage, bool success, uint32_t elapsed);
+    /**
+     * @brief Run a stage for its next record.
+     *
+     * @param stage The stage
+     * @return **bool** True if the record moved on to the next stage
+     */
+    bool runStage(pipelineStage stage);
+    /**
+     * @brief Check if a stage has a record to work on.
+     *
+     * @param stage The stage
+     * @return **bool** True if the stage can run
+     */
+    bool isReady(pipelineStage stage);
+    /**
+     * @brief Get the record at a position in the ring.
+     *
+     * @param position The running position of the record
+     * @return **PipelineRecord&** The record
+     */
+    PipelineRecord& recordAt(uint32_t position);
+
+    /**
+     * @brief The record storage.
+     */
+    PipelineRecord* _records;
+    /**
+     * @brief The number of records the ring holds.
+     */
+    uint8_t _capacity;
+    /**
+     * @brief The function run by each stage.
+     */
+    pipelineStageFxn _stageFxn[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief The context passed to the function of each stage.
+     */
+    void* _stageContext[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief The running number of records that have finished each stage.
+     *
+     * A record's slot in the ring is its running number modulo the capacity.
+     * The records between the counts of two stages are waiting for the later
+     * stage.
+     */
+    uint32_t _finished[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief True while a stage is working on a record.
+     */
+    bool _busy[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief The number of measurements requested but not yet started.
+     */
+    uint8_t _requested;
+    /**
+     * @brief True if the last attempt to publish failed; publication waits for
+     * a new record before trying again.
+     */
+    bool _publishFailed;
+    /**
+     * @brief The number of records each stage has finished since the
+     * statistics were reset.
+     */
+    uint32_t _stageCount[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief The time each stage has spent on records since the statistics
+     * were reset.
+     */
+    uint32_t _stageTime[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief The number of records dropped unpublished.
+     */
+    uint32_t _dropped;
+    /**
+     * @brief The longest latency of a published record.
+     */
+    uint32_t _maxLatency;
+    /**
+     * @brief The sum of the latencies of the published records.
+     */
+    uint32_t _totalLatency;
+
+#ifdef MS_PIPELINE_THREADS
+    /**
+     * @brief The body of the thread for a stage.
+     *
+     * @param stage The stage
+     */
+    void stageThread(pipelineStage stage);
+    /**
+     * @brief Guards the ring positions and statistics.
+     */
+    std::mutex _lock;
+    /**
+     * @brief Signalled whenever a record moves or a measurement is requested.
+     */
+    std::condition_variable _moved;
+    /**
+     * @brief The thread for each stage.
+     */
+    std::thread _threads[PIPELINE_STAGE_COUNT];
+    /**
+     * @brief True while the threads should keep running.
+     */
+    bool _running = false;
+#endif
+};
+
+
+/**
+ * @brief A record pipeline with its storage sized at compile time.
+ *
+ * For example, to hold up to 4 records of 12 variables:
+ * @code{cpp}
+ * RecordPipelineN<12, 4> pipeline;
+ * dataLogger.attachPipeline(pipeline);
+ * @endcode
+ *
+ * @tparam ValuesPerRecord The number of values in each record; at least the
+ * number of variables in the logger's variable array.
+ * @tparam Capacity The number of records the ring holds.
+ *
+ * @ingroup base_classes
+ */
+template <uint8_t ValuesPerRecord, uint8_t Capacity>
+class RecordPipelineN : public RecordPipeline {
+ public:
+    /**
+     * @brief Construct a new Record Pipeline object using its own storage.
+     */
+    RecordPipelineN()
+        : RecordPipeline(_recordStorage, _valueStorage, ValuesPerRecord,
+                         Capacity) {}
+
+ private:
+    PipelineRecord _recordStorage[Capacity];
+    float          _valueStorage[ValuesPerRecord * Capacity];
+};
+
+#endif  // SRC_RECORDPIPELINE_H_
@@ -0,0 +1,129 @@
+/**
+ * @file SampleBuffer.cpp
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Implements the SampleBuffer class.
+ */
+
+#include "SampleBuffer.h"
+
+
+// Constructor
+SampleBuffer::SampleBuffer(float* samples, uint8_t* counts, uint8_t numResults,
+                           uint8_t capacity)
+    : _samples(samples),
+      _counts(counts),
+      _numResults(numResults),
+      _capacity(capacity) {}
+// Destructor
+SampleBuffer::~SampleBuffer() {}
+
+
+// This discards all samples
+void SampleBuffer::clear(void) {
+    for (uint8_t i = 0; i < _numResults; i++) { _counts[i] = 0; }
+}
+
+
+// This adds a sample for a result, if there's room for it
+bool SampleBuffer::add(uint8_t resultNumber, float value) {
+    if (resultNumber >= _numResults) { return false; }
+    if (_counts[resultNumber] >= _capacity) {
+        MS_DBG(F("No room for sample"), value, F("of result"), resultNumber,
+               F("; the buffer holds only"), _capacity, F("samples."));
+        return false;
+    }
+    uint16_t row = static_cast<uint16_t>(resultNumber) * _capacity;
+    _samples[row + _counts[resultNumber]] = value;
+    _counts[resultNumber]++;
+    return true;
+}
+
+
+// This returns the number of samples held for a result
+uint8_t SampleBuffer::getCount(uint8_t resultNumber) {
+    if (resultNumber >= _numResults) { return 0; }
+    return _counts[resultNumber];
+}
+
+
+// This returns the median of the samples of a result
+float SampleBuffer::getMedian(uint8_t resultNumber) {
+    uint8_t n = getCount(resultNumber);
+    if (n == 0) { return -9999; }
+    float* values = &_samples[static_cast<uint16_t>(resultNumber) * _capacity];
+
+    float lower = select(values, 0, n - 1, (n - 1) / 2);
+    if (n % 2 == 1) { return lower; }
+    // For an even number of samples, the median is halfway between the two
+    // middle samples.  After selecting the lower one, the upper one is the
+    // smallest of the samples after it.
+    float upper = values[n / 2];
+    for (uint8_t i = n / 2 + 1; i < n; i++) {
+        if (values[i] < upper) { upper = values[i]; }
+    }
+    return (lower + upper) / 2;
+}
+
+
+// This returns the mean of the samples of a result after discarding the given
+// percent of the samples from each end
+float SampleBuffer::getTrimmedMean(uint8_t resultNumber, uint8_t trimPercent) {
+    uint8_t n = getCount(resultNumber);
+    if (n == 0) { return -9999; }
+    float* values = &_samples[static_cast<uint16_t>(resultNumber) * _capacity];
+
+    // Always keep at least one sample
+    uint8_t trim = static_cast<uint16_t>(n) * trimPercent / 100;
+    if (2 * trim >= n) { trim = (n - 1) / 2; }
+    if (trim > 0) {
+        // Move the smallest samples to the front and then the largest of the
+        // rest to the back; what's left between them is kept
+        select(values, 0, n - 1, trim);
+        select(values, trim, n - 1, n - 1 - trim);
+    }
+    float sum = 0;
+    for (uint8_t i = trim; i < n - trim; i++) { sum += values[i]; }
+    MS_DBG(F("Averaged"), n - 2 * trim, F("of"), n, F("samples of result"),
+           resultNumber);
+    return sum / (n - 2 * trim);
+}
+
+
+// This is Hoare's selection algorithm (quickselect).  Each pass partitions the
+// samples around a pivot and continues only into the side holding position k.
+float SampleBuffer::select(float* values, uint8_t first, uint8_t last,
+                           uint8_t k) {
+    int16_t lo = first;
+    int16_t hi = last;
+    while (lo < hi) {
+        // The middle sample makes a good pivot even if the samples are already
+        // nearly in order
+        float   pivot = values[(lo + hi) / 2];
+        int16_t i     = lo;
+        int16_t j     = hi;
+        while (i <= j) {
+            while (values[i] < pivot) { i++; }
+            while (values[j] > pivot) { j--; }
+            if (i <= j) {
+                float swap = values[i];
+                values[i]  = values[j];
+                values[j]  = swap;
+                i++;
+                j--;
+            }
+        }
+        // Now everything up to j is <= the pivot and everything from i on is
+        // >= the pivot; anything between them equals the pivot
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return values[k];
+}
@@ -0,0 +1,178 @@
+/**
+ * @file SampleBuffer.h
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Contains the SampleBuffer and SampleBufferN classes.
+ *
+ * @copydetails SampleBuffer
+ */
+
+// Header Guards
+#ifndef SRC_SAMPLEBUFFER_H_
+#define SRC_SAMPLEBUFFER_H_
+
+// Debugging Statement
+// #define MS_SAMPLEBUFFER_DEBUG
+
+#ifdef MS_SAMPLEBUFFER_DEBUG
+#define MS_DEBUGGING_STD "SampleBuffer"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+
+
+/**
+ * @brief The sample buffer class holds the individual measurements of each
+ * result of a sensor so they can be averaged by something more robust than
+ * the arithmetic mean.
+ *
+ * A single spike - a sonar multipath return or a bubble past a turbidity
+ * sensor - can badly skew the mean of a handful of readings.  The median and
+ * the trimmed mean ignore the extremes.  Both are found with a selection
+ * algorithm (quickselect), which partially orders the samples in place in
+ * linear time on average rather than fully sorting them.
+ *
+ * The storage for the samples is fixed at compile time; create a buffer with
+ * the SampleBufferN template and attach it to a sensor with
+ * Sensor::setAveragingMode().  Measurements beyond the buffer's capacity are
+ * not kept, so the capacity should be at least the number of measurements the
+ * sensor averages.
+ *
+ * @ingroup base_classes
+ */
+class SampleBuffer {
+ public:
+    /**
+     * @brief Construct a new Sample Buffer object on existing storage.
+     *
+     * @note Use SampleBufferN rather than constructing this directly.
+     *
+     * @param samples Storage for numResults * capacity samples
+     * @param counts Storage for numResults sample counts
+     * @param numResults The number of results to keep samples for
+     * @param capacity The number of samples to keep for each result
+     */
+    SampleBuffer(float* samples, uint8_t* counts, uint8_t numResults,
+                 uint8_t capacity);
+    /**
+     * @brief Destroy the Sample Buffer object - no action taken.
+     */
+    ~SampleBuffer();
+
+    /**
+     * @brief Discard all samples.
+     */
+    void clear(void);
+    /**
+     * @brief Add a sample for one result.
+     *
+     * @param resultNumber The position of the result within the sensor's
+     * result array.
+     * @param value The sample to add.
+     * @return **bool** True if the sample was kept; false if the result has
+     * no space in the buffer.
+     */
+    bool add(uint8_t resultNumber, float value);
+    /**
+     * @brief Get the number of samples kept for a result.
+     *
+     * @param resultNumber The position of the result within the sensor's
+     * result array.
+     * @return **uint8_t** The number of samples.
+     */
+    uint8_t getCount(uint8_t resultNumber);
+
+    /**
+     * @brief Get the median of the samples of a result.
+     *
+     * The samples are reordered.
+     *
+     * @param resultNumber The position of the result within the sensor's
+     * result array.
+     * @return **float** The median; -9999 if there are no samples.
+     */
+    float getMedian(uint8_t resultNumber);
+    /**
+     * @brief Get the mean of the samples of a result after discarding the
+     * highest and lowest samples.
+     *
+     * The samples are reordered.
+     *
+     * @param resultNumber The position of the result within the sensor's
+     * result array.
+     * @param trimPercent The percent of the samples to discard from each end.
+     * @return **float** The trimmed mean; -9999 if there are no samples.
+     */
+    float getTrimmedMean(uint8_t resultNumber, uint8_t trimPercent);
+
+ protected:
+    /**
+     * @brief Partially order samples so that the sample at position k is the
+     * one that would be there if they were sorted, with smaller or equal
+     * samples before it and larger or equal samples after it.
+     *
+     * @param values The samples
+     * @param first The first position of the samples to consider
+     * @param last The last position of the samples to consider
+     * @param k The position to select, between first and last
+     * @return **float** The value selected for position k
+     */
+    static float select(float* values, uint8_t first, uint8_t last,
+                        uint8_t k);
+
+    /**
+     * @brief The sample storage, with one row of #_capacity samples for each
+     * result.
+     */
+    float* _samples;
+    /**
+     * @brief The number of samples held for each result.
+     */
+    uint8_t* _counts;
+    /**
+     * @brief The number of results the buffer holds samples for.
+     */
+    uint8_t _numResults;
+    /**
+     * @brief The number of samples the buffer holds for each result.
+     */
+    uint8_t _capacity;
+};
+
+
+/**
+ * @brief A sample buffer with its storage sized at compile time.
+ *
+ * For example, to keep up to 15 samples of the single result of a sonar:
+ * @code{cpp}
+ * SampleBufferN<1, 15> sonarSamples;
+ * sonar.setAveragingMode(AVERAGE_MEDIAN, &sonarSamples);
+ * @endcode
+ *
+ * @tparam NumResults The number of results to keep samples for, starting from
+ * the sensor's first result.
+ * @tparam Capacity The number of samples to keep for each result.
+ *
+ * @ingroup base_classes
+ */
+template <uint8_t NumResults, uint8_t Capacity>
+class SampleBufferN : public SampleBuffer {
+ public:
+    /**
+     * @brief Construct a new Sample Buffer object using its own storage.
+     */
+    SampleBufferN()
+        : SampleBuffer(_sampleStorage, _countStorage, NumResults, Capacity) {
+        clear();
+    }
+
+ private:
+    float   _sampleStorage[NumResults * Capacity];
+    uint8_t _countStorage[NumResults];
+};
+
+#endif  // SRC_SAMPLEBUFFER_H_
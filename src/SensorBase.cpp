@@ -27,16 +27,55 @@ Sensor::Sensor(const char* sensorName, const uint8_t totalReturnedValues,
       _incCalcValues(incCalcValues),
       _warmUpTime_ms(warmUpTime_ms),
       _stabilizationTime_ms(stabilizationTime_ms),
-      _measurementTime_ms(measurementTime_ms) {
+      _measurementTime_ms(measurementTime_ms),
+      _timedOut(false),
+      _updating(false),
+      _updateWasOn(false),
+      _updateWasActive(false),
+      _updateSuccess(true),
+      _updateMeasuring(false) {
+    // Size the result arrays to the number of values the sensor actually
+    // returns.  The variables, values, and counts share a single block, in
+    // that order so each array starts aligned, to keep the sensor to one
+    // small allocation.
+    uint8_t numResults = _numReturnedValues > 0 ? _numReturnedValues : 1;
+
+    uint8_t* block = new uint8_t[numResults *
+                                 (sizeof(Variable*) + sizeof(float) + 1)];
+    variables      = reinterpret_cast<Variable**>(block);
+    sensorValues   = reinterpret_cast<float*>(block +
+                                            numResults * sizeof(Variable*));
+    numberGoodMeasurementsMade = block +
+        numResults * (sizeof(Variable*) + sizeof(float));
     // Clear arrays
-    for (uint8_t i = 0; i < MAX_NUMBER_VARS; i++) {
+    for (uint8_t i = 0; i < numResults; i++) {
         variables[i]                  = nullptr;
         sensorValues[i]               = -9999;
         numberGoodMeasurementsMade[i] = 0;
     }
 }
-// Destructor
-Sensor::~Sensor() {}
+// Destructor - frees the result arrays and any optional state
+Sensor::~Sensor() {
+    // The values and counts are in the same block as the variables
+    delete[] reinterpret_cast<uint8_t*>(variables);
+    delete[] _resultStatistics;
+    delete _schedule;
+    delete _health;
+    delete _averaging;
+    delete _readinessProbe;
+    delete _stabilityLearning;
+}
+
+
+// The optional state is only created once something is set in it
+Sensor::SensorSchedule* Sensor::useSchedule(void) {
+    if (_schedule == nullptr) { _schedule = new SensorSchedule(); }
+    return _schedule;
+}
+Sensor::SensorHealth* Sensor::useHealth(void) {
+    if (_health == nullptr) { _health = new SensorHealth(); }
+    return _health;
+}
 
 
 // This gets the place the sensor is installed ON THE MAYFLY (ie, pin number)
@@ -63,6 +102,51 @@ String Sensor::getSensorNameAndLocation(void) {
 int8_t Sensor::getPowerPin(void) {
     return _powerPin;
 }
+// This returns the secondary power pin - only some sensors have one
+int8_t Sensor::getSecondaryPowerPin(void) {
+    return -1;
+}
+
+
+// These return the type and identity of the sensor's communication bus
+// By default, sensors are not on a shared bus
+sensorBusType Sensor::getBusType(void) {
+    return NO_BUS;
+}
+uintptr_t Sensor::getBusId(void) {
+    return 0;
+}
+// By default, sensors can measure while other sensors use the same bus
+bool Sensor::needsExclusiveBus(void) {
+    return false;
+}
+
+
+// These functions get and set the current drawn by the sensor
+void Sensor::setPowerDraw(uint16_t peakCurrent_mA, uint16_t steadyCurrent_mA,
+                          uint32_t inrushTime_ms) {
+    SensorSchedule* schedule   = useSchedule();
+    schedule->peakCurrent_mA   = peakCurrent_mA;
+    schedule->steadyCurrent_mA = steadyCurrent_mA;
+    schedule->inrushTime_ms    = inrushTime_ms;
+}
+uint16_t Sensor::getPeakCurrent(void) {
+    return _schedule != nullptr ? _schedule->peakCurrent_mA : 0;
+}
+uint16_t Sensor::getSteadyCurrent(void) {
+    return _schedule != nullptr ? _schedule->steadyCurrent_mA : 0;
+}
+// Without a separate inrush time, assume the sensor draws its peak current
+// until it is warmed up
+uint32_t Sensor::getInrushTime(void) {
+    if (_schedule != nullptr && _schedule->inrushTime_ms > 0) {
+        return _schedule->inrushTime_ms;
+    }
+    return _warmUpTime_ms;
+}
+uint32_t Sensor::getWarmUpTime(void) {
+    return _warmUpTime_ms;
+}
 
 
 // These functions get and set the number of readings to average for a sensor
@@ -73,6 +157,150 @@ void Sensor::setNumberMeasurementsToAverage(uint8_t nReadings) {
 uint8_t Sensor::getNumberMeasurementsToAverage(void) {
     return _measurementsToAverage;
 }
+// A standard error needs at least 2 readings
+void Sensor::setAdaptiveAveraging(uint8_t minReadings, uint8_t maxReadings) {
+    if (minReadings < 2) { minReadings = 2; }
+    if (maxReadings < minReadings) { maxReadings = minReadings; }
+    _minMeasurementsToAverage = minReadings;
+    _measurementsToAverage    = maxReadings;
+    // The early stop is judged on the standard error
+    keepStatistic(RESULT_STANDARD_DEVIATION);
+}
+uint8_t Sensor::getMinMeasurementsToAverage(void) {
+    return _minMeasurementsToAverage;
+}
+
+
+// These functions get and set how often a variable array measures the sensor
+void Sensor::setMeasurementCadence(uint8_t everyNIntervals, uint8_t offset) {
+    // Measuring "every 0 intervals" makes no sense; treat it as every interval
+    if (everyNIntervals == 0) { everyNIntervals = 1; }
+    if (everyNIntervals == 1 && _schedule == nullptr) { return; }
+    SensorSchedule* schedule = useSchedule();
+    schedule->cadence        = everyNIntervals;
+    schedule->cadenceOffset  = offset % everyNIntervals;
+}
+uint8_t Sensor::getMeasurementCadence(void) {
+    return _schedule != nullptr ? _schedule->cadence : 1;
+}
+uint8_t Sensor::getMeasurementCadenceOffset(void) {
+    return _schedule != nullptr ? _schedule->cadenceOffset : 0;
+}
+bool Sensor::isMeasurementDue(uint32_t interval) {
+    if (_schedule == nullptr) { return true; }
+    return interval % _schedule->cadence == _schedule->cadenceOffset;
+}
+
+
+// These functions handle the time budget of the sensor
+void Sensor::setTimeBudget(uint32_t maxTime_ms) {
+    if (maxTime_ms == 0 && _schedule == nullptr) { return; }
+    useSchedule()->timeBudget_ms = maxTime_ms;
+}
+uint32_t Sensor::getTimeBudget(void) {
+    return _schedule != nullptr ? _schedule->timeBudget_ms : 0;
+}
+void Sensor::markTimedOut(void) {
+    MS_DBG(getSensorNameAndLocation(),
+           F("ran out of time; its measurements are abandoned."));
+    clearValues();
+    _timedOut = true;
+    // Forget any measurement in progress
+    _millisMeasurementRequested = 0;
+    fallBackToState(SENSOR_AWAKE);
+    // Set the status error bit
+    bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+    // End a non-blocking update, powering the sensor down if it started it
+    if (_updating) {
+        _updateSuccess = false;
+        finishUpdate();
+    }
+}
+bool Sensor::hasTimedOut(void) {
+    return _timedOut;
+}
+
+
+// These functions track the health of the sensor and back off from measuring
+// it while it keeps failing
+void Sensor::setFailureBackoff(uint8_t maxExponent) {
+    if (maxExponent == 0 && _health == nullptr) { return; }
+    SensorHealth* health = useHealth();
+    // Keep the retry interval within a uint16_t
+    health->maxBackoffExponent = maxExponent < 15 ? maxExponent : 15;
+    if (health->maxBackoffExponent == 0) { health->backoffIntervalsLeft = 0; }
+}
+uint8_t Sensor::getFailureBackoff(void) {
+    return _health != nullptr ? _health->maxBackoffExponent : 0;
+}
+bool Sensor::updateHealth(void) {
+    bool success = false;
+    for (uint8_t i = 0; i < _numReturnedValues && !success; i++) {
+        if (numberGoodMeasurementsMade[i] > 0) { success = true; }
+    }
+    // Failures are only counted for sensors that use them
+    if (_health == nullptr) { return success; }
+    if (success) {
+        _health->consecutiveFailures = 0;
+        return true;
+    }
+    if (_health->consecutiveFailures < 0xFFFF) {
+        _health->consecutiveFailures++;
+    }
+    if (_health->totalFailures < 0xFFFF) { _health->totalFailures++; }
+    _health->backoffIntervalsLeft = getRetryInterval() - 1;
+    MS_DBG(getSensorNameAndLocation(), F("has failed"),
+           _health->consecutiveFailures,
+           F("times in a row and will be retried in"),
+           _health->backoffIntervalsLeft + 1, F("intervals."));
+    return false;
+}
+bool Sensor::skipForBackoff(void) {
+    if (_health == nullptr || _health->backoffIntervalsLeft == 0) {
+        return false;
+    }
+    _health->backoffIntervalsLeft--;
+    return true;
+}
+uint16_t Sensor::getConsecutiveFailures(void) {
+    return _health != nullptr ? _health->consecutiveFailures : 0;
+}
+uint16_t Sensor::getTotalFailures(void) {
+    return _health != nullptr ? _health->totalFailures : 0;
+}
+uint16_t Sensor::getRetryInterval(void) {
+    if (_health == nullptr) { return 1; }
+    // Shift unsigned; 1 << 15 overflows the 16-bit int of an AVR
+    if (_health->consecutiveFailures < _health->maxBackoffExponent) {
+        return static_cast<uint16_t>(1U << _health->consecutiveFailures);
+    }
+    return static_cast<uint16_t>(1U << _health->maxBackoffExponent);
+}
+
+
+// These functions get and set how the sensor averages its measurements
+void Sensor::setAveragingMode(averagingMode mode, SampleBuffer* buffer,
+                              uint8_t trimPercent) {
+    if (mode != AVERAGE_MEAN && buffer == nullptr) {
+        MS_DBG(getSensorNameAndLocation(),
+               F("needs a sample buffer for a median or trimmed mean!"));
+        mode = AVERAGE_MEAN;
+    }
+    // The mean needs nothing more than the running values
+    if (mode == AVERAGE_MEAN) {
+        delete _averaging;
+        _averaging = nullptr;
+        return;
+    }
+    if (_averaging == nullptr) { _averaging = new SensorAveraging(); }
+    _averaging->mode        = mode;
+    _averaging->buffer      = buffer;
+    _averaging->trimPercent = trimPercent;
+    buffer->clear();
+}
+averagingMode Sensor::getAveragingMode(void) {
+    return _averaging != nullptr ? _averaging->mode : AVERAGE_MEAN;
+}
 
 
 // This returns the 8-bit code for the current status of the sensor.
@@ -89,6 +317,30 @@ uint8_t Sensor::getStatus(void) {
 }
 
 
+// The state is decoded from the highest of status bits 1-6 that is set
+sensorState Sensor::getState(void) {
+    if (bitRead(_sensorStatus, 6)) { return SENSOR_MEASURING; }
+    if (bitRead(_sensorStatus, 5)) { return SENSOR_MEASUREMENT_ATTEMPTED; }
+    if (bitRead(_sensorStatus, 4)) { return SENSOR_AWAKE; }
+    if (bitRead(_sensorStatus, 3)) { return SENSOR_WAKE_ATTEMPTED; }
+    if (bitRead(_sensorStatus, 2)) { return SENSOR_POWERED; }
+    return SENSOR_UNPOWERED;
+}
+// Each state sets its own status bits and those of the states before it; the
+// powered state sets both the power attempt (1) and success (2) bits
+void Sensor::setState(sensorState state) {
+    uint8_t stateBits = 0;
+    if (state != SENSOR_UNPOWERED) { stateBits = (1 << (state + 2)) - 2; }
+    _sensorStatus = (_sensorStatus & 0b10000001) | stateBits;
+}
+void Sensor::advanceToState(sensorState state) {
+    if (getState() < state) { setState(state); }
+}
+void Sensor::fallBackToState(sensorState state) {
+    if (getState() > state) { setState(state); }
+}
+
+
 // This turns on sensor power
 void Sensor::powerUp(void) {
     if (_powerPin >= 0) {
@@ -105,8 +357,8 @@ void Sensor::powerUp(void) {
         // Mark the power-on time, just in case it  had not been marked
         if (_millisPowerOn == 0) _millisPowerOn = millis();
     }
-    // Set the status bit for sensor power attempt (bit 1) and success (bit 2)
-    _sensorStatus |= 0b00000110;
+    // Mark the sensor as powered, without forgetting that it may be awake
+    advanceToState(SENSOR_POWERED);
 }
 
 
@@ -122,9 +374,8 @@ void Sensor::powerDown(void) {
         _millisSensorActivated = 0;
         // Unset the measurement request time
         _millisMeasurementRequested = 0;
-        // Unset the status bits for sensor power (bits 1 & 2),
-        // activation (bits 3 & 4), and measurement request (bits 5 & 6)
-        _sensorStatus &= 0b10000001;
+        // Return to the unpowered state
+        setState(SENSOR_UNPOWERED);
     } else {
         MS_DBG(F("Power to"), getSensorNameAndLocation(),
                F("is not controlled by this library."));
@@ -153,8 +404,8 @@ bool Sensor::setup(void) {
     if (_dataPin >= 0)
         pinMode(_dataPin, INPUT);  // NOTE:  Not turning on pull-up!
 
-    // Set the status bit marking that the sensor has been set up (bit 0)
-    _sensorStatus |= 0b00000001;
+    // Set the status bit marking that the sensor has been set up
+    bitSet(_sensorStatus, SENSOR_SETUP_BIT);
 
     return true;
 }
@@ -163,25 +414,28 @@ bool Sensor::setup(void) {
 // The function to wake up a sensor
 bool Sensor::wake(void) {
     MS_DBG(F("Waking"), getSensorNameAndLocation());
-    // Set the status bit for sensor activation attempt (bit 3)
-    // Setting this bit even if the activation failed, to show the attempt was
-    // made
-    _sensorStatus |= 0b00001000;
 
     // Check if the sensor was successfully powered
-    if (!bitRead(_sensorStatus, 2)) {
+    if (getState() < SENSOR_POWERED) {
         MS_DBG(getSensorNameAndLocation(),
                F("doesn't have power and will never wake up!"));
-        // Make sure that the wake time and wake success bit (bit 4) are unset
+        // Make sure that the wake time is unset
         _millisSensorActivated = 0;
-        _sensorStatus &= 0b11101111;
         return false;
     }
+    // Mark the wake attempt; sensors that fail to wake fall back to this state
+    setState(SENSOR_WAKE_ATTEMPTED);
 
     // Mark the time that the sensor was activated
     _millisSensorActivated = millis();
-    // Set the status bit for sensor wake/activation success (bit 4)
-    _sensorStatus |= 0b00010000;
+    setState(SENSOR_AWAKE);
+
+    // If still learning the stabilization time, probe it after this wake
+    if (_stabilityLearning != nullptr) {
+        _stabilityLearning->probing = _stabilityLearning->wakesRemaining > 0 &&
+            _stabilizationTime_ms > 0;
+        _stabilityLearning->lastProbeValue = -9999;
+    }
 
     return true;
 }
@@ -205,54 +459,68 @@ bool Sensor::startSingleMeasurement(void) {
 
     // check if the sensor was successfully set up, run set up if not
     // NOTE:  We continue regardless of the success of this attempt
-    if (!bitRead(_sensorStatus, 0)) {
+    if (!bitRead(_sensorStatus, SENSOR_SETUP_BIT)) {
         MS_DBG(getSensorNameAndLocation(),
                F("was never properly set up, attempting setup now!"));
         setup();
     }
 
     MS_DBG(F("Starting measurement on"), getSensorNameAndLocation());
-    // Set the status bits for measurement requested (bit 5)
-    // Setting this bit even if we failed to start a measurement to show that an
-    // attempt was made.
-    _sensorStatus |= 0b00100000;
-
-    // Check if there was a successful wake (bit 4 set)
-    // Only mark the measurement request time if it is
-    if (bitRead(_sensorStatus, 4)) {
+
+    // Check if there was a successful wake
+    // Only mark the measurement request time if there was
+    if (getState() >= SENSOR_AWAKE) {
         // Mark the time that a measurement was requested
         _millisMeasurementRequested = millis();
-        // Set the status bit for measurement start success (bit 6)
-        _sensorStatus |= 0b01000000;
+        setState(SENSOR_MEASURING);
     } else {
-        // Otherwise, make sure that the measurement start time and success bit
-        // (bit 6) are unset
+        // Otherwise, make sure that the measurement start time is unset
         MS_DBG(getSensorNameAndLocation(),
                F("isn't awake/active!  A measurement cannot be started."));
         _millisMeasurementRequested = 0;
-        _sensorStatus &= 0b10111111;
         success = false;
     }
     return success;
 }
 
 
+// Any more variables for the same result are chained behind the first one
 void Sensor::registerVariable(int sensorVarNum, Variable* var) {
-    variables[sensorVarNum] = var;
+    if (sensorVarNum < 0 || sensorVarNum >= _numReturnedValues) {
+        MS_DBG(getSensorNameAndLocation(), F("has no result number"),
+               sensorVarNum, F("to register a variable to!"));
+        return;
+    }
+    if (variables[sensorVarNum] == nullptr) {
+        variables[sensorVarNum] = var;
+        return;
+    }
+    Variable* last = variables[sensorVarNum];
+    while (last != var && last->nextResultVariable != nullptr) {
+        last = last->nextResultVariable;
+    }
+    // Don't register the same variable twice
+    if (last != var) { last->nextResultVariable = var; }
 }
 
 void Sensor::notifyVariables(void) {
     MS_DBG(F("Notifying variables registered to"), getSensorNameAndLocation(),
            F("of value update."));
 
+    // Any calculated value may depend on the new values
+    Variable::startNewGeneration();
+
     // Notify variables of update
     for (uint8_t i = 0; i < _numReturnedValues; i++) {
         if (variables[i] != nullptr) {
             // Bad things happen if try to update nullptr
-            MS_DBG(F("Sending value update from"), getSensorNameAndLocation(),
-                   F("to variable"), i, F("which is"),
-                   variables[i]->getVarName(), F("..."));
-            variables[i]->onSensorUpdate(this);
+            for (Variable* var = variables[i]; var != nullptr;
+                 var = var->nextResultVariable) {
+                MS_DBG(F("Sending value update from"),
+                       getSensorNameAndLocation(), F("to variable"), i,
+                       F("which is"), var->getVarName(), F("..."));
+                var->onSensorUpdate(this);
+            }
         } else {
             MS_DBG(getSensorNameAndLocation(),
                    F("has no variable registered for return value"), i,
@@ -269,28 +537,68 @@ void Sensor::clearValues(void) {
         sensorValues[i]               = -9999;
         numberGoodMeasurementsMade[i] = 0;
     }
+    if (_resultStatistics != nullptr) {
+        for (uint8_t i = 0; i < _numReturnedValues; i++) {
+            _resultStatistics[i]                          = 0;
+            _resultStatistics[_numReturnedValues + i]     = -9999;
+            _resultStatistics[2 * _numReturnedValues + i] = -9999;
+        }
+    }
+    if (_averaging != nullptr) { _averaging->buffer->clear(); }
+    _timedOut = false;
 }
 
 
 // This verifies that a measurement is good before adding it to the values to be
 // averaged
+// The result array holds the running mean of the good values.  The mean,
+// spread, and range are all updated in a single pass with Welford's method, so
+// no individual measurements need to be kept.  The spread and range are only
+// kept if asked for.
 void Sensor::verifyAndAddMeasurementResult(uint8_t resultNumber,
                                            float   resultValue) {
+    if (resultNumber >= _numReturnedValues) { return; }
+    float* resultM2      = nullptr;
+    float* resultMinimum = nullptr;
+    float* resultMaximum = nullptr;
+    if (_resultStatistics != nullptr) {
+        resultM2      = &_resultStatistics[resultNumber];
+        resultMinimum = resultM2 + _numReturnedValues;
+        resultMaximum = resultMinimum + _numReturnedValues;
+    }
     // If the new result is good and there was were only bad results, set the
     // result value as the new result and add 1 to the good result total
     if (sensorValues[resultNumber] == -9999 && resultValue != -9999) {
         MS_DBG(F("Putting"), resultValue, F("in result array for variable"),
                resultNumber, F("from"), getSensorNameAndLocation());
         sensorValues[resultNumber] = resultValue;
+        if (resultM2 != nullptr) {
+            *resultM2      = 0;
+            *resultMinimum = resultValue;
+            *resultMaximum = resultValue;
+        }
         numberGoodMeasurementsMade[resultNumber] += 1;
+        if (_averaging != nullptr) {
+            _averaging->buffer->add(resultNumber, resultValue);
+        }
     } else if (sensorValues[resultNumber] != -9999 && resultValue != -9999) {
         // If the new result is good and there were already good results in
-        // place add the new results to the total and add 1 to the good result
-        // total
+        // place add 1 to the good result total and fold the new result into
+        // the running statistics
         MS_DBG(F("Adding"), resultValue, F("to result array for variable"),
                resultNumber, F("from"), getSensorNameAndLocation());
-        sensorValues[resultNumber] += resultValue;
         numberGoodMeasurementsMade[resultNumber] += 1;
+        float delta = resultValue - sensorValues[resultNumber];
+        sensorValues[resultNumber] += delta /
+            numberGoodMeasurementsMade[resultNumber];
+        if (resultM2 != nullptr) {
+            *resultM2 += delta * (resultValue - sensorValues[resultNumber]);
+            if (resultValue < *resultMinimum) { *resultMinimum = resultValue; }
+            if (resultValue > *resultMaximum) { *resultMaximum = resultValue; }
+        }
+        if (_averaging != nullptr) {
+            _averaging->buffer->add(resultNumber, resultValue);
+        }
     } else if (sensorValues[resultNumber] == -9999 && resultValue == -9999) {
         // If the new result is bad and there were only bad results, do nothing
         MS_DBG(F("Ignoring bad result for variable"), resultNumber, F("from"),
@@ -319,62 +627,185 @@ void Sensor::verifyAndAddMeasurementResult(uint8_t resultNumber,
 void Sensor::averageMeasurements(void) {
     MS_DBG(F("Averaging results from"), getSensorNameAndLocation(), F("over"),
            _measurementsToAverage, F("reading[s]"));
+    // The result array already holds the mean of the good values; only a
+    // median or trimmed mean needs any more work
     for (uint8_t i = 0; i < _numReturnedValues; i++) {
-        if (numberGoodMeasurementsMade[i] > 0)
-            sensorValues[i] /= numberGoodMeasurementsMade[i];
-        MS_DBG(F("    ->Result #"), i, ':', sensorValues[i]);
+        if (_averaging != nullptr && _averaging->buffer->getCount(i) > 0) {
+            if (_averaging->mode == AVERAGE_MEDIAN) {
+                sensorValues[i] = _averaging->buffer->getMedian(i);
+            } else if (_averaging->mode == AVERAGE_TRIMMED_MEAN) {
+                sensorValues[i] = _averaging->buffer->getTrimmedMean(
+                    i, _averaging->trimPercent);
+            }
+        }
+        MS_DBG(F("    ->Result #"), i, ':', sensorValues[i], F("from"),
+               numberGoodMeasurementsMade[i], F("good values"));
+    }
+}
+
+
+// This returns a statistic of a result over the measurements in this update
+float Sensor::getResultStatistic(uint8_t         resultNumber,
+                                 resultStatistic statistic) {
+    if (resultNumber >= _numReturnedValues) { return -9999; }
+    uint8_t count = numberGoodMeasurementsMade[resultNumber];
+    // The spread and range are in blocks of one value for each result
+    const float* stats = _resultStatistics != nullptr
+        ? &_resultStatistics[resultNumber]
+        : nullptr;
+    switch (statistic) {
+        case RESULT_MINIMUM:
+            if (stats == nullptr || count == 0) { return -9999; }
+            return stats[_numReturnedValues];
+        case RESULT_MAXIMUM:
+            if (stats == nullptr || count == 0) { return -9999; }
+            return stats[2 * _numReturnedValues];
+        case RESULT_STANDARD_DEVIATION:
+            if (stats == nullptr || count < 2) { return -9999; }
+            return sqrt(stats[0] / (count - 1));
+        case RESULT_COUNT: return count;
+        case SENSOR_CONSECUTIVE_FAILURES: return getConsecutiveFailures();
+        case SENSOR_TOTAL_FAILURES: return getTotalFailures();
+        case SENSOR_RETRY_INTERVAL: return getRetryInterval();
+        case RESULT_MEAN:
+        default: return sensorValues[resultNumber];
+    }
+}
+// The spread, range, and failure counts are only allocated when first asked
+// for
+void Sensor::keepStatistic(resultStatistic statistic) {
+    switch (statistic) {
+        case RESULT_MINIMUM:
+        case RESULT_MAXIMUM:
+        case RESULT_STANDARD_DEVIATION:
+            if (_resultStatistics == nullptr && _numReturnedValues > 0) {
+                _resultStatistics = new float[3 * _numReturnedValues];
+                for (uint8_t i = 0; i < _numReturnedValues; i++) {
+                    _resultStatistics[i]                          = 0;
+                    _resultStatistics[_numReturnedValues + i]     = -9999;
+                    _resultStatistics[2 * _numReturnedValues + i] = -9999;
+                }
+            }
+            break;
+        case SENSOR_CONSECUTIVE_FAILURES:
+        case SENSOR_TOTAL_FAILURES:
+        case SENSOR_RETRY_INTERVAL: useHealth(); break;
+        case RESULT_MEAN:
+        case RESULT_COUNT:
+        default: break;
     }
 }
 
 
 // This updates a sensor value by checking it's power, waking it, taking as many
 // readings as requested, then putting the sensor to sleep and powering down.
+// NOTE:  This is "blocking" - it runs the non-blocking update to completion.
 bool Sensor::update(void) {
-    bool ret_val = true;
+    startUpdate();
+    while (isUpdating()) {
+        uint32_t next = tick(millis());
+        while (isUpdating() && static_cast<int32_t>(millis() - next) < 0) {
+            // wait
+        }
+    }
+    return getUpdateSuccess();
+}
+
+
+// This starts a non-blocking update, powering the sensor if needed
+void Sensor::startUpdate(void) {
+    _updateSuccess = true;
 
     // Check if the power is on, turn it on if not
-    bool wasOn = checkPowerOn();
-    if (!wasOn) { powerUp(); }
+    _updateWasOn = checkPowerOn();
+    if (!_updateWasOn) { powerUp(); }
 
-    // Check if it's awake/active, activate it if not
-    bool wasActive = bitRead(getStatus(), 3);
-    if (!wasActive) {
-        // NOT yet awake
-        // wait for the sensor to have been powered for long enough to respond
-        waitForWarmUp();
-        ret_val &= wake();
-    }
-    // bail if the wake failed
-    if (!ret_val) return ret_val;
+    // Check if a wake has already been attempted
+    _updateWasActive = getState() >= SENSOR_WAKE_ATTEMPTED;
 
-    // Clear values before starting loop
+    // Clear values before starting the measurements
     clearValues();
+    _updateMeasurementsLeft = _measurementsToAverage;
+    _updateMeasuring        = false;
+    _updating               = true;
+}
 
-    // Wait for the sensor to stabilize
-    waitForStability();
 
-    // loop through as many measurements as requested
-    for (uint8_t j = 0; j < _measurementsToAverage; j++) {
-        // start a measurement
-        ret_val &= startSingleMeasurement();
-        // wait for the measurement to finish
-        waitForMeasurementCompletion();
-        // get the measurement result
-        ret_val &= addSingleMeasurementResult();
+// This advances a non-blocking update by every step that is ready now and
+// returns when the next step will be ready
+uint32_t Sensor::tick(uint32_t now) {
+    while (_updating) {
+        // If a measurement is in progress, collect it once it's done
+        if (_updateMeasuring) {
+            if (!isMeasurementComplete()) {
+                return now + getTimeUntilMeasurementComplete();
+            }
+            bool isProbe = isProbingStability();
+            _updateSuccess &= addSingleMeasurementResult();
+            _updateMeasuring = false;
+            // Probe readings are not kept and don't count toward the average
+            if (isProbe) {
+                addStabilityProbe();
+            } else {
+                _updateMeasurementsLeft--;
+            }
+            continue;
+        }
+
+        switch (getState()) {
+            case SENSOR_UNPOWERED:
+            case SENSOR_POWERED:
+                // NOT yet awake; wait for the sensor to have been powered for
+                // long enough to respond, then wake it
+                if (!isWarmedUp()) { return now + getTimeUntilWarmedUp(); }
+                if (!wake()) {
+                    // bail if the wake failed
+                    _updateSuccess = false;
+                    _updating      = false;
+                    return 0;
+                }
+                break;
+
+            default:
+                // Wait for the sensor to stabilize
+                if (!isStable()) { return now + getTimeUntilStable(); }
+                if (_updateMeasurementsLeft == 0 && !isProbingStability()) {
+                    finishUpdate();
+                    return 0;
+                }
+                // Start the next measurement or stability probe
+                _updateSuccess &= startSingleMeasurement();
+                _updateMeasuring = true;
+                break;
+        }
     }
+    return 0;
+}
 
+
+// This finishes a non-blocking update
+void Sensor::finishUpdate(void) {
+    updateHealth();
     averageMeasurements();
 
     // Put the sensor back to sleep if it had been activated
-    if (wasActive) { sleep(); }
+    if (_updateWasActive) { sleep(); }
 
     // Turn the power back off it it had been turned on
-    if (!wasOn) { powerDown(); }
+    if (!_updateWasOn) { powerDown(); }
+
+    _updating = false;
 
     // Update the registered variables with the new values
     notifyVariables();
+}
+
 
-    return ret_val;
+bool Sensor::isUpdating(void) {
+    return _updating;
+}
+bool Sensor::getUpdateSuccess(void) {
+    return _updateSuccess;
 }
 
 
@@ -393,26 +824,23 @@ bool Sensor::checkPowerOn(bool debug) {
             if (debug) { MS_DBG(F("was off.")); }
             // Reset time of power on, in-case it was set to a value
             _millisPowerOn = 0;
-            // Unset the status bits for sensor power (bits 1 & 2),
-            // activation (bits 3 & 4), and measurement request (bits 5 & 6)
-            _sensorStatus &= 0b10000001;
+            // Return to the unpowered state
+            setState(SENSOR_UNPOWERED);
             return false;
         } else {
             if (debug) { MS_DBG(" was on."); }
             // Mark the power-on time, just in case it  had not been marked
             if (_millisPowerOn == 0) _millisPowerOn = millis();
-            // Set the status bit for sensor power attempt (bit 1) and success
-            // (bit 2)
-            _sensorStatus |= 0b00000110;
+            // Mark the sensor as powered, unless it is already further along
+            advanceToState(SENSOR_POWERED);
             return true;
         }
     } else {
         if (debug) { MS_DBG(F("is not controlled by this library.")); }
         // Mark the power-on time, just in case it  had not been marked
         if (_millisPowerOn == 0) _millisPowerOn = millis();
-        // Set the status bit for sensor power attempt (bit 1) and success (bit
-        // 2)
-        _sensorStatus |= 0b00000110;
+        // Mark the sensor as powered, unless it is already further along
+        advanceToState(SENSOR_POWERED);
         return true;
     }
 }
@@ -422,7 +850,7 @@ bool Sensor::checkPowerOn(bool debug) {
 bool Sensor::isWarmedUp(bool debug) {
     // If the sensor doesn't have power, then it will never be warmed up,
     // so the warm up time is essentially already passed.
-    if (!bitRead(_sensorStatus, 2)) {
+    if (getState() < SENSOR_POWERED) {
         if (debug) {
             MS_DBG(getSensorNameAndLocation(),
                    F("does not have power and cannot warm up!"));
@@ -438,11 +866,34 @@ bool Sensor::isWarmedUp(bool debug) {
                    getSensorNameAndLocation(), F("should be warmed up!"));
         }
         return true;
-    } else {
-        // If the sensor has power but the time hasn't passed, we still need to
-        // wait
-        return false;
     }
+
+    // If the sensor can tell us it's ready, ask it when the next probe is due
+    if (_readinessProbe != nullptr) {
+        resetReadinessProbe();
+        ReadinessProbe* probe = _readinessProbe;
+        if (probe->confirmed) { return true; }
+        if (elapsed_since_power_on >= probe->nextProbe_ms) {
+            if (probeReadiness()) {
+                MS_DBG(getSensorNameAndLocation(), F("answered after"),
+                       elapsed_since_power_on, F("ms of its"), _warmUpTime_ms,
+                       F("ms warm-up time"));
+                probe->confirmed = true;
+                return true;
+            }
+            // Back off before asking again
+            probe->nextProbe_ms = elapsed_since_power_on + probe->backoff_ms;
+            if (probe->backoff_ms < probe->maxBackoff_ms / 2) {
+                probe->backoff_ms *= 2;
+            } else {
+                probe->backoff_ms = probe->maxBackoff_ms;
+            }
+        }
+    }
+
+    // If the sensor has power but the time hasn't passed, we still need to
+    // wait
+    return false;
 }
 
 // This delays until enough time has passed for the sensor to "warm up" - that
@@ -455,12 +906,70 @@ void Sensor::waitForWarmUp(void) {
     }
 }
 
+// This returns the number of ms left until the sensor is warmed up
+// NOTE:  The "is" functions require strictly more than the set time to have
+// passed, so the sensor is ready one ms after the set time.
+uint32_t Sensor::getTimeUntilWarmedUp(void) {
+    if (getState() < SENSOR_POWERED) { return 0; }
+    uint32_t elapsed_since_power_on = millis() - _millisPowerOn;
+    if (elapsed_since_power_on > _warmUpTime_ms) { return 0; }
+    uint32_t remaining = _warmUpTime_ms - elapsed_since_power_on + 1;
+    // A probing sensor may be ready as early as its next probe
+    if (_readinessProbe != nullptr) {
+        resetReadinessProbe();
+        uint32_t nextProbe_ms = _readinessProbe->nextProbe_ms;
+        if (_readinessProbe->confirmed ||
+            elapsed_since_power_on >= nextProbe_ms) {
+            return 0;
+        }
+        if (nextProbe_ms - elapsed_since_power_on < remaining) {
+            remaining = nextProbe_ms - elapsed_since_power_on;
+        }
+    }
+    return remaining;
+}
+
+
+// These functions probe the sensor for readiness during warm-up
+void Sensor::setReadinessProbing(bool enable, uint16_t initialBackoff_ms,
+                                 uint16_t maxBackoff_ms) {
+    if (initialBackoff_ms == 0) { initialBackoff_ms = 1; }
+    if (maxBackoff_ms < initialBackoff_ms) {
+        maxBackoff_ms = initialBackoff_ms;
+    }
+    if (!enable) {
+        delete _readinessProbe;
+        _readinessProbe = nullptr;
+        return;
+    }
+    if (_readinessProbe == nullptr) { _readinessProbe = new ReadinessProbe(); }
+    _readinessProbe->initialBackoff_ms = initialBackoff_ms;
+    _readinessProbe->maxBackoff_ms     = maxBackoff_ms;
+    // Start the probes over at the next check
+    _readinessProbe->backoff_ms = 0;
+}
+bool Sensor::getReadinessProbing(void) {
+    return _readinessProbe != nullptr;
+}
+bool Sensor::probeReadiness(void) {
+    return false;
+}
+// The probes start over each time the sensor is powered
+void Sensor::resetReadinessProbe(void) {
+    ReadinessProbe* probe = _readinessProbe;
+    if (probe->powerOn == _millisPowerOn && probe->backoff_ms > 0) { return; }
+    probe->powerOn      = _millisPowerOn;
+    probe->confirmed    = false;
+    probe->backoff_ms   = probe->initialBackoff_ms;
+    probe->nextProbe_ms = probe->initialBackoff_ms;
+}
+
 
 // This checks to see if enough time has passed for stability
 bool Sensor::isStable(bool debug) {
     // If the sensor failed to activate, it will never stabilize, so the
     // stabilization time is essentially already passed
-    if (!bitRead(_sensorStatus, 4)) {
+    if (getState() < SENSOR_AWAKE) {
         if (debug) {
             MS_DBG(getSensorNameAndLocation(),
                    F("is not active and cannot stabilize!"));
@@ -470,7 +979,7 @@ bool Sensor::isStable(bool debug) {
 
     uint32_t elapsed_since_wake_up = millis() - _millisSensorActivated;
     // If the sensor has been activated and enough time has elapsed, it's stable
-    if (elapsed_since_wake_up > _stabilizationTime_ms) {
+    if (elapsed_since_wake_up > getStabilizationTime()) {
         if (debug) {
             MS_DBG(F("It's been"), elapsed_since_wake_up, F("ms, and"),
                    getSensorNameAndLocation(), F("should be stable!"));
@@ -493,12 +1002,100 @@ void Sensor::waitForStability(void) {
     }
 }
 
+// This returns the number of ms left until the sensor is stable
+uint32_t Sensor::getTimeUntilStable(void) {
+    if (getState() < SENSOR_AWAKE) { return 0; }
+    uint32_t stabilizationTime     = getStabilizationTime();
+    uint32_t elapsed_since_wake_up = millis() - _millisSensorActivated;
+    if (elapsed_since_wake_up > stabilizationTime) { return 0; }
+    return stabilizationTime - elapsed_since_wake_up + 1;
+}
+
+
+// These functions learn the stabilization time from probe readings
+void Sensor::setStabilizationLearning(uint8_t resultNumber, float tolerance,
+                                      uint8_t learningWakes,
+                                      uint8_t marginPercent) {
+    if (_stabilityLearning == nullptr) {
+        _stabilityLearning = new StabilityLearning();
+    }
+    _stabilityLearning->probeResult    = resultNumber;
+    _stabilityLearning->tolerance      = tolerance;
+    _stabilityLearning->wakesRemaining = learningWakes;
+    _stabilityLearning->marginPercent  = marginPercent;
+    _stabilityLearning->learnedTime_ms = 0;
+}
+// The stabilization time from the constructor is always the upper limit
+uint32_t Sensor::getStabilizationTime(void) {
+    if (_stabilityLearning == nullptr) { return _stabilizationTime_ms; }
+    if (_stabilityLearning->probing) { return 0; }
+    uint32_t learned = _stabilityLearning->learnedTime_ms;
+    if (learned > 0) {
+        uint32_t withMargin = learned +
+            learned * _stabilityLearning->marginPercent / 100;
+        if (withMargin < _stabilizationTime_ms) { return withMargin; }
+    }
+    return _stabilizationTime_ms;
+}
+uint32_t Sensor::getLearnedStabilizationTime(void) {
+    return _stabilityLearning != nullptr ? _stabilityLearning->learnedTime_ms
+                                         : 0;
+}
+void Sensor::setLearnedStabilizationTime(uint32_t learnedTime_ms) {
+    if (learnedTime_ms == 0 && _stabilityLearning == nullptr) { return; }
+    if (_stabilityLearning == nullptr) {
+        _stabilityLearning = new StabilityLearning();
+    }
+    _stabilityLearning->learnedTime_ms = learnedTime_ms;
+    _stabilityLearning->wakesRemaining = 0;
+    _stabilityLearning->probing        = false;
+}
+bool Sensor::isProbingStability(void) {
+    return _stabilityLearning != nullptr && _stabilityLearning->probing;
+}
+bool Sensor::addStabilityProbe(void) {
+    if (_stabilityLearning == nullptr) { return true; }
+    StabilityLearning* learning = _stabilityLearning;
+    float              value    = sensorValues[learning->probeResult];
+    uint32_t           elapsed  = millis() - _millisSensorActivated;
+    // The probe reading only tells us whether the sensor has stabilized; it
+    // isn't kept
+    clearValues();
+
+    uint32_t converged_ms;
+    if (value != -9999 && learning->lastProbeValue != -9999 &&
+        fabs(value - learning->lastProbeValue) <= learning->tolerance) {
+        MS_DBG(getSensorNameAndLocation(), F("converged after"), elapsed,
+               F("ms"));
+        converged_ms = elapsed;
+    } else if (elapsed >= _stabilizationTime_ms) {
+        MS_DBG(getSensorNameAndLocation(),
+               F("did not converge within its full stabilization time of"),
+               _stabilizationTime_ms, F("ms"));
+        converged_ms = _stabilizationTime_ms;
+    } else {
+        learning->lastProbeValue = value;
+        return false;
+    }
+
+    // Keep the longest convergence time seen
+    if (converged_ms == 0) { converged_ms = 1; }
+    if (converged_ms > learning->learnedTime_ms) {
+        learning->learnedTime_ms = converged_ms;
+    }
+    learning->wakesRemaining--;
+    learning->probing = false;
+    MS_DBG(getSensorNameAndLocation(), F("will now wait"),
+           getStabilizationTime(), F("ms to stabilize"));
+    return true;
+}
+
 
 // This checks to see if enough time has passed for measurement completion
 bool Sensor::isMeasurementComplete(bool debug) {
     // If a measurement failed to start, the sensor will never return a result,
     // so the measurement time is essentially already passed
-    if (!bitRead(_sensorStatus, 6)) {
+    if (getState() != SENSOR_MEASURING) {
         if (debug) {
             MS_DBG(getSensorNameAndLocation(),
                    F("is not measuring and will not return a value!"));
@@ -531,3 +1128,11 @@ void Sensor::waitForMeasurementCompletion(void) {
         // wait
     }
 }
+
+// This returns the number of ms left until the measurement is complete
+uint32_t Sensor::getTimeUntilMeasurementComplete(void) {
+    if (getState() != SENSOR_MEASURING) { return 0; }
+    uint32_t elapsed_since_meas_start = millis() - _millisMeasurementRequested;
+    if (elapsed_since_meas_start > _measurementTime_ms) { return 0; }
+    return _measurementTime_ms - elapsed_since_meas_start + 1;
+}
@@ -34,12 +34,95 @@
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include <pins_arduino.h>
+#include "SampleBuffer.h"
 
 /**
  * @brief The largest number of variables from a single sensor
+ *
+ * The result storage of each sensor is sized to the number of values it
+ * returns, so this no longer affects the memory used by a sensor.
  */
 #define MAX_NUMBER_VARS 8
 
+/**
+ * @brief The type of communication bus a sensor is attached to.
+ *
+ * Sensors on the same bus share a single set of wires (ie, one SDI-12 data
+ * pin, one RS485 stream, or one I2C instance) and cannot talk at the same
+ * time; sensors on different buses can.
+ */
+typedef enum sensorBusType {
+    NO_BUS = 0,  ///< Not on a shared bus - analog, pulse, or dedicated pins
+    I2C_BUS,     ///< An I2C (TwoWire or SoftwareWire) instance
+    SDI12_BUS,   ///< An SDI-12 data pin
+    MODBUS_BUS,  ///< An RS485/modbus stream
+    SERIAL_BUS   ///< Any other serial stream
+} sensorBusType;
+
+/**
+ * @brief The statistics kept for each result of a sensor over the
+ * measurements averaged in an update.
+ *
+ * The statistics are accumulated one measurement at a time (using Welford's
+ * method) without storing the individual measurements.  Only good (not -9999)
+ * measurements are included.  The averaged value is the normal value of the
+ * result; it is the median or trimmed mean for a sensor using one of those
+ * averaging modes.
+ *
+ * The sensor health statistics describe the sensor as a whole and are the same
+ * for every result.  An update in which the sensor gave no good measurement of
+ * any result counts as a failure.
+ */
+typedef enum resultStatistic {
+    RESULT_MEAN = 0,              ///< The averaged value
+    RESULT_MINIMUM,               ///< The smallest measurement
+    RESULT_MAXIMUM,               ///< The largest measurement
+    RESULT_STANDARD_DEVIATION,    ///< The sample standard deviation
+    RESULT_COUNT,                 ///< The number of good measurements
+    SENSOR_CONSECUTIVE_FAILURES,  ///< The failed updates in a row
+    SENSOR_TOTAL_FAILURES,        ///< The failed updates since restart
+    SENSOR_RETRY_INTERVAL         ///< The intervals between measurements
+} resultStatistic;
+
+/**
+ * @brief The ways a sensor can average the measurements of each result taken
+ * in an update.
+ *
+ * The median and trimmed mean need the individual measurements to be kept in
+ * a SampleBuffer.
+ */
+typedef enum averagingMode {
+    AVERAGE_MEAN = 0,     ///< The arithmetic mean of all good measurements
+    AVERAGE_MEDIAN,       ///< The median of the good measurements
+    AVERAGE_TRIMMED_MEAN  ///< The mean after discarding the extremes
+} averagingMode;
+
+/**
+ * @brief The bit of the sensor status code set once the sensor has been set up.
+ */
+#define SENSOR_SETUP_BIT 0
+/**
+ * @brief The bit of the sensor status code set once any error has occurred.
+ */
+#define SENSOR_ERROR_BIT 7
+
+/**
+ * @brief The state of a sensor in its cycle of power, wake, and measurement.
+ *
+ * The states are in the order a sensor passes through them, and bits 1-6 of
+ * the sensor status code are derived from the state; each state sets its own
+ * bits and those of all the states before it.  A sensor left in one of the
+ * "attempted" states failed to wake or to start a measurement.
+ */
+typedef enum sensorState {
+    SENSOR_UNPOWERED = 0,          ///< Not powered; no status bits
+    SENSOR_POWERED,                ///< Powered; status bits 1-2
+    SENSOR_WAKE_ATTEMPTED,         ///< Wake attempted; status bits 1-3
+    SENSOR_AWAKE,                  ///< Awake; status bits 1-4
+    SENSOR_MEASUREMENT_ATTEMPTED,  ///< Measurement attempted; status bits 1-5
+    SENSOR_MEASURING               ///< Measurement started; status bits 1-6
+} sensorState;
+
 
 class Variable;  // Forward declaration
 
@@ -111,7 +194,7 @@ class Sensor {
      */
     Sensor& operator=(const Sensor& copy_from_me) = delete;
     /**
-     * @brief Destroy the Sensor object - no action taken.
+     * @brief Destroy the Sensor object - frees the result storage.
      */
     virtual ~Sensor();
 
@@ -145,6 +228,89 @@ class Sensor {
      * @return **int8_t** The pin on the mcu controlling power to the sensor.
      */
     virtual int8_t getPowerPin(void);
+    /**
+     * @brief Get the pin number controlling power to a secondary component of
+     * the sensor, such as an RS485 adapter.
+     *
+     * @return **int8_t** The second pin on the mcu controlling power to the
+     * sensor or its adapter; -1 if there is no secondary power pin.
+     */
+    virtual int8_t getSecondaryPowerPin(void);
+
+    /**
+     * @brief Get the type of communication bus the sensor is attached to.
+     *
+     * @return **sensorBusType** The type of bus; #NO_BUS if the sensor does
+     * not share a bus with other sensors.
+     */
+    virtual sensorBusType getBusType(void);
+    /**
+     * @brief Get an identifier for the communication bus the sensor is
+     * attached to.
+     *
+     * Sensors with the same bus type and bus id are on the same physical bus.
+     * The id is the data pin for SDI-12 sensors and the address of the stream
+     * or wire instance for serial and I2C sensors.
+     *
+     * @return **uintptr_t** The bus identifier
+     */
+    virtual uintptr_t getBusId(void);
+    /**
+     * @brief Check whether the sensor needs the bus to itself for the whole
+     * time it is measuring.
+     *
+     * If this is true, a variable array will not start a measurement on any
+     * other sensor on the same bus until this sensor's result has been
+     * collected.
+     *
+     * @return **bool** True if the bus must be held while measuring.
+     */
+    virtual bool needsExclusiveBus(void);
+
+    /**
+     * @brief Set the current the sensor draws from its power pins.
+     *
+     * A variable array uses these figures to stagger powering its sensors so
+     * that the total current stays within its power budget; see
+     * VariableArray::setPowerBudget().  Until they are set, both currents are
+     * 0 and the sensor does not count against the budget.
+     *
+     * @param peakCurrent_mA The inrush current drawn when the sensor is first
+     * powered, in mA.
+     * @param steadyCurrent_mA The current drawn once the inrush has passed, in
+     * mA.
+     * @param inrushTime_ms The length of the inrush after the sensor is
+     * powered, in ms.  Optional with a default value of 0, meaning the sensor
+     * draws its peak current until it is warmed up.
+     */
+    void setPowerDraw(uint16_t peakCurrent_mA, uint16_t steadyCurrent_mA,
+                      uint32_t inrushTime_ms = 0);
+    /**
+     * @brief Get the inrush current drawn when the sensor is first powered.
+     *
+     * @return **uint16_t** The peak current, in mA.
+     */
+    uint16_t getPeakCurrent(void);
+    /**
+     * @brief Get the current drawn by the sensor once its inrush has passed.
+     *
+     * @return **uint16_t** The steady current, in mA.
+     */
+    uint16_t getSteadyCurrent(void);
+    /**
+     * @brief Get the length of the inrush after the sensor is powered.
+     *
+     * @return **uint32_t** The inrush time, in ms.  This is the warm-up time
+     * if no inrush time was set.
+     */
+    uint32_t getInrushTime(void);
+    /**
+     * @brief Get the time needed from when the sensor has power until it's
+     * ready to talk.
+     *
+     * @return **uint32_t** The warm-up time, in ms.
+     */
+    uint32_t getWarmUpTime(void);
 
     /**
      * @brief Set the number measurements to average.
@@ -164,6 +330,193 @@ class Sensor {
      * @copydetails _measurementsToAverage
      */
     uint8_t getNumberMeasurementsToAverage(void);
+    /**
+     * @brief Let a variable array stop averaging the sensor early once its
+     * results have settled.
+     *
+     * After each measurement beyond the minimum, the variable array checks the
+     * standard error of the mean of each variable from the sensor that has a
+     * tolerance set (see Variable::setStandardErrorTolerance()).  Once all are
+     * within tolerance, no more measurements are taken and the sensor can be
+     * put to sleep and powered down.
+     *
+     * @param minReadings The fewest readings to take; at least 2.
+     * @param maxReadings The most readings to take.  This replaces the number
+     * of measurements to average.
+     */
+    void setAdaptiveAveraging(uint8_t minReadings, uint8_t maxReadings);
+    /**
+     * @brief Get the fewest readings to take before an adaptive early stop.
+     *
+     * @return **uint8_t** The minimum number of readings; 0 if adaptive
+     * averaging is off.
+     */
+    uint8_t getMinMeasurementsToAverage(void);
+
+    /**
+     * @brief Set how often the sensor is measured by a variable array's
+     * completeUpdate().
+     *
+     * In the intervals the sensor is not due, it is not powered, woken, or
+     * measured.  Its variables keep their last values and are marked stale;
+     * see Variable::isStale().  When a logger runs the update, the intervals
+     * are numbered from its marked time, counting logging intervals since the
+     * epoch, so the sensor is measured at the same times of day across
+     * resets; otherwise they are counted by the variable array from its first
+     * complete update, starting at 0.  See
+     * VariableArray::setIntervalNumber().
+     *
+     * @param everyNIntervals Measure the sensor only in every Nth interval.
+     * Use 1 (the default) to measure the sensor every interval.
+     * @param offset The interval, counting from 0, in each cycle of N in which
+     * the sensor is measured.  Optional with a default value of 0.  Use different
+     * offsets to spread slow sensors across intervals.
+     */
+    void setMeasurementCadence(uint8_t everyNIntervals, uint8_t offset = 0);
+    /**
+     * @brief Get the number of intervals between measurements of the sensor.
+     *
+     * @return **uint8_t** The sensor is measured every Nth interval.
+     */
+    uint8_t getMeasurementCadence(void);
+    /**
+     * @brief Get the first interval in which the sensor is measured.
+     *
+     * @return **uint8_t** The interval offset of the measurements.
+     */
+    uint8_t getMeasurementCadenceOffset(void);
+    /**
+     * @brief Check whether the sensor is due to be measured in an interval.
+     *
+     * @param interval The number of the interval, counting from 0.
+     * @return **bool** True if the sensor should be measured in the interval.
+     */
+    bool isMeasurementDue(uint32_t interval);
+
+    /**
+     * @brief Set the longest time a variable array may spend on the sensor in
+     * a single update.
+     *
+     * The time is counted from when the sensor is powered in a complete
+     * update, or from the start of the update if the array doesn't handle
+     * power.  A sensor that runs out of time is abandoned: its results for the
+     * update are -9999 and hasTimedOut() is true.
+     *
+     * @param maxTime_ms The time budget, in ms.  0 (the default) means no
+     * limit.
+     */
+    void setTimeBudget(uint32_t maxTime_ms);
+    /**
+     * @brief Get the longest time a variable array may spend on the sensor in
+     * a single update.
+     *
+     * @return **uint32_t** The time budget, in ms; 0 if there is no limit.
+     */
+    uint32_t getTimeBudget(void);
+    /**
+     * @brief Abandon the measurements of a sensor that has run out of time.
+     *
+     * All results are set to -9999, any measurement in progress is forgotten,
+     * and the error bit (bit 7) of the status is set.  A non-blocking update
+     * in progress (see startUpdate()) is ended as unsuccessful.
+     */
+    virtual void markTimedOut(void);
+    /**
+     * @brief Check whether the sensor's last measurements were abandoned
+     * because it ran out of time.
+     *
+     * @return **bool** True if the sensor timed out since its values were last
+     * cleared.
+     */
+    bool hasTimedOut(void);
+
+    /**
+     * @brief Back off from measuring a sensor that keeps failing.
+     *
+     * After each failed update - one with no good measurement of any result -
+     * a variable array retries the sensor only every 2^k intervals, where k is
+     * the number of failures in a row, up to the maximum exponent.  Skipped
+     * intervals count like those skipped by the measurement cadence: the
+     * sensor isn't powered or woken and its variables are marked stale.  One
+     * good update returns the sensor to its normal cadence.
+     *
+     * The failure counts can be reported as variables using the
+     * #SENSOR_CONSECUTIVE_FAILURES, #SENSOR_TOTAL_FAILURES, and
+     * #SENSOR_RETRY_INTERVAL statistics; see Variable::setStatistic().
+     * Failures are only counted once a back-off is set or one of these
+     * statistics is kept.
+     *
+     * @param maxExponent The largest exponent of the back-off; the sensor is
+     * retried at least every 2^maxExponent intervals.  0 (the default) means
+     * the sensor is never backed off.
+     */
+    void setFailureBackoff(uint8_t maxExponent);
+    /**
+     * @brief Get the largest exponent of the failure back-off.
+     *
+     * @return **uint8_t** The maximum exponent; 0 if the sensor is never
+     * backed off.
+     */
+    uint8_t getFailureBackoff(void);
+    /**
+     * @brief Record whether the last update of the sensor succeeded in its
+     * health counts and set the back-off for the next intervals.
+     *
+     * @return **bool** True if the sensor gave at least one good measurement.
+     */
+    bool updateHealth(void);
+    /**
+     * @brief Check whether the sensor is backed off from an interval it would
+     * otherwise be measured in, counting the interval if it is.
+     *
+     * @return **bool** True if the interval should be skipped.
+     */
+    bool skipForBackoff(void);
+    /**
+     * @brief Get the number of updates in a row in which the sensor failed.
+     *
+     * @return **uint16_t** The consecutive failures.
+     */
+    uint16_t getConsecutiveFailures(void);
+    /**
+     * @brief Get the number of updates in which the sensor failed since the
+     * processor was last restarted.
+     *
+     * @return **uint16_t** The total failures.
+     */
+    uint16_t getTotalFailures(void);
+    /**
+     * @brief Get how often the sensor is currently measured.
+     *
+     * @return **uint16_t** The sensor is measured every Nth interval it is
+     * due; 1 unless it is backed off after failures.
+     */
+    uint16_t getRetryInterval(void);
+
+    /**
+     * @brief Set how the sensor averages the measurements of each result.
+     *
+     * The median and trimmed mean resist spikes that would skew the mean,
+     * such as sonar multipath returns or bubbles passing a turbidity sensor.
+     * They keep each measurement in a sample buffer until the update is
+     * averaged.  Only the results that fit in the buffer are averaged this
+     * way; any others still use the mean.
+     *
+     * @param mode The averaging mode
+     * @param buffer The buffer to keep the measurements in; required for the
+     * median and trimmed mean.  Optional with a default value of nullptr.
+     * @param trimPercent For the trimmed mean, the percent of the
+     * measurements to discard from each end.  Optional with a default value of
+     * 20.
+     */
+    void setAveragingMode(averagingMode mode, SampleBuffer* buffer = nullptr,
+                          uint8_t trimPercent = 20);
+    /**
+     * @brief Get how the sensor averages the measurements of each result.
+     *
+     * @return **averagingMode** The averaging mode
+     */
+    averagingMode getAveragingMode(void);
 
     /**
      * @brief Get the 8-bit code for the current status of the sensor.
@@ -212,9 +565,18 @@ class Sensor {
      * - 0 => No known errors
      * - 1 => Some sort of error has occurred
      *
+     * Bits 1-6 are derived from the sensor's state; see getState().
+     *
      * @return The status as a uint8_t.
      */
     uint8_t getStatus(void);
+    /**
+     * @brief Get the state of the sensor in its cycle of power, wake, and
+     * measurement.
+     *
+     * @return **sensorState** The current state
+     */
+    sensorState getState(void);
 
     /**
      * @brief Do any one-time preparations needed before the sensor will be able
@@ -243,12 +605,55 @@ class Sensor {
      * new results from a single sensor, this is the function that should be
      * used.  To work with many sensors together, use the VariableArray class
      * which optimizes the timing and waits for many sensors working together.
+     * To update a single sensor without blocking, use startUpdate() and
+     * tick().
      *
      * @return **bool** True if all steps of the sensor update completed
      * successfully.
      */
     virtual bool update(void);
 
+    /**
+     * @brief Start a non-blocking update of the sensor's values.
+     *
+     * This powers the sensor if it is not already on and clears the values.
+     * The rest of the update - the same steps as update() - is done by calling
+     * tick() until isUpdating() returns false.
+     */
+    void startUpdate(void);
+    /**
+     * @brief Advance a non-blocking update by every step that is ready now.
+     *
+     * This never waits for the sensor.  Between calls the processor is free to
+     * do other work or to sleep until the returned deadline.  For example:
+     * @code{cpp}
+     * sensor.startUpdate();
+     * while (sensor.isUpdating()) {
+     *     uint32_t next = sensor.tick(millis());
+     *     // ... other work until millis() reaches next ...
+     * }
+     * @endcode
+     *
+     * @param now The current processor millis()
+     * @return **uint32_t** The processor millis() at which tick() should next
+     * be called, or 0 once the update is finished.
+     */
+    uint32_t tick(uint32_t now);
+    /**
+     * @brief Check whether a non-blocking update is in progress.
+     *
+     * @return **bool** True from startUpdate() until tick() finishes the
+     * update.
+     */
+    bool isUpdating(void);
+    /**
+     * @brief Check whether every step of the last update succeeded.
+     *
+     * @return **bool** True if all steps of the sensor update completed
+     * successfully.
+     */
+    bool getUpdateSuccess(void);
+
     /**
      * @brief Turn on the sensor power, if applicable.
      *
@@ -320,8 +725,11 @@ class Sensor {
 
     /**
      * @brief The array of result values for each sensor.
+     *
+     * This is allocated by the constructor with one value for each of the
+     * #_numReturnedValues results.
      */
-    float sensorValues[MAX_NUMBER_VARS];
+    float* sensorValues;
 
     /**
      * @brief Clear the values array - that is, sets all values to -9999.
@@ -351,10 +759,37 @@ class Sensor {
     void verifyAndAddMeasurementResult(uint8_t resultNumber,
                                        int32_t resultValue);
     /**
-     * @brief Average the results of all measurements by dividing the sum of
-     * all measurements by the number of measurements taken.
+     * @brief Finish averaging the results of all measurements.
+     *
+     * The mean of the good measurements is kept up to date as each result is
+     * added, so for the default averaging mode this only reports the final
+     * averages.  For the median and trimmed mean, this replaces the mean with
+     * the robust average of the measurements in the sample buffer.
      */
     void averageMeasurements(void);
+    /**
+     * @brief Get a statistic of one result over the measurements taken in
+     * the current update.
+     *
+     * @param resultNumber The position of the result within the result array.
+     * @param statistic The statistic to get.
+     * @return **float** The value of the statistic; -9999 if there were no
+     * good measurements, or fewer than two for the standard deviation, or if
+     * the statistic isn't kept.  The count is never -9999.
+     */
+    float getResultStatistic(uint8_t resultNumber, resultStatistic statistic);
+    /**
+     * @brief Start keeping a statistic of the sensor's results.
+     *
+     * The mean and count are always kept.  The minimum, maximum, and standard
+     * deviation need three more values for each result, and the sensor health
+     * statistics need the failure counts, so these are only allocated once
+     * something asks for them.  A variable reporting a statistic calls this
+     * when it is attached to the sensor or its statistic is set.
+     *
+     * @param statistic The statistic to keep.
+     */
+    void keepStatistic(resultStatistic statistic);
 
     /**
      * @brief Register a variable object to a sensor.
@@ -363,7 +798,9 @@ class Sensor {
      * variable result array.
      * @param var A ponter to the Variable object.
      *
-     * @note Only one variable can be assigned to each place in the array!
+     * @note More than one variable can be assigned to each place in the array,
+     * for example to report several statistics of the same result.  Every
+     * variable registered to a place is notified of its new values.
      */
     void registerVariable(int sensorVarNum, Variable* var);
     /**
@@ -372,6 +809,17 @@ class Sensor {
     void notifyVariables(void);
 
 
+    /**
+     * @brief Check whether the sensor is ready to respond to commands by
+     * sending it a short request.
+     *
+     * Sub-classes able to tell when the sensor is ready override this.  It
+     * must return quickly and must not change the sensor's status bits.
+     *
+     * @return **bool** True if the sensor answered.  The base class can't ask
+     * and always returns false.
+     */
+    virtual bool probeReadiness(void);
     /**
      * @brief Check if the #_powerPin is currently high.
      *
@@ -396,6 +844,49 @@ class Sensor {
      * receive commands.
      */
     void waitForWarmUp(void);
+    /**
+     * @brief Get the time remaining before isWarmedUp() will return true.
+     *
+     * @return **uint32_t** The number of milliseconds left in the warm up
+     * time; 0 if the sensor is already warmed up or has no power.
+     *
+     * @note If a sub-class overrides isWarmedUp() to become ready earlier than
+     * its warm up time (ie, by polling a "ready" pin), it must also override
+     * this to return 0 so the variable array doesn't idle past that point.
+     */
+    virtual uint32_t getTimeUntilWarmedUp(void);
+
+    /**
+     * @brief Ask the sensor whether it is ready instead of always waiting out
+     * the full warm-up time.
+     *
+     * While probing is enabled and the sensor is warming up, isWarmedUp()
+     * polls probeReadiness() and reports the sensor warmed up as soon as it
+     * answers.  The first poll is made the initial backoff after power-up, and
+     * the wait between polls doubles after each unanswered poll up to the
+     * maximum backoff.  The warm-up time given in the constructor is still the
+     * upper limit, so a sensor that never answers is treated exactly as
+     * before.
+     *
+     * Probing only helps sensors that implement probeReadiness(): SDI-12
+     * sensors (acknowledge active, `a!`), Yosemitech, Keller, and Vaisala
+     * modbus sensors (a register read), and Atlas and Bosch BME280 I2C
+     * sensors (an address acknowledgement).
+     *
+     * @param enable True to probe the sensor during warm-up
+     * @param initialBackoff_ms The time from power-up to the first poll, in
+     * ms.  Optional with a default value of 25.
+     * @param maxBackoff_ms The longest wait between polls, in ms.  Optional
+     * with a default value of 500.
+     */
+    void setReadinessProbing(bool enable, uint16_t initialBackoff_ms = 25,
+                             uint16_t maxBackoff_ms = 500);
+    /**
+     * @brief Check whether the sensor is probed during warm-up.
+     *
+     * @return **bool** True if readiness probing is enabled.
+     */
+    bool getReadinessProbing(void);
 
     /**
      * @brief Check whether or not enough time has passed between the sensor
@@ -415,6 +906,82 @@ class Sensor {
      * stable values.
      */
     void waitForStability(void);
+    /**
+     * @brief Get the time remaining before isStable() will return true.
+     *
+     * @return **uint32_t** The number of milliseconds left in the
+     * stabilization time; 0 if the sensor is already stable or is not active.
+     */
+    virtual uint32_t getTimeUntilStable(void);
+
+    /**
+     * @brief Learn how long the sensor actually takes to stabilize instead of
+     * always waiting the worst-case stabilization time.
+     *
+     * For the next few wakes, the sensor is treated as stable right away and
+     * quick probe readings are taken until two successive readings of one
+     * result agree within the tolerance.  The probe readings are discarded.
+     * The longest time the sensor took to converge, plus a safety margin,
+     * then replaces the stabilization time.  The stabilization time given in
+     * the constructor remains the upper limit, both for probing and for the
+     * learned time.
+     *
+     * Use getLearnedStabilizationTime() and setLearnedStabilizationTime() to
+     * keep the learned time across restarts, for example in EEPROM.
+     *
+     * @param resultNumber The result to watch for convergence
+     * @param tolerance The largest change between successive readings of the
+     * result that counts as converged, in the units of the result.
+     * @param learningWakes The number of wakes to probe.  Optional with a
+     * default value of 5.
+     * @param marginPercent The safety margin added to the learned time, in
+     * percent.  Optional with a default value of 25.
+     */
+    void setStabilizationLearning(uint8_t resultNumber, float tolerance,
+                                  uint8_t learningWakes = 5,
+                                  uint8_t marginPercent = 25);
+    /**
+     * @brief Get the stabilization time currently in use.
+     *
+     * @return **uint32_t** The learned stabilization time with its margin if
+     * there is one, 0 while probing, or the stabilization time given in the
+     * constructor.
+     */
+    uint32_t getStabilizationTime(void);
+    /**
+     * @brief Get the longest time the sensor took to converge while learning
+     * its stabilization time, without the safety margin.
+     *
+     * @return **uint32_t** The learned time, in ms; 0 if nothing has been
+     * learned.
+     */
+    uint32_t getLearnedStabilizationTime(void);
+    /**
+     * @brief Restore a stabilization time learned earlier, ending any
+     * learning still in progress.
+     *
+     * @param learnedTime_ms The learned time, in ms, as returned by
+     * getLearnedStabilizationTime().
+     */
+    void setLearnedStabilizationTime(uint32_t learnedTime_ms);
+    /**
+     * @brief Check whether the measurements now being taken are probe
+     * readings for learning the stabilization time.
+     *
+     * @return **bool** True if the sensor is probing.
+     */
+    bool isProbingStability(void);
+    /**
+     * @brief Check the result of a probe reading against the last one, then
+     * discard it.
+     *
+     * Call this after each addSingleMeasurementResult() while
+     * isProbingStability() is true.
+     *
+     * @return **bool** True if probing is finished, either because the
+     * readings converged or because the full stabilization time has passed.
+     */
+    bool addStabilityProbe(void);
 
     /**
      * @brief Check whether or not enough time has passed between when the
@@ -435,9 +1002,23 @@ class Sensor {
      * finished the current measurement.
      */
     void waitForMeasurementCompletion(void);
+    /**
+     * @brief Get the time remaining before isMeasurementComplete() will return
+     * true.
+     *
+     * @return **uint32_t** The number of milliseconds left in the measurement
+     * time; 0 if the measurement is already complete or was never started.
+     */
+    virtual uint32_t getTimeUntilMeasurementComplete(void);
 
 
  protected:
+    /**
+     * @brief Start the readiness probes over if the sensor has been powered
+     * again since they were last made.
+     */
+    void resetReadinessProbe(void);
+
     /**
      * @brief Digital pin number on the mcu receiving sensor data
      *
@@ -472,6 +1053,11 @@ class Sensor {
      * requested.
      */
     uint8_t _measurementsToAverage;
+    /**
+     * @brief The fewest measurements to take before an adaptive early stop;
+     * 0 if the sensor always takes all #_measurementsToAverage.
+     */
+    uint8_t _minMeasurementsToAverage = 0;
     /**
      * @brief The number of included calculated variables from the
      * sensor, if any.
@@ -486,7 +1072,16 @@ class Sensor {
      * @brief Array with the number of valid measurement values taken by the
      * sensor in the current update cycle.
      */
-    uint8_t numberGoodMeasurementsMade[MAX_NUMBER_VARS];
+    uint8_t* numberGoodMeasurementsMade;
+    /**
+     * @brief Array with the running sum of squared differences from the mean,
+     * then the smallest, then the largest good measurement of each result in
+     * the current update cycle.
+     *
+     * This is nullptr until a statistic needing it is kept; see
+     * keepStatistic().
+     */
+    float* _resultStatistics = nullptr;
 
     /**
      * @brief The time needed from the when a sensor has power until it's ready
@@ -534,16 +1129,256 @@ class Sensor {
 
     /**
      * @brief An 8-bit code for the sensor status
+     *
+     * Bits 1-6 should only be changed with setState().
      */
     uint8_t _sensorStatus = 0;
+    /**
+     * @brief Move the sensor to a new state, setting status bits 1-6 to match
+     * it.
+     *
+     * @param state The new state
+     */
+    void setState(sensorState state);
+    /**
+     * @brief Move the sensor forward to a state, unless it is already at or
+     * past it.
+     *
+     * @param state The state to reach
+     */
+    void advanceToState(sensorState state);
+    /**
+     * @brief Move the sensor back to a state, unless it has not reached it.
+     *
+     * @param state The state to return to
+     */
+    void fallBackToState(sensorState state);
+
+    /**
+     * @brief True if the sensor's measurements were abandoned because it ran
+     * out of time.
+     */
+    bool _timedOut : 1;
+    /**
+     * @brief True while a non-blocking update is in progress.
+     */
+    bool _updating : 1;
+    /**
+     * @brief True if the sensor was already powered when the update started.
+     */
+    bool _updateWasOn : 1;
+    /**
+     * @brief True if the sensor had already been woken when the update
+     * started.
+     */
+    bool _updateWasActive : 1;
+    /**
+     * @brief True unless a step of the current or last update failed.
+     */
+    bool _updateSuccess : 1;
+    /**
+     * @brief True while the current update has a measurement in progress.
+     */
+    bool _updateMeasuring : 1;
+    /**
+     * @brief The number of measurements still to take in the current update.
+     */
+    uint8_t _updateMeasurementsLeft = 0;
+    /**
+     * @brief Finish a non-blocking update: average the results, return the
+     * sensor to its earlier power and wake state, and notify the variables.
+     */
+    void finishUpdate(void);
+
+    /**
+     * @brief How often and for how long a variable array measures the sensor,
+     * and the current the sensor draws.
+     */
+    struct SensorSchedule {
+        /**
+         * @brief The number of intervals between measurements; 1 to measure
+         * the sensor every interval.
+         */
+        uint8_t cadence = 1;
+        /**
+         * @brief The first interval, counting from 0, in which the sensor is
+         * measured.
+         */
+        uint8_t cadenceOffset = 0;
+        /**
+         * @brief The longest time a variable array may spend on the sensor in
+         * one update, in ms; 0 for no limit.
+         */
+        uint32_t timeBudget_ms = 0;
+        /**
+         * @brief The inrush current drawn when the sensor is first powered,
+         * in mA.
+         */
+        uint16_t peakCurrent_mA = 0;
+        /**
+         * @brief The current drawn once the inrush has passed, in mA.
+         */
+        uint16_t steadyCurrent_mA = 0;
+        /**
+         * @brief The length of the inrush after the sensor is powered, in ms.
+         * If 0, the inrush lasts until the sensor is warmed up.
+         */
+        uint32_t inrushTime_ms = 0;
+    };
+    /**
+     * @brief The failure counts of the sensor and its back-off.
+     */
+    struct SensorHealth {
+        /**
+         * @brief The largest exponent of the failure back-off; 0 for none.
+         */
+        uint8_t maxBackoffExponent = 0;
+        /**
+         * @brief The number of due intervals left to skip before the sensor
+         * is retried.
+         */
+        uint16_t backoffIntervalsLeft = 0;
+        /**
+         * @brief The number of updates in a row in which the sensor failed.
+         */
+        uint16_t consecutiveFailures = 0;
+        /**
+         * @brief The number of updates in which the sensor failed since the
+         * processor was last restarted.
+         */
+        uint16_t totalFailures = 0;
+    };
+    /**
+     * @brief The median or trimmed mean averaging of the sensor.
+     */
+    struct SensorAveraging {
+        /**
+         * @brief How the measurements of each result are averaged.
+         */
+        averagingMode mode;
+        /**
+         * @brief The buffer keeping each measurement.
+         */
+        SampleBuffer* buffer;
+        /**
+         * @brief The percent of the measurements discarded from each end for
+         * the trimmed mean.
+         */
+        uint8_t trimPercent;
+    };
+    /**
+     * @brief The state of the readiness probes made during warm-up.
+     */
+    struct ReadinessProbe {
+        /**
+         * @brief True once the sensor has answered a probe since it was last
+         * powered.
+         */
+        bool confirmed = false;
+        /**
+         * @brief The time from power-up to the first probe, in ms.
+         */
+        uint16_t initialBackoff_ms = 25;
+        /**
+         * @brief The longest wait between probes, in ms.
+         */
+        uint16_t maxBackoff_ms = 500;
+        /**
+         * @brief The current wait between probes, in ms.
+         */
+        uint16_t backoff_ms = 0;
+        /**
+         * @brief The time after power-up of the next probe, in ms.
+         */
+        uint32_t nextProbe_ms = 0;
+        /**
+         * @brief The power-on time the probe state belongs to; the probes
+         * start over whenever the sensor is powered again.
+         */
+        uint32_t powerOn = 0;
+    };
+    /**
+     * @brief The state of learning the stabilization time from probe
+     * readings.
+     */
+    struct StabilityLearning {
+        /**
+         * @brief The learned stabilization time without its margin, in ms; 0
+         * if none has been learned.
+         */
+        uint32_t learnedTime_ms = 0;
+        /**
+         * @brief The largest change between successive probe readings that
+         * counts as converged.
+         */
+        float tolerance = 0;
+        /**
+         * @brief The last probe reading, or -9999 if there isn't one yet.
+         */
+        float lastProbeValue = -9999;
+        /**
+         * @brief The result watched for convergence.
+         */
+        uint8_t probeResult = 0;
+        /**
+         * @brief The number of wakes left to probe.
+         */
+        uint8_t wakesRemaining = 0;
+        /**
+         * @brief The safety margin added to the learned time, in percent.
+         */
+        uint8_t marginPercent = 25;
+        /**
+         * @brief True while probe readings are being taken after a wake.
+         */
+        bool probing = false;
+    };
+    /**
+     * @brief The schedule of the sensor; nullptr until any part of it is set,
+     * so a sensor using the defaults doesn't carry it.
+     */
+    SensorSchedule* _schedule = nullptr;
+    /**
+     * @brief The health of the sensor; nullptr until a back-off is set or a
+     * health statistic is kept.
+     */
+    SensorHealth* _health = nullptr;
+    /**
+     * @brief The median or trimmed mean averaging; nullptr for the mean.
+     */
+    SensorAveraging* _averaging = nullptr;
+    /**
+     * @brief The readiness probe state; nullptr unless probing is enabled.
+     */
+    ReadinessProbe* _readinessProbe = nullptr;
+    /**
+     * @brief The stabilization learning state; nullptr until learning is
+     * started or a learned time is restored.
+     */
+    StabilityLearning* _stabilityLearning = nullptr;
+    /**
+     * @brief Get the schedule of the sensor, creating it with the defaults if
+     * it doesn't exist yet.
+     *
+     * @return **SensorSchedule\*** The schedule.
+     */
+    SensorSchedule* useSchedule(void);
+    /**
+     * @brief Get the health of the sensor, creating it if it doesn't exist
+     * yet.
+     *
+     * @return **SensorHealth\*** The health.
+     */
+    SensorHealth* useHealth(void);
 
     /**
      * @brief An array for each sensor containing the variable objects tied to
-     * that sensor.  The #MAX_NUMBER_VARS cannot be determined on a per-sensor
-     * basis, because of the way memory is used on an Arduino.  It must be
-     * defined once for the whole class.
+     * that sensor, with one entry for each of the #_numReturnedValues results.
+     *
+     * The variables, values, and good measurement counts share the single
+     * block allocated by the constructor, with the variables first.
      */
-    Variable* variables[MAX_NUMBER_VARS];
+    Variable** variables;
 };
 
 #endif  // SRC_SENSORBASE_H_
@@ -9,6 +9,11 @@
 
 #include "VariableArray.h"
 
+#if !defined(MS_VARIABLEARRAY_BUSY_WAIT) && \
+    (defined(ARDUINO_ARCH_AVR) || defined(__AVR__))
+#include <avr/sleep.h>
+#endif
+
 
 // Constructors
 VariableArray::VariableArray() {}
@@ -27,16 +32,17 @@ VariableArray::VariableArray(uint8_t variableCount, Variable* variableList[],
     matchUUIDs(uuids);
 }
 
-// Destructor
-VariableArray::~VariableArray() {}
+// Destructor - frees the sensor list
+VariableArray::~VariableArray() {
+    freeSensorList();
+}
 
 void VariableArray::begin(uint8_t variableCount, Variable* variableList[],
                           const char* uuids[]) {
     _variableCount = variableCount;
     arrayOfVars    = variableList;
 
-    _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
+    buildSensorList();
     matchUUIDs(uuids);
     checkVariableUUIDs();
 }
@@ -44,13 +50,11 @@ void VariableArray::begin(uint8_t variableCount, Variable* variableList[]) {
     _variableCount = variableCount;
     arrayOfVars    = variableList;
 
-    _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
+    buildSensorList();
     checkVariableUUIDs();
 }
 void VariableArray::begin() {
-    _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
+    buildSensorList();
     checkVariableUUIDs();
 }
 
@@ -86,16 +90,10 @@ void VariableArray::matchUUIDs(const char* uuids[]) {
 // Public functions for interfacing with a list of sensors
 // This sets up all of the sensors in the list
 // NOTE:  Calculated variables will always be skipped in this process because
-// a calculated variable will never be marked as the last variable from a
-// sensor.
+// a calculated variable is never attached to a sensor in the sensor list.
 bool VariableArray::setupSensors(void) {
     bool success = true;
-
-    // #ifdef MS_VARIABLEARRAY_DEBUG_DEEP
-    // bool deepDebugTiming = true;
-    // #else
-    // bool deepDebugTiming = false;
-    // #endif
+    if (_sensorList == nullptr) { buildSensorList(); }
 
     MS_DBG(F("Beginning setup for sensors and variables..."));
 
@@ -104,44 +102,25 @@ bool VariableArray::setupSensors(void) {
 
     // Check for any sensors that have been set up outside of this (ie, the
     // modem)
-    uint8_t nSensorsSetup = 0;
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)  // Skip non-unique sensors
-            && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0) ==
-                1  // already set up
-        ) {
-            MS_DBG(F("   "), arrayOfVars[i]->getParentSensorNameAndLocation(),
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        Sensor* sensor = _sensorList[s].sensor;
+        if (bitRead(sensor->getStatus(), SENSOR_SETUP_BIT) ==
+            1) {  // already set up
+            MS_DBG(F("   "), sensor->getSensorNameAndLocation(),
                    F("was already set up!"));
-
-            nSensorsSetup++;
+            continue;
         }
-    }
 
-    // We're going to keep looping through all of the sensors and check if each
-    // one has been on long enough to be warmed up.  Once it has, we'll set it
-    // up and increment the counter marking that's been done.
-    // We keep looping until they've all been done.
-    while (nSensorsSetup < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            if (isLastVarFromSensor(i)  // Skip non-unique sensors
-                && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0) ==
-                    0  // only set up if it has not yet been set up
-            ) {
-                MS_DBG(F("    Set up of"),
-                       arrayOfVars[i]->getParentSensorNameAndLocation(),
-                       F("..."));
+        MS_DBG(F("    Set up of"), sensor->getSensorNameAndLocation(),
+               F("..."));
 
-                bool sensorSuccess =
-                    arrayOfVars[i]->parentSensor->setup();  // set it up
-                success &= sensorSuccess;
-                nSensorsSetup++;
+        bool sensorSuccess = sensor->setup();  // set it up
+        success &= sensorSuccess;
 
-                if (!sensorSuccess) {
-                    MS_DBG(F("        ... setup failed!"));
-                } else {
-                    MS_DBG(F("        ... setup succeeded."));
-                }
-            }
+        if (!sensorSuccess) {
+            MS_DBG(F("        ... setup failed!"));
+        } else {
+            MS_DBG(F("        ... setup succeeded."));
         }
     }
 
@@ -153,28 +132,26 @@ bool VariableArray::setupSensors(void) {
 
 // This powers up the sensors
 // There's no checking or waiting here, just turning on pins
-// NOTE:  Calculated variables will always be skipped in this process because
-// a calculated variable will never be marked as the last variable from a
-// sensor.
 void VariableArray::sensorsPowerUp(void) {
+    if (_sensorList == nullptr) { buildSensorList(); }
     MS_DBG(F("Powering up sensors..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            MS_DBG(F("    Powering up"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation());
-
-            arrayOfVars[i]->parentSensor->powerUp();
-        }
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        MS_DBG(F("    Powering up"),
+               _sensorList[s].sensor->getSensorNameAndLocation());
+
+        _sensorList[s].sensor->powerUp();
+        _sensorList[s].poweredDown     = false;
+        _sensorList[s].waitingForPower = false;
+        _sensorList[s].millisPoweredUp = millis();
     }
+    for (uint8_t r = 0; r < _powerRailCount; r++) { _powerRails[r].powerUp(); }
 }
 
 
 // This wakes/activates the sensors
 // Before a sensor is "awoken" we have to make sure it's had time to warm up
-// NOTE:  Calculated variables will always be skipped in this process because
-// a calculated variable will never be marked as the last variable from a
-// sensor.
 bool VariableArray::sensorsWake(void) {
+    if (_sensorList == nullptr) { buildSensorList(); }
     MS_DBG(F("Waking sensors..."));
     bool    success       = true;
     uint8_t nSensorsAwake = 0;
@@ -187,13 +164,11 @@ bool VariableArray::sensorsWake(void) {
 
     // Check for any sensors that are awake outside of being sent a "wake"
     // command
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)  // Skip non-unique sensors
-            && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                1  // already attempted to wake
-        ) {
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (_sensorList[s].sensor->getState() >=
+            SENSOR_WAKE_ATTEMPTED) {  // already attempted to wake
             MS_DBG(F("    Wake up of"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(),
+                   _sensorList[s].sensor->getSensorNameAndLocation(),
                    F("has already been attempted."));
             nSensorsAwake++;
         }
@@ -204,20 +179,20 @@ bool VariableArray::sensorsWake(void) {
     // up and increment the counter marking that's been done.
     // We keep looping until they've all been done.
     while (nSensorsAwake < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            if (isLastVarFromSensor(i)  // Skip non-unique sensors
-                && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                    0  // If no attempts yet made to wake the sensor up
-                && arrayOfVars[i]->parentSensor->isWarmedUp(
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            Sensor* sensor = _sensorList[s].sensor;
+            if (sensor->getState() <
+                    SENSOR_WAKE_ATTEMPTED  // If no attempts yet made to wake
+                                           // the sensor up
+                && sensor->isWarmedUp(
                        deepDebugTiming)  // and if it is already warmed up
             ) {
-                MS_DBG(F("    Wake up of"),
-                       arrayOfVars[i]->getParentSensorNameAndLocation(),
+                MS_DBG(F("    Wake up of"), sensor->getSensorNameAndLocation(),
                        F("..."));
 
                 // Make a single attempt to wake the sensor after it is
                 // warmed up
-                bool sensorSuccess = arrayOfVars[i]->parentSensor->wake();
+                bool sensorSuccess = sensor->wake();
                 success &= sensorSuccess;
                 // We increment up the number of sensors awake/active,
                 // even if the wake up command failed!
@@ -238,25 +213,21 @@ bool VariableArray::sensorsWake(void) {
 // This puts sensors to sleep
 // We're not waiting for anything to be ready, we're just sending the command
 // to put it to sleep no matter what its current state is.
-// NOTE:  Calculated variables will always be skipped in this process because
-// a calculated variable will never be marked as the last variable from a
-// sensor.
 bool VariableArray::sensorsSleep(void) {
+    if (_sensorList == nullptr) { buildSensorList(); }
     MS_DBG(F("Putting sensors to sleep..."));
     bool success = true;
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            MS_DBG(F("    "), arrayOfVars[i]->getParentSensorNameAndLocation(),
-                   F("..."));
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        MS_DBG(F("    "), _sensorList[s].sensor->getSensorNameAndLocation(),
+               F("..."));
 
-            bool sensorSuccess = arrayOfVars[i]->parentSensor->sleep();
-            success &= sensorSuccess;
+        bool sensorSuccess = _sensorList[s].sensor->sleep();
+        success &= sensorSuccess;
 
-            if (sensorSuccess) {
-                MS_DBG(F("        ... successfully put to sleep."));
-            } else {
-                MS_DBG(F("        ... failed to sleep!"));
-            }
+        if (sensorSuccess) {
+            MS_DBG(F("        ... successfully put to sleep."));
+        } else {
+            MS_DBG(F("        ... failed to sleep!"));
         }
     }
     return success;
@@ -265,19 +236,10 @@ bool VariableArray::sensorsSleep(void) {
 
 // This cuts power to the sensors
 // We're not waiting for anything to be ready, we're just cutting power.
-// NOTE:  Calculated variables will always be skipped in this process because
-// a calculated variable will never be marked as the last variable from a
-// sensor.
 void VariableArray::sensorsPowerDown(void) {
+    if (_sensorList == nullptr) { buildSensorList(); }
     MS_DBG(F("Powering down sensors..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            MS_DBG(F("    Powering down"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation());
-
-            arrayOfVars[i]->parentSensor->powerDown();
-        }
-    }
+    for (uint8_t s = 0; s < _sensorCount; s++) { powerDownSensor(s); }
 }
 
 
@@ -285,12 +247,14 @@ void VariableArray::sensorsPowerDown(void) {
 // Please note that this does NOT run the update functions, it instead uses
 // the startSingleMeasurement and addSingleMeasurementResult functions to
 // take advantage of the ability of sensors to be measuring concurrently.
-// NOTE:  Calculated variables will always be skipped in this process because
-// a calculated variable will never be marked as the last variable from a
-// sensor.
 bool VariableArray::updateAllSensors(void) {
-    bool    success           = true;
-    uint8_t nSensorsCompleted = 0;
+    bool     success           = true;
+    uint8_t  nSensorsCompleted = 0;
+    uint32_t idleTime          = 0;
+    _millisUpdateStarted       = millis();
+    _microsUpdateStarted       = micros();
+    _lastUpdatePasses          = 0;
+    _lastUpdateTimeouts        = 0;
 
 #ifdef MS_VARIABLEARRAY_DEBUG_DEEP
     bool deepDebugTiming = true;
@@ -298,190 +262,260 @@ bool VariableArray::updateAllSensors(void) {
     bool deepDebugTiming = false;
 #endif
 
-    // Create an array with the unique-ness value (so we can skip the function
-    // calls later)
-    MS_DBG(F("Creating a mask array with the uniqueness for each sensor.."));
-    bool lastSensorVariable[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        lastSensorVariable[i] = isLastVarFromSensor(i);
-    }
-
-    // Create an array for the number of measurements already completed and set
-    // all to zero
-    MS_DBG(F("Creating an array for the number of completed measurements.."));
-    uint8_t nMeasurementsCompleted[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        nMeasurementsCompleted[i] = 0;
-    }
-
-    // Create an array for the number of measurements to average (another short
-    // cut)
-    MS_DBG(F("Creating an array with the number of measurements to average.."));
-    uint8_t nMeasurementsToAverage[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            nMeasurementsToAverage[i] =
-                arrayOfVars[i]->parentSensor->getNumberMeasurementsToAverage();
-        } else {
-            nMeasurementsToAverage[i] = 0;
-        }
-    }
+    // Reset the number of measurements completed and re-read the number of
+    // measurements to average, in case it has changed
+    if (_sensorList == nullptr) { buildSensorList(); }
+    resetSensorList();
 
     // Clear the initial variable arrays
     MS_DBG(F("----->> Clearing all results arrays before taking new "
              "measurements. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            arrayOfVars[i]->parentSensor->clearValues();
-        }
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        _sensorList[s].sensor->clearValues();
     }
     MS_DBG(F("    ... Complete. <<-----"));
 
     // Check for any sensors that didn't wake up and mark them as "complete" so
     // they will be skipped in further looping.
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]  // Skip non-unique sensors
-            && (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                    0  // No attempt made to wake the sensor up
-                || bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4) ==
-                    0  // OR Wake up failed
-                )) {
-            MS_DBG(i, F("--->>"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(),
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        // No attempt made to wake the sensor up OR wake up failed
+        if (entry.sensor->getState() < SENSOR_AWAKE) {
+            MS_DBG(s, F("--->>"), entry.sensor->getSensorNameAndLocation(),
                    F("isn't awake/active!  No measurements will be taken! "
                      "<<---"),
-                   i);
+                   s);
 
             // Set the number of measurements already equal to whatever
             // total number requested to ensure the sensor is skipped in
             // further loops.
-            nMeasurementsCompleted[i] = nMeasurementsToAverage[i];
+            entry.nMeasurementsCompleted = entry.nMeasurementsToAverage;
+            entry.finished               = true;
             // Bump up the finished count.
             nSensorsCompleted++;
         }
     }
 
     while (nSensorsCompleted < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            /***
-            // THIS IS PURELY FOR DEEP DEBUGGING OF THE TIMING!
-            // Leave this whole section commented out unless you want excessive
-            // printouts (ie, thousands of lines) of the timing information!!
-            if (lastSensorVariable[i] and
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i])
-            {
-                MS_DEEP_DBG(i), '-',
-            arrayOfVars[i]->getParentSensorNameAndLocation(), F("- millis:"),
-            millis(), F("- status: 0b"),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            7), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 6),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            5), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            3), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 2),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            1), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0), F("-
-            measurement #"), (nMeasurementsCompleted[i] + 1);
-            }
-            // END CHUNK FOR DEBUGGING!
-            ***/
+        _lastUpdatePasses++;
+        startBusPass();
+        checkTimeBudgets();
+
+        // First, start a measurement on every stable sensor that isn't already
+        // measuring.  Starting a measurement is quick, so doing it for all of
+        // the sensors before collecting any results keeps a slow read from one
+        // sensor from delaying the start of a measurement on another bus.
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            SensorListEntry& entry  = _sensorList[s];
+            Sensor*          sensor = entry.sensor;
 
             // Only do checks on sensors that still have measurements to finish
-            if (lastSensorVariable[i] &&
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i]) {
-                // first, make sure the sensor is stable
-                if (arrayOfVars[i]->parentSensor->isStable(deepDebugTiming)) {
-                    // now, if the sensor is not currently measuring...
-                    if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 5) ==
-                        0) {  // NO attempt yet to start a measurement
-                        // Start a reading
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
-                               F("--->> Starting reading"),
-                               nMeasurementsCompleted[i] + 1, F("on"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
-                               '-');
-
-                        bool sensorSuccess_start =
-                            arrayOfVars[i]
-                                ->parentSensor->startSingleMeasurement();
-                        success &= sensorSuccess_start;
-
-                        if (sensorSuccess_start) {
-                            MS_DBG(F("   ... reading started! <<---"), i, '.',
-                                   nMeasurementsCompleted[i] + 1);
-                        } else {
-                            MS_DBG(F("   ... failed to start reading! <<---"),
-                                   i, '.', nMeasurementsCompleted[i] + 1);
-                        }
-                    }
-
-                    // otherwise, it is currently measuring so...
-                    // if a measurement is finished, get the result and tick up
-                    // the number of finished measurements
-                    // NOTE:  isMeasurementComplete(deepDebugTiming) will
-                    // immediately return true if the attempt to start a
-                    // measurement failed (bit 6 not set).  In that case, the
-                    // addSingleMeasurementResult() will be "adding" -9999
-                    // values.
-                    if (arrayOfVars[i]->parentSensor->isMeasurementComplete(
-                            deepDebugTiming)) {
-                        // Get the value
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
-                               F("--->> Collected result of reading"),
-                               nMeasurementsCompleted[i] + 1, F("from"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
-                               F("..."));
-
-                        bool sensorSuccess_result =
-                            arrayOfVars[i]
-                                ->parentSensor->addSingleMeasurementResult();
-                        success &= sensorSuccess_result;
-                        nMeasurementsCompleted[i] +=
-                            1;  // increment the number of measurements that
-                                // sensor has completed
-
-                        if (sensorSuccess_result) {
-                            MS_DBG(F("   ... got measurement result. <<---"), i,
-                                   '.', nMeasurementsCompleted[i]);
-                        } else {
-                            MS_DBG(F("   ... failed to get measurement result! "
-                                     "<<---"),
-                                   i, '.', nMeasurementsCompleted[i]);
-                        }
-                    }
+            if (entry.nMeasurementsToAverage <= entry.nMeasurementsCompleted) {
+                continue;
+            }
+
+            // If the sensor is stable, is not currently measuring, and can
+            // have the bus...
+            if (sensor->isStable(deepDebugTiming) &&
+                sensor->getState() <
+                    SENSOR_MEASUREMENT_ATTEMPTED  // NO attempt yet to start a
+                                                  // measurement
+                && acquireBus(s)) {
+                // Start a reading
+                MS_DBG(s, '.', entry.nMeasurementsCompleted + 1,
+                       F("--->> Starting reading"),
+                       entry.nMeasurementsCompleted + 1, F("on"),
+                       sensor->getSensorNameAndLocation(), '-');
+
+                bool sensorSuccess_start = sensor->startSingleMeasurement();
+                success &= sensorSuccess_start;
+                entry.measurementStarted = true;
+
+                if (sensorSuccess_start) {
+                    MS_DBG(F("   ... reading started! <<---"), s, '.',
+                           entry.nMeasurementsCompleted + 1);
+                } else {
+                    MS_DBG(F("   ... failed to start reading! <<---"), s, '.',
+                           entry.nMeasurementsCompleted + 1);
                 }
+            }
+        }
 
-                // if all the measurements are done, mark the whole sensor as
-                // done
-                if (nMeasurementsCompleted[i] == nMeasurementsToAverage[i]) {
-                    MS_DBG(F("--- Finished all measurements from"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
-                           F("---"));
+        // Then collect the results of finished measurements, taking at most
+        // one result from each shared bus per pass so the other buses can be
+        // serviced in between.
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            SensorListEntry& entry  = _sensorList[s];
+            Sensor*          sensor = entry.sensor;
+
+            if (entry.finished) { continue; }
+
+            // if a measurement is finished, get the result and tick up
+            // the number of finished measurements
+            // NOTE:  isMeasurementComplete(deepDebugTiming) will
+            // immediately return true if the attempt to start a
+            // measurement failed (bit 6 not set).  In that case, the
+            // addSingleMeasurementResult() will be "adding" -9999
+            // values.
+            if (entry.nMeasurementsToAverage > entry.nMeasurementsCompleted &&
+                isMeasuring(s) &&
+                sensor->isMeasurementComplete(deepDebugTiming) &&
+                claimBusTransaction(s)) {
+                // Get the value
+                MS_DBG(s, '.', entry.nMeasurementsCompleted + 1,
+                       F("--->> Collected result of reading"),
+                       entry.nMeasurementsCompleted + 1, F("from"),
+                       sensor->getSensorNameAndLocation(), F("..."));
+
+                bool isProbe = sensor->isProbingStability();
+                bool sensorSuccess_result =
+                    sensor->addSingleMeasurementResult();
+                success &= sensorSuccess_result;
+                entry.measurementStarted = false;
+                releaseBus(s);
+                if (isProbe) {
+                    // A probe reading only checks whether the sensor has
+                    // stabilized; it doesn't count toward the average
+                    sensor->addStabilityProbe();
+                } else {
+                    // increment the number of measurements that sensor has
+                    // completed
+                    entry.nMeasurementsCompleted++;
+                    checkEarlyStop(s);
+                }
 
-                    nSensorsCompleted++;
-                    MS_DBG(F("*****---"), nSensorsCompleted,
-                           F("sensors now complete ---*****"));
+                if (sensorSuccess_result) {
+                    MS_DBG(F("   ... got measurement result. <<---"), s, '.',
+                           entry.nMeasurementsCompleted);
+                } else {
+                    MS_DBG(F("   ... failed to get measurement result! "
+                             "<<---"),
+                           s, '.', entry.nMeasurementsCompleted);
                 }
             }
+
+            // if all the measurements are done, mark the whole sensor as
+            // done
+            if (entry.nMeasurementsCompleted == entry.nMeasurementsToAverage) {
+                MS_DBG(F("--- Finished all measurements from"),
+                       sensor->getSensorNameAndLocation(), F("---"));
+
+                entry.finished = true;
+                releaseBus(s);
+                nSensorsCompleted++;
+                MS_DBG(F("*****---"), nSensorsCompleted,
+                       F("sensors now complete ---*****"));
+            }
+        }
+
+#ifndef MS_VARIABLEARRAY_BUSY_WAIT
+        // Rather than immediately re-checking every sensor, idle the processor
+        // until the soonest time any unfinished sensor will need attention.
+        if (nSensorsCompleted < _sensorCount) {
+            idleTime += idleFor(getTimeUntilNextEvent());
         }
+#endif
     }
 
     // Average measurements and notify varibles of the updates
     MS_DBG(F("----->> Averaging results and notifying all variables. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            MS_DEEP_DBG(F("--- Averaging results from"),
-                        arrayOfVars[i]->getParentSensorNameAndLocation(),
-                        F("---"));
-            arrayOfVars[i]->parentSensor->averageMeasurements();
-            MS_DEEP_DBG(F("--- Notifying variables from"),
-                        arrayOfVars[i]->getParentSensorNameAndLocation(),
-                        F("---"));
-            arrayOfVars[i]->parentSensor->notifyVariables();
-        }
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        _sensorList[s].sensor->updateHealth();
+        MS_DEEP_DBG(F("--- Averaging results from"),
+                    _sensorList[s].sensor->getSensorNameAndLocation(),
+                    F("---"));
+        _sensorList[s].sensor->averageMeasurements();
+        MS_DEEP_DBG(F("--- Notifying variables from"),
+                    _sensorList[s].sensor->getSensorNameAndLocation(),
+                    F("---"));
+        _sensorList[s].sensor->notifyVariables();
     }
     MS_DBG(F("... Complete. <<-----"));
 
+    calculateVariables();
+
+    _lastUpdateTime_ms      = millis() - _millisUpdateStarted;
+    _lastUpdateAwakeTime_us = micros() - _microsUpdateStarted - idleTime;
+    MS_DBG(F("Update took"), _lastUpdateTime_ms, F("ms over"),
+           _lastUpdatePasses, F("passes through the sensor loop, idling for"),
+           idleTime, F("us."));
+    if (_lastUpdateTimeouts > 0) {
+        MS_DBG(_lastUpdateTimeouts, F("sensors ran out of time."));
+    }
+
+    return success;
+}
+
+
+// This runs the non-blocking updates of a list of sensors together
+bool VariableArray::updateSensors(Sensor* sensors[], uint8_t sensorCount,
+                                  uint32_t timeBudget_ms, void (*onPass)()) {
+    if (sensorCount > 32) { sensorCount = 32; }
+    uint32_t start   = millis();
+    bool     success = true;
+
+    // Check the power to every sensor before powering any of them, so a sensor
+    // sharing a power pin with another isn't mistaken for having been on
+    uint32_t wasOn = 0;
+    for (uint8_t i = 0; i < sensorCount; i++) {
+        if (sensors[i]->checkPowerOn()) { wasOn |= 1UL << i; }
+    }
+    for (uint8_t i = 0; i < sensorCount; i++) {
+        if (!sensors[i]->checkPowerOn()) { sensors[i]->powerUp(); }
+    }
+
+    for (uint8_t i = 0; i < sensorCount; i++) { sensors[i]->startUpdate(); }
+
+    // Each pass starts every measurement that is ready, so the start commands
+    // go out back to back, and collects every result that is due
+    bool updating = true;
+    while (updating) {
+        updating      = false;
+        uint32_t now  = millis();
+        uint32_t wait = 0xFFFFFFFF;
+        for (uint8_t i = 0; i < sensorCount; i++) {
+            Sensor* sensor = sensors[i];
+            if (!sensor->isUpdating()) { continue; }
+
+            // Abandon a sensor that has run out of its own time or the list's
+            uint32_t elapsed  = now - start;
+            uint32_t timeLeft = 0xFFFFFFFF;
+            if (timeBudget_ms > 0) {
+                timeLeft = elapsed < timeBudget_ms ? timeBudget_ms - elapsed
+                                                   : 0;
+            }
+            uint32_t sensorBudget = sensor->getTimeBudget();
+            if (sensorBudget > 0) {
+                uint32_t sensorLeft = elapsed < sensorBudget
+                    ? sensorBudget - elapsed
+                    : 0;
+                if (sensorLeft < timeLeft) { timeLeft = sensorLeft; }
+            }
+            if (timeLeft == 0) {
+                sensor->markTimedOut();
+                continue;
+            }
+
+            uint32_t next = sensor->tick(now);
+            if (!sensor->isUpdating()) { continue; }
+            updating = true;
+            if (next - now < wait) { wait = next - now; }
+            // The sensor must be checked again when it runs out of time
+            if (timeLeft < wait) { wait = timeLeft; }
+        }
+        if (onPass != nullptr) { onPass(); }
+#ifndef MS_VARIABLEARRAY_BUSY_WAIT
+        uint32_t spent = millis() - now;
+        if (updating && spent < wait) { idleFor(wait - spent); }
+#endif
+    }
+
+    for (uint8_t i = 0; i < sensorCount; i++) {
+        success &= sensors[i]->getUpdateSuccess();
+        if ((wasOn & (1UL << i)) == 0) { sensors[i]->powerDown(); }
+    }
+    MS_DBG(F("Updated"), sensorCount, F("sensors together in"),
+           millis() - start, F("ms"));
     return success;
 }
 
@@ -489,8 +523,13 @@ bool VariableArray::updateAllSensors(void) {
 // This function is an even more complete version of the updateAllSensors
 // function - it handles power up/down and wake/sleep.
 bool VariableArray::completeUpdate(void) {
-    bool    success           = true;
-    uint8_t nSensorsCompleted = 0;
+    bool     success           = true;
+    uint8_t  nSensorsCompleted = 0;
+    uint32_t idleTime          = 0;
+    _millisUpdateStarted       = millis();
+    _microsUpdateStarted       = micros();
+    _lastUpdatePasses          = 0;
+    _lastUpdateTimeouts        = 0;
 
 #ifdef MS_VARIABLEARRAY_DEBUG_DEEP
     bool deepDebugTiming = true;
@@ -498,345 +537,642 @@ bool VariableArray::completeUpdate(void) {
     bool deepDebugTiming = false;
 #endif
 
-    // Create an array with the unique-ness value (so we can skip the function
-    // calls later)
-    MS_DBG(F("Creating a mask array with the uniqueness for each sensor.."));
-    bool lastSensorVariable[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        lastSensorVariable[i] = isLastVarFromSensor(i);
+    // Reset the number of measurements completed and re-read the number of
+    // measurements to average, in case it has changed
+    if (_sensorList == nullptr) { buildSensorList(); }
+    resetSensorList();
+
+    // Mark any sensors that aren't due in this interval or are backed off
+    // after failing as already complete so they will be skipped in all further
+    // looping
+    MS_DBG(F("----->> Starting update in interval"), _intervalNumber,
+           F("..."));
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        if (!entry.sensor->isMeasurementDue(_intervalNumber)) {
+            MS_DBG(s, F("--->>"), entry.sensor->getSensorNameAndLocation(),
+                   F("is not due in this interval and will be skipped. <<---"),
+                   s);
+        } else if (entry.sensor->skipForBackoff()) {
+            MS_DBG(s, F("--->>"), entry.sensor->getSensorNameAndLocation(),
+                   F("has been failing and will be skipped. <<---"), s);
+        } else {
+            continue;
+        }
+        entry.skipped                = true;
+        entry.finished               = true;
+        entry.nMeasurementsCompleted = entry.nMeasurementsToAverage;
+        nSensorsCompleted++;
     }
+    _intervalNumber++;
 
-    // Create an array for the number of measurements already completed and set
-    // all to zero
-    MS_DBG(F("Creating an array for the number of completed measurements.."));
-    uint8_t nMeasurementsCompleted[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        nMeasurementsCompleted[i] = 0;
+    // Clear the initial variable arrays, keeping the last results of skipped
+    // sensors
+    MS_DBG(F("----->> Clearing all results arrays before taking new "
+             "measurements. ..."));
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (!_sensorList[s].skipped) { _sensorList[s].sensor->clearValues(); }
     }
+    MS_DBG(F("   ... Complete. <<-----"));
 
-    // Create an array for the number of measurements to average (another short
-    // cut)
-    MS_DBG(F("Creating an array with the number of measurements to average.."));
-    uint8_t nMeasurementsToAverage[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            nMeasurementsToAverage[i] =
-                arrayOfVars[i]->parentSensor->getNumberMeasurementsToAverage();
-        } else {
-            nMeasurementsToAverage[i] = 0;
+    // power up as many sensors as the power budget allows; the rest will be
+    // powered as the inrush from the first ones passes or they are powered
+    // down.  Sensors whose power isn't switched by the mcu are always on and
+    // never wait.  Groups with no sensors due are never powered.
+    MS_DBG(F("----->> Powering up sensors within the power budget of"),
+           _powerBudget_mA, F("mA, with"), _reservedCurrent_mA,
+           F("mA reserved. ..."));
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        _sensorList[s].waitingForPower = true;
+    }
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        if (isPowerGroupSkipped(entry.powerGroup)) {
+            entry.waitingForPower = false;
+            entry.poweredDown     = true;
+        } else if (!isPowerSwitched(s)) {
+            powerUpGroup(s);
         }
     }
+    powerUpWithinBudget();
+    MS_DBG(F("   ... Complete. <<-----"));
 
-    // Create an array of the power pins
-    MS_DBG(F("Creating an array of the power pins.."));
-    int8_t powerPins[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            powerPins[i] = arrayOfVars[i]->parentSensor->getPowerPin();
-        } else {
-            powerPins[i] = 0;
+    while (nSensorsCompleted < _sensorCount) {
+        _lastUpdatePasses++;
+        startBusPass();
+        checkTimeBudgets();
+        powerUpWithinBudget();
+
+        // First, wake any warmed up sensors and start a measurement on every
+        // stable sensor that isn't already measuring.  These are quick
+        // commands, so doing them for all of the sensors before collecting any
+        // results keeps a slow read from one sensor from delaying the start of
+        // a measurement on another bus.
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            SensorListEntry& entry  = _sensorList[s];
+            Sensor*          sensor = entry.sensor;
+
+            // Only do checks on sensors that are powered and still have
+            // measurements to finish
+            if (entry.waitingForPower ||
+                entry.nMeasurementsToAverage <= entry.nMeasurementsCompleted) {
+                continue;
+            }
+
+            if (sensor->getState() <
+                    SENSOR_WAKE_ATTEMPTED  // If no attempts yet made to wake
+                                           // the sensor up
+                && !isProbeHeldOff(s)  // and it won't disturb the bus
+                && sensor->isWarmedUp(
+                       deepDebugTiming)  // and if it is already warmed up
+            ) {
+                MS_DBG(s, F("--->> Waking"), sensor->getSensorNameAndLocation(),
+                       F("..."));
+
+                // Make a single attempt to wake the sensor after it is
+                // warmed up
+                bool sensorSuccess_wake = sensor->wake();
+                success &= sensorSuccess_wake;
+
+                if (sensorSuccess_wake) {
+                    MS_DBG(F("   ... wake up success. <<---"), s);
+                } else {
+                    // If the attempt to wake the sensor failed - including
+                    // when it never had power to wake - then we're just
+                    // bumping up the number of measurements to completion
+                    MS_DBG(s, F("--->>"), sensor->getSensorNameAndLocation(),
+                           F("did not wake up! No measurements will be taken! "
+                             "<<---"),
+                           s);
+                    // Set the number of measurements already equal to
+                    // whatever total number requested to ensure the sensor is
+                    // skipped in further loops.
+                    entry.nMeasurementsCompleted = entry.nMeasurementsToAverage;
+                    continue;
+                }
+            }
+
+            // If the sensor was successfully awoken/activated, is stable, has
+            // no measurement started yet, and can have the bus, start one
+            if (sensor->getState() >= SENSOR_AWAKE &&
+                sensor->isStable(deepDebugTiming) &&
+                sensor->getState() < SENSOR_MEASUREMENT_ATTEMPTED &&
+                acquireBus(s)) {
+                // Start a reading
+                MS_DBG(s, '.', entry.nMeasurementsCompleted + 1,
+                       F("--->> Starting reading"),
+                       entry.nMeasurementsCompleted + 1, F("on"),
+                       sensor->getSensorNameAndLocation(), F("..."));
+
+                bool sensorSuccess_start = sensor->startSingleMeasurement();
+                success &= sensorSuccess_start;
+                entry.measurementStarted = true;
+
+                if (sensorSuccess_start) {
+                    MS_DBG(F("   ... start reading succeeded. <<---"), s, '.',
+                           entry.nMeasurementsCompleted + 1);
+                } else {
+                    MS_DBG(F("   ... start reading failed! <<---"), s, '.',
+                           entry.nMeasurementsCompleted + 1);
+                }
+            }
         }
-    }
 
-    // Create an array of the last variable on each power pin
-    MS_DBG(F("Creating arrays of the power pin locations.."));
-    bool lastPinVariable[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { lastPinVariable[i] = true; }
-    // Create an array containing the index of the power pin in the powerPins
-    // array
-    int8_t powerPinIndex[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { powerPinIndex[i] = 0; }
-    // Create an array to tell us how many measurements must be taken
-    // before all the sensors attached to a power pin are done
-    uint8_t nMeasurementsOnPin[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        nMeasurementsOnPin[i] = nMeasurementsToAverage[i];
-    }
-    // Now correctly populate the previous three arrays
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        for (uint8_t j = i + 1; j < _variableCount; j++) {
-            if (!lastSensorVariable[i]) {
-                lastPinVariable[i] = false;
-            } else if (powerPins[i] == powerPins[j]) {
-                lastPinVariable[i] = false;
+        // Then collect the results of finished measurements, taking at most
+        // one result from each shared bus per pass so the other buses can be
+        // serviced in between.
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            SensorListEntry& entry  = _sensorList[s];
+            Sensor*          sensor = entry.sensor;
+
+            if (entry.finished) { continue; }
+
+            // If a measurement is finished, get the result and tick up
+            // the number of finished measurements.  We aren't bothering
+            // to check if the measurement start was successful,
+            // isMeasurementComplete(deepDebugTiming) will do that and
+            // we stil want the addSingleMeasurementResult() function to
+            // fill in the -9999 results for a failed measurement.
+            if (entry.nMeasurementsToAverage > entry.nMeasurementsCompleted &&
+                isMeasuring(s) &&
+                sensor->isMeasurementComplete(deepDebugTiming) &&
+                claimBusTransaction(s)) {
+                // Get the value
+                MS_DBG(s, '.', entry.nMeasurementsCompleted + 1,
+                       F("--->> Collected result of reading"),
+                       entry.nMeasurementsCompleted + 1, F("from"),
+                       sensor->getSensorNameAndLocation(), F("..."));
+
+                bool isProbe = sensor->isProbingStability();
+                bool sensorSuccess_result =
+                    sensor->addSingleMeasurementResult();
+                success &= sensorSuccess_result;
+                entry.measurementStarted = false;
+                releaseBus(s);
+                if (isProbe) {
+                    // A probe reading only checks whether the sensor has
+                    // stabilized; it doesn't count toward the average
+                    sensor->addStabilityProbe();
+                } else {
+                    // increment the number of measurements that sensor has
+                    // completed
+                    entry.nMeasurementsCompleted++;
+                    checkEarlyStop(s);
+                }
+
+                if (sensorSuccess_result) {
+                    MS_DBG(F("   ... got measurement result. <<---"), s, '.',
+                           entry.nMeasurementsCompleted);
+                } else {
+                    MS_DBG(F("   ... failed to get measurement result! "
+                             "<<---"),
+                           s, '.', entry.nMeasurementsCompleted);
+                }
+            }
+
+            // If all the measurements are done
+            if (entry.nMeasurementsCompleted == entry.nMeasurementsToAverage) {
+                MS_DBG(s, F("--->> Finished all measurements from"),
+                       sensor->getSensorNameAndLocation(),
+                       F(", putting it to sleep. ..."));
+
+                // Put the completed sensor to sleep
+                bool sensorSuccess_sleep = sensor->sleep();
+                success &= sensorSuccess_sleep;
+
+                if (sensorSuccess_sleep) {
+                    MS_DBG(F("   ... succeeded in putting sensor to sleep. "
+                             "<<---"),
+                           s);
+                } else {
+                    MS_DBG(F("   ... sleep failed! <<---"), s);
+                }
+
+                // Release this sensor's bus and power rails and cut the power
+                // to any finished sensors whose rails are no longer in use,
+                // then use any freed power budget for waiting sensors
+                entry.finished = true;
+                releaseBus(s);
+                releaseSensorPower(s);
+                powerUpWithinBudget();
+
+                nSensorsCompleted++;  // mark the whole sensor as done
+                MS_DBG(F("*****---"), nSensorsCompleted,
+                       F("sensors now complete ---*****"));
             }
-            i++;
         }
+
+#ifndef MS_VARIABLEARRAY_BUSY_WAIT
+        // Rather than immediately re-checking every sensor, idle the processor
+        // until the soonest time any unfinished sensor will need attention.
+        if (nSensorsCompleted < _sensorCount) {
+            idleTime += idleFor(getTimeUntilNextEvent());
+        }
+#endif
     }
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastPinVariable[i]) {
-            powerPinIndex[i]      = i;
-            nMeasurementsOnPin[i] = nMeasurementsToAverage[i];
-            for (uint8_t j = 0; j < _variableCount; j++) {
-                if (powerPins[j] == powerPins[i] && i != j) {
-                    powerPinIndex[j] = i;
-                    nMeasurementsOnPin[i] += nMeasurementsToAverage[j];
-                    nMeasurementsOnPin[j] = 0;
+
+    // Average measurements and notify varibles of the updates
+    MS_DBG(F("----->> Averaging results and notifying all variables. ..."));
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (_sensorList[s].skipped) {
+            // Leave the last values in place, but flag them as stale
+            MS_DBG(F("--- Marking variables from"),
+                   _sensorList[s].sensor->getSensorNameAndLocation(),
+                   F("stale ---"));
+            for (uint8_t i = _sensorList[s].firstVarIndex;
+                 i <= _sensorList[s].lastVarIndex; i++) {
+                if (!arrayOfVars[i]->isCalculated &&
+                    arrayOfVars[i]->parentSensor == _sensorList[s].sensor) {
+                    arrayOfVars[i]->markStale();
                 }
             }
+            continue;
         }
+        _sensorList[s].sensor->updateHealth();
+        MS_DBG(F("--- Averaging results from"),
+               _sensorList[s].sensor->getSensorNameAndLocation(), F("---"));
+        _sensorList[s].sensor->averageMeasurements();
+        MS_DBG(F("--- Notifying variables from"),
+               _sensorList[s].sensor->getSensorNameAndLocation(), F("---"));
+        _sensorList[s].sensor->notifyVariables();
     }
+    MS_DBG(F("... Complete. <<-----"));
 
-// This is just for debugging
-#ifdef MS_VARIABLEARRAY_DEBUG_DEEP
-    uint8_t arrayPositions[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { arrayPositions[i] = i; }
-    String nameLocation[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        // nameLocation[i] = arrayOfVars[i]->getParentSensorNameAndLocation();
-        nameLocation[i] = arrayOfVars[i]->getParentSensorName();
-    }
-    MS_DEEP_DBG(F("----------------------------------"));
-    MS_DEEP_DBG(F("arrayPositions:\t\t\t"));
-    prettyPrintArray(arrayPositions);
-    MS_DEEP_DBG(F("sensor:\t\t\t"));
-    prettyPrintArray(nameLocation);
-    MS_DEEP_DBG(F("lastSensorVariable:\t\t"));
-    prettyPrintArray(lastSensorVariable);
-    MS_DEEP_DBG(F("nMeasurementsToAverage:\t\t"));
-    prettyPrintArray(nMeasurementsToAverage);
-    MS_DEEP_DBG(F("nMeasurementsCompleted:\t\t"));
-    prettyPrintArray(nMeasurementsCompleted);
-    MS_DEEP_DBG(F("powerPins:\t\t\t"));
-    prettyPrintArray(powerPins);
-    MS_DEEP_DBG(F("lastPinVariable:\t\t"));
-    prettyPrintArray(lastPinVariable);
-    MS_DEEP_DBG(F("powerPinIndex:\t\t\t"));
-    prettyPrintArray(powerPinIndex);
-    MS_DEEP_DBG(F("nMeasurementsOnPin:\t\t"));
-    prettyPrintArray(nMeasurementsOnPin);
-    MS_DEEP_DBG(F("powerPinIndex:\t\t\t"));
-    prettyPrintArray(powerPinIndex);
-#endif
+    calculateVariables();
 
-    // Another array for the number of measurements already completed per power
-    // pin
-    uint8_t nCompletedOnPin[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { nCompletedOnPin[i] = 0; }
+    _lastUpdateTime_ms      = millis() - _millisUpdateStarted;
+    _lastUpdateAwakeTime_us = micros() - _microsUpdateStarted - idleTime;
+    MS_DBG(F("Update took"), _lastUpdateTime_ms, F("ms over"),
+           _lastUpdatePasses, F("passes through the sensor loop, idling for"),
+           idleTime, F("us."));
+    if (_lastUpdateTimeouts > 0) {
+        MS_DBG(_lastUpdateTimeouts, F("sensors ran out of time."));
+    }
+    for (uint8_t r = 0; r < _powerRailCount; r++) {
+        MS_DBG(F("    Power rail on pin"), _powerRails[r].getPowerPin(),
+               F("was on for"), _powerRails[r].getOnTime(), F("ms."));
+    }
 
-    // Clear the initial variable arrays
-    MS_DBG(F("----->> Clearing all results arrays before taking new "
-             "measurements. ..."));
+    return success;
+}
+
+
+// This clears the cached values of all calculated variables and calculates
+// each variable in the array once; each is calculated after any variables it
+// depends on
+void VariableArray::calculateVariables(void) {
+    MS_DBG(F("----->> Calculating all calculated variables. ..."));
+    Variable::startNewGeneration();
     for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            arrayOfVars[i]->parentSensor->clearValues();
+        if (arrayOfVars[i]->isCalculated) { arrayOfVars[i]->getValue(); }
+    }
+    MS_DBG(F("... Complete. <<-----"));
+}
+
+
+// This releases the power rails of a sensor that has finished all of its
+// measurements and powers down any finished sensors that are now on only idle
+// rails.
+void VariableArray::releaseSensorPower(uint8_t sensorIndex) {
+    SensorListEntry& entry = _sensorList[sensorIndex];
+    if (entry.powerRail != NO_POWER_RAIL) {
+        _powerRails[entry.powerRail].release();
+    }
+    if (entry.secondaryPowerRail != NO_POWER_RAIL) {
+        _powerRails[entry.secondaryPowerRail].release();
+    }
+
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& other = _sensorList[s];
+        if (other.poweredDown ||
+            other.nMeasurementsCompleted < other.nMeasurementsToAverage) {
+            continue;
+        }
+        if ((other.powerRail == NO_POWER_RAIL ||
+             _powerRails[other.powerRail].isIdle()) &&
+            (other.secondaryPowerRail == NO_POWER_RAIL ||
+             _powerRails[other.secondaryPowerRail].isIdle())) {
+            powerDownSensor(s);
         }
     }
-    MS_DBG(F("   ... Complete. <<-----"));
+}
 
-    // power up all of the sensors together
-    MS_DBG(F("----->> Powering up all sensors together. ..."));
-    sensorsPowerUp();
-    MS_DBG(F("   ... Complete. <<-----"));
 
-    while (nSensorsCompleted < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            /***
-            // THIS IS PURELY FOR DEEP DEBUGGING OF THE TIMING!
-            // Leave this whole section commented out unless you want excessive
-            // printouts (ie, thousands of lines) of the timing information!!
-            if (lastSensorVariable[i] and
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i]) {
-                MS_DEEP_DBG(
-                    i, '-', arrayOfVars[i]->getParentSensorNameAndLocation(),
-                    F("- millis:"), millis(), F("- status: 0b"),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 7),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 6),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 5),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 2),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 1),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0),
-                    F("- measurement #"), (nMeasurementsCompleted[i] + 1));
-            }
-            MS_DEEP_DBG(F("----------------------------------"));
-            MS_DEEP_DBG(F("nMeasurementsToAverage:\t\t"));
-            prettyPrintArray(nMeasurementsToAverage);
-            MS_DEEP_DBG(F("nMeasurementsCompleted:\t\t"));
-            prettyPrintArray(nMeasurementsCompleted);
-            MS_DEEP_DBG(F("nMeasurementsOnPin:\t\t"));
-            prettyPrintArray(nMeasurementsOnPin);
-            MS_DEEP_DBG(F("nCompletedOnPin:\t\t\t"));
-            prettyPrintArray(nCompletedOnPin);
-            // END CHUNK FOR DEBUGGING!
-            ***/
+// This powers down a single sensor and marks it off on its rails
+void VariableArray::powerDownSensor(uint8_t sensorIndex) {
+    SensorListEntry& entry = _sensorList[sensorIndex];
+    entry.sensor->powerDown();
+    MS_DBG(sensorIndex, F("--->>"), entry.sensor->getSensorNameAndLocation(),
+           F("powered down. <<---"), sensorIndex);
+    if (entry.poweredDown) { return; }
+    entry.poweredDown = true;
+    if (entry.powerRail != NO_POWER_RAIL) {
+        _powerRails[entry.powerRail].sensorPoweredDown();
+    }
+    if (entry.secondaryPowerRail != NO_POWER_RAIL) {
+        _powerRails[entry.secondaryPowerRail].sensorPoweredDown();
+    }
+}
 
-            // Only do checks on sensors that still have measurements to finish
-            if (lastSensorVariable[i] &&
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i]) {
-                if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                        0  // If no attempts yet made to wake the sensor up
-                    && arrayOfVars[i]->parentSensor->isWarmedUp(
-                           deepDebugTiming)  // and if it is already warmed up
-                ) {
-                    MS_DBG(i, F("--->> Waking"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
-                           F("..."));
-
-                    // Make a single attempt to wake the sensor after it is
-                    // warmed up
-                    bool sensorSuccess_wake =
-                        arrayOfVars[i]->parentSensor->wake();
-                    success &= sensorSuccess_wake;
-
-                    if (sensorSuccess_wake) {
-                        MS_DBG(F("   ... wake up success. <<---"), i);
-                    } else {
-                        MS_DBG(F("   ... wake up failed! <<---"), i);
-                    }
-                }
 
-                // If attempts were made to wake the sensor, but they failed
-                // then we're just bumping up the number of measurements to
-                // completion
-                if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                        1 &&
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4) ==
-                        0) {
-                    MS_DBG(i, F("--->>"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
-                           F("did not wake up! No measurements will be taken! "
-                             "<<---"),
-                           i);
-                    // Set the number of measurements already equal to whatever
-                    // total number requested to ensure the sensor is skipped in
-                    // further loops.
-                    nMeasurementsCompleted[i] = nMeasurementsToAverage[i];
-                    // increment the number of measurements that the power pin
-                    // has completed
-                    nCompletedOnPin[powerPinIndex[i]] +=
-                        nMeasurementsToAverage[i];
-                }
+// This checks if two sensors are on any of the same power rails
+bool VariableArray::sharePowerRail(uint8_t first, uint8_t second) {
+    uint8_t firstRails[2]  = {_sensorList[first].powerRail,
+                              _sensorList[first].secondaryPowerRail};
+    uint8_t secondRails[2] = {_sensorList[second].powerRail,
+                              _sensorList[second].secondaryPowerRail};
+    for (uint8_t i = 0; i < 2; i++) {
+        if (firstRails[i] == NO_POWER_RAIL) { continue; }
+        if (firstRails[i] == secondRails[0] ||
+            firstRails[i] == secondRails[1]) {
+            return true;
+        }
+    }
+    return false;
+}
 
-                // If the sensor was successfully awoken/activated...
-                // .. make sure the sensor is stable
-                if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4) ==
-                        1 &&
-                    arrayOfVars[i]->parentSensor->isStable(deepDebugTiming)) {
-                    // If no attempt has yet been made to start a measurement,
-                    // start one
-                    if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 5) ==
-                        0) {
-                        // Start a reading
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
-                               F("--->> Starting reading"),
-                               nMeasurementsCompleted[i] + 1, F("on"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
-                               F("..."));
-
-                        bool sensorSuccess_start =
-                            arrayOfVars[i]
-                                ->parentSensor->startSingleMeasurement();
-                        success &= sensorSuccess_start;
-
-                        if (sensorSuccess_start) {
-                            MS_DBG(F("   ... start reading succeeded. <<---"),
-                                   i, '.', nMeasurementsCompleted[i] + 1);
-                        } else {
-                            MS_DBG(F("   ... start reading failed! <<---"), i,
-                                   '.', nMeasurementsCompleted[i] + 1);
-                        }
-                    }
-
-                    // If a measurement is finished, get the result and tick up
-                    // the number of finished measurements.  We aren't bothering
-                    // to check if the measurement start was successful,
-                    // isMeasurementComplete(deepDebugTiming) will do that and
-                    // we stil want the addSingleMeasurementResult() function to
-                    // fill in the -9999 results for a failed measurement.
-                    if (arrayOfVars[i]->parentSensor->isMeasurementComplete(
-                            deepDebugTiming)) {
-                        // Get the value
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
-                               F("--->> Collected result of reading"),
-                               nMeasurementsCompleted[i] + 1, F("from"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
-                               F("..."));
-
-                        bool sensorSuccess_result =
-                            arrayOfVars[i]
-                                ->parentSensor->addSingleMeasurementResult();
-                        success &= sensorSuccess_result;
-                        nMeasurementsCompleted[i] +=
-                            1;  // increment the number of measurements that
-                                // sensor has completed
-                        nCompletedOnPin[powerPinIndex[i]] +=
-                            1;  // increment the number of measurements that the
-                                // power pin has completed
-
-                        if (sensorSuccess_result) {
-                            MS_DBG(F("   ... got measurement result. <<---"), i,
-                                   '.', nMeasurementsCompleted[i]);
-                        } else {
-                            MS_DBG(F("   ... failed to get measurement result! "
-                                     "<<---"),
-                                   i, '.', nMeasurementsCompleted[i]);
-                        }
-                    }
-                }
 
-                // If all the measurements are done
-                if (nMeasurementsCompleted[i] == nMeasurementsToAverage[i]) {
-                    MS_DBG(i, F("--->> Finished all measurements from"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
-                           F(", putting it to sleep. ..."));
-
-                    // Put the completed sensor to sleep
-                    bool sensorSuccess_sleep =
-                        arrayOfVars[i]->parentSensor->sleep();
-                    success &= sensorSuccess_sleep;
-
-                    if (sensorSuccess_sleep) {
-                        MS_DBG(F("   ... succeeded in putting sensor to sleep. "
-                                 "<<---"),
-                               i);
-                    } else {
-                        MS_DBG(F("   ... sleep failed! <<---"), i);
-                    }
-
-                    // Now cut the power, if ready, to this sensors and all that
-                    // share the pin
-                    if (nCompletedOnPin[powerPinIndex[i]] ==
-                        nMeasurementsOnPin[powerPinIndex[i]]) {
-                        for (uint8_t k = 0; k < _variableCount; k++) {
-                            if (powerPinIndex[k] == powerPinIndex[i] &&
-                                lastSensorVariable[k]) {
-                                arrayOfVars[k]->parentSensor->powerDown();
-                                MS_DBG(k, F("--->>"),
-                                       arrayOfVars[k]
-                                           ->getParentSensorNameAndLocation(),
-                                       F("powered down. <<---"), k);
-                            }
-                        }
-                    }
-
-                    nSensorsCompleted++;  // mark the whole sensor as done
-                    MS_DBG(F("*****---"), nSensorsCompleted,
-                           F("sensors now complete ---*****"));
-                }
+// This checks if the mcu switches power to a sensor
+bool VariableArray::isPowerSwitched(uint8_t sensorIndex) {
+    return _sensorList[sensorIndex].powerRail != NO_POWER_RAIL ||
+        _sensorList[sensorIndex].secondaryPowerRail != NO_POWER_RAIL;
+}
+
+
+// This adds up the current drawn by the powered sensors - the peak current
+// for those still in their inrush and the steady current for the rest.
+// Sensors that are always on have no inrush.
+uint32_t VariableArray::getCurrentLoad(void) {
+    uint32_t load = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        if (entry.waitingForPower || entry.poweredDown) { continue; }
+        if (isPowerSwitched(s) &&
+            millis() - entry.millisPoweredUp < entry.sensor->getInrushTime()) {
+            load += entry.sensor->getPeakCurrent();
+        } else {
+            load += entry.sensor->getSteadyCurrent();
+        }
+    }
+    return load;
+}
+
+
+// This powers up the waiting power groups, longest warm-up first, until the
+// next one would put the current over the budget
+void VariableArray::powerUpWithinBudget(void) {
+    while (true) {
+        // Find the waiting group with the longest warm-up and its peak current
+        uint8_t  nextGroup  = NO_POWER_RAIL;
+        uint32_t nextWarmUp = 0;
+        uint32_t nextPeak   = 0;
+        for (uint8_t g = 0; g < _sensorCount; g++) {
+            if (_sensorList[g].powerGroup != g ||
+                !_sensorList[g].waitingForPower) {
+                continue;
+            }
+            uint32_t warmUp = 0;
+            uint32_t peak   = 0;
+            for (uint8_t s = g; s < _sensorCount; s++) {
+                if (_sensorList[s].powerGroup != g) { continue; }
+                warmUp = max(warmUp, _sensorList[s].sensor->getWarmUpTime());
+                peak += _sensorList[s].sensor->getPeakCurrent();
+            }
+            if (nextGroup == NO_POWER_RAIL || warmUp > nextWarmUp) {
+                nextGroup  = g;
+                nextWarmUp = warmUp;
+                nextPeak   = peak;
             }
         }
+        if (nextGroup == NO_POWER_RAIL) { return; }
+
+        // Always allow one group on, even if it alone is over the budget
+        if (_powerBudget_mA > 0) {
+            uint32_t load = getCurrentLoad();
+            if (load > 0 &&
+                load + _reservedCurrent_mA + nextPeak > _powerBudget_mA) {
+                MS_DEEP_DBG(F("Holding off power to"),
+                            _sensorList[nextGroup]
+                                .sensor->getSensorNameAndLocation(),
+                            F("until the current drops from"), load,
+                            F("mA"));
+                return;
+            }
+        }
+        powerUpGroup(nextGroup);
     }
+}
 
-    // Average measurements and notify varibles of the updates
-    MS_DBG(F("----->> Averaging results and notifying all variables. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            MS_DBG(F("--- Averaging results from"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(), F("---"));
-            arrayOfVars[i]->parentSensor->averageMeasurements();
-            MS_DBG(F("--- Notifying variables from"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(), F("---"));
-            arrayOfVars[i]->parentSensor->notifyVariables();
+
+// This checks if none of the sensors in a power group are due to be measured
+bool VariableArray::isPowerGroupSkipped(uint8_t group) {
+    for (uint8_t s = group; s < _sensorCount; s++) {
+        if (_sensorList[s].powerGroup == group && !_sensorList[s].skipped) {
+            return false;
         }
     }
-    MS_DBG(F("... Complete. <<-----"));
+    return true;
+}
 
-    return success;
+
+// This powers up all of the sensors in a power group
+// Skipped sensors in the group are on the group's rails but aren't themselves
+// powered; they release the rails right away.
+void VariableArray::powerUpGroup(uint8_t group) {
+    for (uint8_t s = group; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        if (entry.powerGroup != group) { continue; }
+        if (!entry.skipped) {
+            MS_DBG(s, F("--->> Powering up"),
+                   entry.sensor->getSensorNameAndLocation(), F("<<---"), s);
+            entry.sensor->powerUp();
+        }
+        entry.poweredDown     = false;
+        entry.waitingForPower = false;
+        entry.millisPoweredUp = millis();
+        if (entry.powerRail != NO_POWER_RAIL) {
+            _powerRails[entry.powerRail].powerUp();
+        }
+        if (entry.secondaryPowerRail != NO_POWER_RAIL) {
+            _powerRails[entry.secondaryPowerRail].powerUp();
+        }
+    }
+    for (uint8_t s = group; s < _sensorCount; s++) {
+        if (_sensorList[s].powerGroup == group && _sensorList[s].skipped) {
+            releaseSensorPower(s);
+        }
+    }
+}
+
+
+// This resets the per-pass bus transaction flags
+void VariableArray::startBusPass(void) {
+    for (uint8_t b = 0; b < _busCount; b++) { _buses[b].serviced = false; }
+}
+
+
+// This checks if a sensor has a measurement in progress (or a failed start
+// that still needs its -9999 result added)
+bool VariableArray::isMeasuring(uint8_t sensorIndex) {
+    return _sensorList[sensorIndex].measurementStarted ||
+        _sensorList[sensorIndex].sensor->getState() >=
+        SENSOR_MEASUREMENT_ATTEMPTED;
+}
+
+
+// This checks if another sensor has locked a sensor's bus
+bool VariableArray::isBusLockedByOther(uint8_t sensorIndex) {
+    SensorListEntry& entry = _sensorList[sensorIndex];
+    if (entry.bus == NO_SENSOR_BUS) { return false; }
+    uint8_t holder = _buses[entry.bus].lockHolder;
+    return holder != BUS_UNLOCKED && holder != sensorIndex;
+}
+
+
+// This checks if a sensor is waiting on another sensor to release its bus
+bool VariableArray::isWaitingForBus(uint8_t sensorIndex) {
+    if (!_sensorList[sensorIndex].sensor->needsExclusiveBus()) { return false; }
+    return isBusLockedByOther(sensorIndex);
+}
+
+
+// This checks if a sensor must hold off probing for readiness because another
+// sensor needs the bus to itself
+bool VariableArray::isProbeHeldOff(uint8_t sensorIndex) {
+    return _sensorList[sensorIndex].sensor->getReadinessProbing() &&
+        isBusLockedByOther(sensorIndex);
+}
+
+
+// This takes the bus lock for a sensor about to start a measurement, if the
+// sensor needs the bus to itself
+bool VariableArray::acquireBus(uint8_t sensorIndex) {
+    SensorListEntry& entry = _sensorList[sensorIndex];
+    if (entry.bus == NO_SENSOR_BUS || !entry.sensor->needsExclusiveBus()) {
+        return true;
+    }
+    if (isWaitingForBus(sensorIndex)) {
+        MS_DEEP_DBG(entry.sensor->getSensorNameAndLocation(),
+                    F("is waiting for"),
+                    _sensorList[_buses[entry.bus].lockHolder]
+                        .sensor->getSensorNameAndLocation(),
+                    F("to release the bus"));
+        return false;
+    }
+    _buses[entry.bus].lockHolder = sensorIndex;
+    return true;
 }
 
 
+// This releases the bus lock held by a sensor, if any
+void VariableArray::releaseBus(uint8_t sensorIndex) {
+    SensorListEntry& entry = _sensorList[sensorIndex];
+    if (entry.bus != NO_SENSOR_BUS &&
+        _buses[entry.bus].lockHolder == sensorIndex) {
+        _buses[entry.bus].lockHolder = BUS_UNLOCKED;
+    }
+}
+
+
+// This claims the single result collection allowed on a sensor's bus in each
+// pass.  Sensors that aren't on a shared bus can always collect results.
+bool VariableArray::claimBusTransaction(uint8_t sensorIndex) {
+    SensorListEntry& entry = _sensorList[sensorIndex];
+    if (entry.bus == NO_SENSOR_BUS) { return true; }
+    if (_buses[entry.bus].serviced) { return false; }
+    _buses[entry.bus].serviced = true;
+    return true;
+}
+
+
+#ifndef MS_VARIABLEARRAY_BUSY_WAIT
+// This returns the time until the soonest of the unfinished sensors is next
+// ready to be woken, have a measurement started, or have a result collected
+uint32_t VariableArray::getTimeUntilNextEvent(void) {
+    uint32_t nextEvent    = 0xFFFFFFFF;
+    bool     powerWaiting = false;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (_sensorList[s].nMeasurementsToAverage <=
+            _sensorList[s].nMeasurementsCompleted) {
+            continue;
+        }
+        // The sensor must be checked again when it runs out of time
+        uint32_t budgetLeft = getTimeLeftInBudget(s);
+        if (budgetLeft < nextEvent) { nextEvent = budgetLeft; }
+        if (_sensorList[s].waitingForPower) {
+            // Held off by the power budget; handled below
+            powerWaiting = true;
+            continue;
+        }
+        Sensor*  sensor = _sensorList[s].sensor;
+        uint32_t sensorNext;
+        if (sensor->getState() < SENSOR_WAKE_ATTEMPTED) {
+            // No attempt has been made to wake the sensor; waiting on warm-up
+            // or, if it can't probe the bus yet, on the sensor holding it
+            if (isProbeHeldOff(s)) { continue; }
+            sensorNext = sensor->getTimeUntilWarmedUp();
+        } else if (isMeasuring(s)) {
+            // A measurement was requested; waiting on the result
+            sensorNext = sensor->getTimeUntilMeasurementComplete();
+        } else if (sensor->getState() >= SENSOR_AWAKE) {
+            // The sensor is awake but not measuring; waiting on stabilization
+            // or, if another sensor holds the bus, on that sensor
+            if (isWaitingForBus(s)) { continue; }
+            sensorNext = sensor->getTimeUntilStable();
+        } else {
+            // Anything else can be handled immediately
+            return 0;
+        }
+        if (sensorNext < nextEvent) { nextEvent = sensorNext; }
+    }
+    // If sensors are waiting for power, the budget may open up as soon as
+    // the inrush ends on any powered sensor
+    if (powerWaiting) {
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            SensorListEntry& entry = _sensorList[s];
+            if (entry.waitingForPower || entry.poweredDown ||
+                !isPowerSwitched(s)) {
+                continue;
+            }
+            uint32_t elapsed = millis() - entry.millisPoweredUp;
+            uint32_t inrush  = entry.sensor->getInrushTime();
+            if (elapsed < inrush && inrush - elapsed < nextEvent) {
+                nextEvent = inrush - elapsed;
+            }
+        }
+    }
+    return nextEvent;
+}
+
+// This idles the processor for the given time, waking on every interrupt
+// (including the millis() timer tick) so that serial and pin-change interrupts
+// are still serviced.
+uint32_t VariableArray::idleFor(uint32_t wait_ms) {
+    if (wait_ms == 0) { return 0; }
+    MS_DEEP_DBG(F("Idling for"), wait_ms, F("ms until the next sensor event"));
+    uint32_t idleStart       = millis();
+    uint32_t idleStartMicros = micros();
+    while (millis() - idleStart < wait_ms) {
+#if defined ARDUINO_ARCH_SAMD
+        // Make sure we're only entering the "idle" sleep, which leaves the
+        // SysTick and all peripherals running
+        SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+        __DSB();
+        __WFI();
+#elif defined(ARDUINO_ARCH_AVR) || defined(__AVR__)
+        // Idle mode stops only the CPU clock; timers, UARTs, and pin change
+        // interrupts keep running and will wake the processor
+        set_sleep_mode(SLEEP_MODE_IDLE);
+        sleep_enable();
+        sleep_cpu();
+        sleep_disable();
+#endif
+    }
+    return micros() - idleStartMicros;
+}
+#endif
+
+
 // This function prints out the results for any connected sensors to a stream
 //  Calculated Variable results will be included
 void VariableArray::printSensorData(Stream* stream) {
@@ -873,6 +1209,10 @@ void VariableArray::printSensorData(Stream* stream) {
             stream->print(arrayOfVars[i]->getValueString());
             stream->print(F(" "));
             stream->print(arrayOfVars[i]->getVarUnit());
+            if (arrayOfVars[i]->isStale()) { stream->print(F(" (stale)")); }
+            if (arrayOfVars[i]->parentSensor->hasTimedOut()) {
+                stream->print(F(" (timed out)"));
+            }
             stream->println();
         }
     }
@@ -886,18 +1226,273 @@ bool VariableArray::isLastVarFromSensor(int arrayIndex) {
     if (arrayOfVars[arrayIndex]->isCalculated) {
         return false;
     } else {
-        String sensNameLoc =
-            arrayOfVars[arrayIndex]->getParentSensorNameAndLocation();
-        bool unique = true;
+        Sensor* parent = arrayOfVars[arrayIndex]->parentSensor;
         for (int j = arrayIndex + 1; j < _variableCount; j++) {
-            if (sensNameLoc ==
-                arrayOfVars[j]->getParentSensorNameAndLocation()) {
-                unique = false;
+            if (!arrayOfVars[j]->isCalculated &&
+                arrayOfVars[j]->parentSensor == parent) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+
+// Build the table of unique sensors
+// The sensors are listed in the order of the last variable from each sensor
+// in the variable array, the same order the sensors have always been
+// processed in.
+void VariableArray::buildSensorList(void) {
+    freeSensorList();
+    _sensorCount = getSensorCount();
+    // Allocate at least one entry so the list is never null once built
+    uint8_t listSize = _sensorCount > 0 ? _sensorCount : 1;
+    if (listSize <= _storageCapacity) {
+        _sensorList = _sensorStorage;
+        _powerRails = _railStorage;
+        _buses      = _busStorage;
+    } else {
+        if (_storageCapacity > 0) {
+            MS_DBG(F("The fixed storage holds only"), _storageCapacity,
+                   F("sensors; allocating the list for"), listSize);
+        }
+        _sensorList = new SensorListEntry[listSize];
+        // Each sensor can be on at most two rails and one bus
+        _powerRails = new PowerRail[listSize * 2];
+        _buses      = new SensorBus[listSize];
+    }
+    _powerRailCount = 0;
+    _busCount       = 0;
+
+    uint8_t s = 0;
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        if (!isLastVarFromSensor(i)) continue;
+        SensorListEntry& entry = _sensorList[s];
+        entry.sensor           = arrayOfVars[i]->parentSensor;
+        entry.lastVarIndex     = i;
+        entry.firstVarIndex    = i;
+        for (uint8_t j = 0; j < i; j++) {
+            if (!arrayOfVars[j]->isCalculated &&
+                arrayOfVars[j]->parentSensor == entry.sensor) {
+                entry.firstVarIndex = j;
                 break;
             }
         }
-        return unique;
+        // Attach the sensor to the rails for its primary and secondary power
+        int8_t powerPin          = entry.sensor->getPowerPin();
+        int8_t powerPin2         = entry.sensor->getSecondaryPowerPin();
+        entry.powerRail          = attachPowerRail(powerPin);
+        entry.secondaryPowerRail = NO_POWER_RAIL;
+        if (powerPin2 != powerPin) {
+            entry.secondaryPowerRail = attachPowerRail(powerPin2);
+        }
+        entry.poweredDown     = false;
+        entry.waitingForPower = false;
+        entry.millisPoweredUp = 0;
+        // Attach the sensor to its communication bus
+        entry.bus = attachSensorBus(entry.sensor);
+        MS_DBG(F("Sensor"), s, '-', entry.sensor->getSensorNameAndLocation(),
+               F("- variables"), entry.firstVarIndex, F("to"),
+               entry.lastVarIndex, F("- power pins"), powerPin, F("and"),
+               powerPin2, F("- bus"), entry.bus);
+        s++;
+    }
+
+    // Powering any rail powers every sensor on it, so sensors linked by shared
+    // rails form a group that must be powered together.  Each group is
+    // labeled with the index of its first sensor.
+    for (s = 0; s < _sensorCount; s++) {
+        _sensorList[s].powerGroup = s;
+        for (uint8_t k = 0; k < s; k++) {
+            if (!sharePowerRail(s, k)) { continue; }
+            uint8_t oldGroup = max(_sensorList[s].powerGroup,
+                                   _sensorList[k].powerGroup);
+            uint8_t newGroup = min(_sensorList[s].powerGroup,
+                                   _sensorList[k].powerGroup);
+            for (uint8_t j = 0; j <= s; j++) {
+                if (_sensorList[j].powerGroup == oldGroup) {
+                    _sensorList[j].powerGroup = newGroup;
+                }
+            }
+        }
+    }
+    resetSensorList();
+}
+
+
+// Reset the per-update counters in the sensor list
+void VariableArray::resetSensorList(void) {
+    _maxSamplestoAverage = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        // Adaptive averaging cuts the entry's count short when it stops a
+        // sensor early, so it is always read back from the sensor
+        entry.nMeasurementsToAverage =
+            entry.sensor->getNumberMeasurementsToAverage();
+        entry.nMeasurementsCompleted = 0;
+        entry.measurementStarted     = false;
+        entry.finished               = false;
+        entry.skipped                = false;
+        entry.millisPoweredUp        = 0;
+        _maxSamplestoAverage         = max(_maxSamplestoAverage,
+                                           entry.nMeasurementsToAverage);
+    }
+    for (uint8_t b = 0; b < _busCount; b++) {
+        _buses[b].lockHolder = BUS_UNLOCKED;
+        _buses[b].serviced   = false;
+    }
+}
+
+
+// This returns the time left before a sensor runs out of either its own time
+// budget or the array's
+uint32_t VariableArray::getTimeLeftInBudget(uint8_t sensorIndex) {
+    SensorListEntry& entry    = _sensorList[sensorIndex];
+    uint32_t         timeLeft = 0xFFFFFFFF;
+    if (_timeBudget_ms > 0) {
+        uint32_t elapsed = millis() - _millisUpdateStarted;
+        if (elapsed >= _timeBudget_ms) { return 0; }
+        timeLeft = _timeBudget_ms - elapsed;
+    }
+    // A sensor's own budget starts once it has power
+    uint32_t sensorBudget = entry.sensor->getTimeBudget();
+    if (sensorBudget > 0 && !entry.waitingForPower) {
+        uint32_t started = entry.millisPoweredUp > 0 ? entry.millisPoweredUp
+                                                     : _millisUpdateStarted;
+        uint32_t elapsed = millis() - started;
+        if (elapsed >= sensorBudget) { return 0; }
+        if (sensorBudget - elapsed < timeLeft) {
+            timeLeft = sensorBudget - elapsed;
+        }
+    }
+    return timeLeft;
+}
+
+
+// Abandon any unfinished sensors that have run out of time, so one hung sensor
+// can't hold up the whole update
+void VariableArray::checkTimeBudgets(void) {
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        SensorListEntry& entry = _sensorList[s];
+        if (entry.nMeasurementsCompleted >= entry.nMeasurementsToAverage ||
+            getTimeLeftInBudget(s) > 0) {
+            continue;
+        }
+        MS_DBG(s, F("--->>"), entry.sensor->getSensorNameAndLocation(),
+               F("ran out of time after"), entry.nMeasurementsCompleted,
+               F("measurements! <<---"), s);
+        entry.sensor->markTimedOut();
+        // Mark all of its measurements as done; the end of the pass will
+        // finish it off like any other sensor
+        entry.nMeasurementsCompleted = entry.nMeasurementsToAverage;
+        entry.measurementStarted     = false;
+        entry.waitingForPower        = false;
+        releaseBus(s);
+        _lastUpdateTimeouts++;
+    }
+}
+
+
+// Stop averaging a sensor once the standard error of every variable from it
+// with a tolerance is within that tolerance
+void VariableArray::checkEarlyStop(uint8_t sensorIndex) {
+    SensorListEntry& entry       = _sensorList[sensorIndex];
+    Sensor*          sensor      = entry.sensor;
+    uint8_t          minReadings = sensor->getMinMeasurementsToAverage();
+    if (minReadings == 0 || entry.nMeasurementsCompleted < minReadings ||
+        entry.nMeasurementsCompleted >= entry.nMeasurementsToAverage) {
+        return;
+    }
+
+    bool hasTolerance = false;
+    for (uint8_t i = entry.firstVarIndex; i <= entry.lastVarIndex; i++) {
+        Variable* var = arrayOfVars[i];
+        if (var->isCalculated || var->parentSensor != sensor ||
+            var->getStandardErrorTolerance() <= 0) {
+            continue;
+        }
+        hasTolerance = true;
+
+        // Without two good readings, there's no telling if it's settled
+        uint8_t num    = var->getSensorVarNum();
+        float   count  = sensor->getResultStatistic(num, RESULT_COUNT);
+        float   stdDev = sensor->getResultStatistic(num,
+                                                    RESULT_STANDARD_DEVIATION);
+        if (count < 2 || stdDev == -9999) { return; }
+        float stdError = stdDev / sqrt(count);
+        if (stdError > var->getStandardErrorTolerance()) {
+            MS_DEEP_DBG(var->getVarCode(), F("standard error"), stdError,
+                        F("is not yet within"),
+                        var->getStandardErrorTolerance());
+            return;
+        }
+    }
+    if (!hasTolerance) { return; }
+
+    MS_DBG(sensorIndex, F("--->>"), sensor->getSensorNameAndLocation(),
+           F("settled after"), entry.nMeasurementsCompleted, F("of"),
+           entry.nMeasurementsToAverage, F("readings. <<---"), sensorIndex);
+    entry.nMeasurementsToAverage = entry.nMeasurementsCompleted;
+}
+
+
+// Find or create the power rail for a pin and add a sensor to it
+uint8_t VariableArray::attachPowerRail(int8_t powerPin) {
+    // Power that isn't switched by the mcu isn't a rail
+    if (powerPin < 0) { return NO_POWER_RAIL; }
+    uint8_t r = 0;
+    while (r < _powerRailCount && _powerRails[r].getPowerPin() != powerPin) {
+        r++;
+    }
+    if (r == _powerRailCount) {
+        _powerRails[r] = PowerRail(powerPin);
+        _powerRailCount++;
+    }
+    _powerRails[r].attachSensor();
+    return r;
+}
+
+
+// This frees the sensor list, power rails, and buses if they were allocated
+void VariableArray::freeSensorList(void) {
+    if (_sensorList != _sensorStorage) { delete[] _sensorList; }
+    if (_powerRails != _railStorage) { delete[] _powerRails; }
+    if (_buses != _busStorage) { delete[] _buses; }
+    _sensorList = nullptr;
+    _powerRails = nullptr;
+    _buses      = nullptr;
+}
+
+
+// This sets up storage fixed at compile time for the sensor list
+void VariableArray::useFixedStorage(SensorListEntry* sensorStorage,
+                                    PowerRail*       railStorage,
+                                    SensorBus* busStorage, uint8_t capacity) {
+    freeSensorList();
+    _sensorStorage   = sensorStorage;
+    _railStorage     = railStorage;
+    _busStorage      = busStorage;
+    _storageCapacity = capacity;
+}
+
+
+// Find or create the entry for a sensor's communication bus
+uint8_t VariableArray::attachSensorBus(Sensor* sensor) {
+    sensorBusType busType = sensor->getBusType();
+    // Sensors that aren't on a shared bus never wait on one
+    if (busType == NO_BUS) { return NO_SENSOR_BUS; }
+    uintptr_t busId = sensor->getBusId();
+    uint8_t   b     = 0;
+    while (b < _busCount &&
+           (_buses[b].busType != busType || _buses[b].busId != busId)) {
+        b++;
+    }
+    if (b == _busCount) {
+        _buses[b].busType = busType;
+        _buses[b].busId   = busId;
+        _busCount++;
     }
+    return b;
 }
 
 
@@ -31,6 +31,21 @@
 #undef MS_DEBUGGING_DEEP
 #include "VariableBase.h"
 #include "SensorBase.h"
+#include "PowerRail.h"
+
+/**
+ * @brief The power rail index used for a sensor whose power is not switched by
+ * the mcu.
+ */
+#define NO_POWER_RAIL 255
+/**
+ * @brief The bus index used for a sensor that is not on a shared bus.
+ */
+#define NO_SENSOR_BUS 255
+/**
+ * @brief The lock holder value for a bus not locked by any sensor.
+ */
+#define BUS_UNLOCKED 255
 
 
 /**
@@ -65,6 +80,63 @@
  * When creating a logger, the order of variables in the array determines the
  * order the values will be written to the data file.
  *
+ * While waiting for sensors to warm up, stabilize, or finish a measurement, the
+ * variable array calculates when the next sensor will be ready and idles the
+ * processor until that time rather than continuously polling every sensor.
+ * The processor idle mode leaves all timers and communication peripherals
+ * running.
+ *
+ * Sensors on different communication buses measure at the same time.  In each
+ * pass through the sensors, every measurement that is ready to start is
+ * started before any results are collected, and at most one result is
+ * collected from each shared bus.  A sensor that needs its bus to itself while
+ * measuring (see Sensor::needsExclusiveBus()) holds a lock on the bus that
+ * queues the other sensors on that bus until its result is collected.
+ *
+ * Switching many sensors on at once can brown out a logger on a weak supply.
+ * If a power budget is set (see setPowerBudget()), completeUpdate() staggers
+ * powering the sensors so that their combined current, from the figures given
+ * to Sensor::setPowerDraw(), stays within the budget.  Sensors are counted at
+ * their peak current until their inrush has passed and at their steady
+ * current after that.  The sensors with the longest warm-up are powered
+ * first, and all sensors sharing a power pin are powered together.
+ *
+ * Sensors using adaptive averaging (see Sensor::setAdaptiveAveraging()) stop
+ * taking measurements as soon as the standard error of each of their variables
+ * with a tolerance is within it, instead of always taking the full number of
+ * measurements to average.
+ *
+ * While a sensor is learning its stabilization time (see
+ * Sensor::setStabilizationLearning()), its first readings after waking are
+ * probes that only check whether it has stabilized; they are not averaged.
+ *
+ * A sensor that hangs - a modbus sensor with a broken cable or an SDI-12
+ * sensor that never returns its data - can't hold up an update that has a
+ * time budget (see setTimeBudget() and Sensor::setTimeBudget()).  A sensor
+ * that runs out of time is abandoned with -9999 results and flagged (see
+ * Sensor::hasTimedOut()), and the update moves on.
+ *
+ * Sensors that keep failing can be backed off (see
+ * Sensor::setFailureBackoff()): after each update with no good results, the
+ * sensor is skipped for a doubling number of intervals, just as if its
+ * measurement cadence had skipped them.
+ *
+ * Sensors probed for readiness during warm-up (see
+ * Sensor::setReadinessProbing()) are woken as soon as they answer.  A sensor
+ * does not probe its bus while another sensor has the bus locked.
+ *
+ * Each call to completeUpdate() is counted as one interval.  Sensors that only
+ * need to be measured every few intervals (see Sensor::setMeasurementCadence())
+ * are skipped entirely in the other intervals - they are not powered, woken,
+ * or measured, and their variables keep their last values, marked stale.
+ * Sensors sharing a power pin with a sensor that is due are still not woken or
+ * measured.
+ *
+ * @section variable_array_flags Build flags
+ * - `-D MS_VARIABLEARRAY_BUSY_WAIT`
+ *    - Disables idling and returns to continuously polling the sensors while
+ * waiting.
+ *
  * @ingroup base_classes
  *
  */
@@ -95,7 +167,26 @@ class VariableArray {
     VariableArray(uint8_t variableCount, Variable* variableList[],
                   const char* uuids[]);
     /**
-     * @brief Destroy the Variable Array object - no action taken.
+     * @brief Dis-allowed constructor for a new VariableArray object from a
+     * copy of another - the deleted copy constructor.
+     *
+     * The copy constructor is explicitly deleted.  A variable array owns the
+     * sensor list built by begin(), so a copy would free it a second time.
+     *
+     * @param copy_from_me The VariableArray object to copy.
+     */
+    VariableArray(const VariableArray& copy_from_me) = delete;
+    /**
+     * @brief Dis-allowed assignment of one VariableArray object to another -
+     * the deleted assignment operator.
+     *
+     * The assignment operator is explicitly deleted for the same reason as
+     * the copy constructor.
+     */
+    VariableArray& operator=(const VariableArray& copy_from_me) = delete;
+    /**
+     * @brief Destroy the Variable Array object and free the list of unique
+     * sensors.
      */
     ~VariableArray();
 
@@ -107,8 +198,9 @@ class VariableArray {
     // actually have been created unless we wait until in the setup or loop
     // function of the main program.
     /**
-     * @brief Begins the VariableArray.  Suppiles a variable array, checks the
-     * validity of all UUID and outputs the results.
+     * @brief Begins the VariableArray.  Suppiles a variable array, builds the
+     * list of unique sensors, checks the validity of all UUID and outputs the
+     * results.
      *
      * @param variableCount The number of variables in the array.  Supercedes
      * any value given in the constructor.
@@ -119,7 +211,8 @@ class VariableArray {
     void begin(uint8_t variableCount, Variable* variableList[]);
     /**
      * @brief Begins the VariableArray.  Suppiles a variable array and UUIDs,
-     * checks the validity of all UUID and outputs the results.
+     * builds the list of unique sensors, checks the validity of all UUID and
+     * outputs the results.
      *
      * @param variableCount The number of variables in the array.  Supercedes
      * any value given in the constructor.
@@ -132,8 +225,8 @@ class VariableArray {
     void begin(uint8_t variableCount, Variable* variableList[],
                const char* uuids[]);
     /**
-     * @brief Begins the VariableArray.  Checks the validity of all UUID and
-     * outputs the results.
+     * @brief Begins the VariableArray.  Builds the list of unique sensors,
+     * checks the validity of all UUID and outputs the results.
      */
     void begin();
 
@@ -201,7 +294,9 @@ class VariableArray {
     /**
      * @brief Power up each sensor.
      *
-     * Runs the powerUp sensor function for each unique sensor.
+     * Runs the powerUp sensor function for each unique sensor.  All sensors
+     * are powered at once; the power budget is only applied within
+     * completeUpdate().
      */
     void sensorsPowerUp(void);
 
@@ -241,6 +336,34 @@ class VariableArray {
      */
     bool updateAllSensors(void);
 
+    /**
+     * @brief Update a list of sensors together, without a variable array.
+     *
+     * Every sensor that was off is powered first, so a sensor finishing early
+     * can't cut the power from a sensor on the same pin that is still
+     * measuring.  The non-blocking updates of all of the sensors (see
+     * Sensor::startUpdate()) are then run together, idling the processor
+     * between steps as completeUpdate() does.  A sensor that runs out of its
+     * own time budget (see Sensor::setTimeBudget()) or of the time budget
+     * given here is abandoned.  Once every sensor is done, the sensors that
+     * were off are powered down again.
+     *
+     * @note This is "blocking" - it does not return until every sensor has
+     * finished or been abandoned.
+     *
+     * @param sensors The sensors to update; at most 32.
+     * @param sensorCount The number of sensors in the list
+     * @param timeBudget_ms The longest the whole update may take, in ms.
+     * Optional with a default value of 0, meaning no limit.
+     * @param onPass A function to call on every pass through the sensors,
+     * such as one resetting the logger's watchdog.  Optional with a default
+     * value of nullptr.
+     * @return **bool** True if every sensor updated successfully.
+     */
+    static bool updateSensors(Sensor* sensors[], uint8_t sensorCount,
+                              uint32_t timeBudget_ms = 0,
+                              void (*onPass)() = nullptr);
+
     // This function powers, wakes, updates values, sleeps and powers down.
 
     /**
@@ -268,6 +391,165 @@ class VariableArray {
      */
     void printSensorData(Stream* stream = &Serial);
 
+    /**
+     * @brief Get the total elapsed time of the most recent call to
+     * updateAllSensors() or completeUpdate().
+     *
+     * @return **uint32_t** The wall-clock time of the last update, in ms.
+     */
+    uint32_t getLastUpdateTime(void) {
+        return _lastUpdateTime_ms;
+    }
+    /**
+     * @brief Get the time the processor spent awake (ie, not idling while
+     * waiting on sensors) during the most recent update.
+     *
+     * The awake time is measured in microseconds because a fast update can
+     * spend well under a millisecond of it awake.
+     *
+     * @return **uint32_t** The awake time of the last update, in µs.
+     */
+    uint32_t getLastUpdateAwakeTime(void) {
+        return _lastUpdateAwakeTime_us;
+    }
+    /**
+     * @brief Get the number of passes made through the sensor polling loop
+     * during the most recent update.
+     *
+     * This is a measure of how much work the processor did checking on sensors
+     * that were not yet ready.
+     *
+     * @return **uint32_t** The number of passes through the polling loop.
+     */
+    uint32_t getLastUpdatePasses(void) {
+        return _lastUpdatePasses;
+    }
+    /**
+     * @brief Get the number of sensors abandoned during the most recent update
+     * because they ran out of time.
+     *
+     * @return **uint8_t** The number of sensors that timed out.
+     */
+    uint8_t getLastUpdateTimeouts(void) {
+        return _lastUpdateTimeouts;
+    }
+
+    /**
+     * @brief Set the longest time a single call to updateAllSensors() or
+     * completeUpdate() may take.
+     *
+     * Once the time is up, every sensor still measuring is abandoned as if it
+     * had run out of its own time budget (see Sensor::setTimeBudget()).
+     *
+     * @note The budget is checked between calls to the sensors, so an update
+     * can still overrun it by as long as the slowest single sensor command.
+     *
+     * @param maxTime_ms The time budget, in ms.  0 (the default) means no
+     * limit.
+     */
+    void setTimeBudget(uint32_t maxTime_ms) {
+        _timeBudget_ms = maxTime_ms;
+    }
+    /**
+     * @brief Get the longest time a single update may take.
+     *
+     * @return **uint32_t** The time budget, in ms; 0 if there is no limit.
+     */
+    uint32_t getTimeBudget(void) {
+        return _timeBudget_ms;
+    }
+
+    /**
+     * @brief Get the number of switched power rails used by the sensors in the
+     * array.
+     *
+     * @return **uint8_t** The number of power rails
+     */
+    uint8_t getPowerRailCount(void) {
+        return _powerRailCount;
+    }
+    /**
+     * @brief Get one of the power rails used by the sensors in the array.
+     *
+     * Use this to check how long each rail was on during the last update.
+     *
+     * @param railNumber The index of the rail, from 0 to
+     * getPowerRailCount() - 1.
+     * @return **PowerRail*** A pointer to the power rail
+     */
+    PowerRail* getPowerRail(uint8_t railNumber) {
+        return &_powerRails[railNumber];
+    }
+
+    /**
+     * @brief Set the maximum current the sensors may draw at once while they
+     * are powered up during completeUpdate().
+     *
+     * A single group of sensors that alone needs more than the budget is still
+     * powered, but only once nothing else is drawing current.
+     *
+     * @param maxCurrent_mA The power budget, in mA.  0 (the default) means no
+     * limit; all sensors are powered at once.
+     */
+    void setPowerBudget(uint16_t maxCurrent_mA) {
+        _powerBudget_mA = maxCurrent_mA;
+    }
+    /**
+     * @brief Get the maximum current the sensors may draw at once.
+     *
+     * @return **uint16_t** The power budget, in mA; 0 if there is no limit.
+     */
+    uint16_t getPowerBudget(void) {
+        return _powerBudget_mA;
+    }
+    /**
+     * @brief Set a current drawn from the same supply by something other than
+     * the sensors, such as a modem that is awake during the update.
+     *
+     * The reserved current is counted against the power budget while the
+     * sensors are powered, so less of the budget is left for them.  A single
+     * group of sensors is still powered once no other sensor is drawing
+     * current, even if it and the reserved current are over the budget.
+     *
+     * @param current_mA The reserved current, in mA; 0 (the default) to
+     * reserve nothing.
+     */
+    void setReservedCurrent(uint16_t current_mA) {
+        _reservedCurrent_mA = current_mA;
+    }
+    /**
+     * @brief Get the current reserved out of the power budget.
+     *
+     * @return **uint16_t** The reserved current, in mA.
+     */
+    uint16_t getReservedCurrent(void) {
+        return _reservedCurrent_mA;
+    }
+
+    /**
+     * @brief Set the number of the interval the next completeUpdate() is in.
+     *
+     * Each sensor's measurement cadence is checked against this number.  A
+     * logger sets it from its marked time and logging interval before each
+     * update, so the cadence stays in step with the clock across resets and
+     * missed intervals.  Without a logger, the array counts its complete
+     * updates from 0.
+     *
+     * @param interval The number of the interval
+     */
+    void setIntervalNumber(uint32_t interval) {
+        _intervalNumber = interval;
+    }
+    /**
+     * @brief Get the number of the interval the next completeUpdate() is in.
+     *
+     * @return **uint32_t** The number of the interval checked against each
+     * sensor's measurement cadence.
+     */
+    uint32_t getIntervalNumber(void) {
+        return _intervalNumber;
+    }
+
  protected:
     /**
      * @brief The count of variables in the array
@@ -281,36 +563,476 @@ class VariableArray {
      * @brief The maximum number of samples to average of an single sensor.
      */
     uint8_t _maxSamplestoAverage;
+    /**
+     * @brief The wall-clock time of the most recent update, in ms.
+     */
+    uint32_t _lastUpdateTime_ms = 0;
+    /**
+     * @brief The time the processor was awake during the most recent update,
+     * in µs.
+     */
+    uint32_t _lastUpdateAwakeTime_us = 0;
+    /**
+     * @brief The number of passes through the polling loop during the most
+     * recent update.
+     */
+    uint32_t _lastUpdatePasses = 0;
+    /**
+     * @brief The number of sensors that ran out of time during the most recent
+     * update.
+     */
+    uint8_t _lastUpdateTimeouts = 0;
+    /**
+     * @brief The processor millis() at the start of the current or most
+     * recent update.
+     */
+    uint32_t _millisUpdateStarted = 0;
+    /**
+     * @brief The processor micros() at the start of the current or most
+     * recent update.
+     */
+    uint32_t _microsUpdateStarted = 0;
+    /**
+     * @brief The longest time a single update may take, in ms; 0 for no
+     * limit.
+     */
+    uint32_t _timeBudget_ms = 0;
+    /**
+     * @brief The maximum current the sensors may draw at once while being
+     * powered up, in mA; 0 for no limit.
+     */
+    uint16_t _powerBudget_mA = 0;
+    /**
+     * @brief The current drawn from the supply by something other than the
+     * sensors, in mA.
+     */
+    uint16_t _reservedCurrent_mA = 0;
+    /**
+     * @brief The number of the interval of the next complete update, used to
+     * decide which sensors are due to be measured.
+     */
+    uint32_t _intervalNumber = 0;
+
+    /**
+     * @brief An entry in the list of unique sensors attached to the variables
+     * in the array.
+     *
+     * The sensor, variable and power rail information is filled in once when
+     * the list is built; the measurement counts are reset at the start of
+     * every update.
+     */
+    struct SensorListEntry {
+        /**
+         * @brief Pointer to the sensor
+         */
+        Sensor* sensor;
+        /**
+         * @brief The array index of the first variable from the sensor
+         */
+        uint8_t firstVarIndex;
+        /**
+         * @brief The array index of the last variable from the sensor
+         */
+        uint8_t lastVarIndex;
+        /**
+         * @brief The index of the power rail for the sensor's power pin, or
+         * #NO_POWER_RAIL if its power is not switched
+         */
+        uint8_t powerRail;
+        /**
+         * @brief The index of the power rail for the sensor's secondary power
+         * pin, or #NO_POWER_RAIL if it doesn't have one
+         */
+        uint8_t secondaryPowerRail;
+        /**
+         * @brief The number of measurements to average from the sensor
+         */
+        uint8_t nMeasurementsToAverage;
+        /**
+         * @brief The number of measurements completed in the current update
+         */
+        uint8_t nMeasurementsCompleted;
+        /**
+         * @brief True once the sensor has been powered down
+         */
+        bool poweredDown;
+        /**
+         * @brief The list index of the first sensor in the group of sensors
+         * linked by shared power rails; the whole group is powered together
+         */
+        uint8_t powerGroup;
+        /**
+         * @brief True while the sensor is being held off to stay within the
+         * power budget
+         */
+        bool waitingForPower;
+        /**
+         * @brief The processor millis() when the sensor was powered
+         */
+        uint32_t millisPoweredUp;
+        /**
+         * @brief The index of the sensor's communication bus, or
+         * #NO_SENSOR_BUS if it is not on a shared bus
+         */
+        uint8_t bus;
+        /**
+         * @brief True from when a measurement is started until its result is
+         * collected
+         */
+        bool measurementStarted;
+        /**
+         * @brief True once all measurements from the sensor are complete in
+         * the current update
+         */
+        bool finished;
+        /**
+         * @brief True if the sensor is not due to be measured in the current
+         * update
+         */
+        bool skipped;
+    };
+    /**
+     * @brief A communication bus shared by one or more sensors in the array.
+     *
+     * Only one result is collected from each bus in each pass through the
+     * sensors, so a run of slow reads on one bus can't hold up the others.  A
+     * sensor that needs the bus to itself while measuring locks it from when
+     * its measurement is started until its result is collected.
+     */
+    struct SensorBus {
+        /**
+         * @brief The type of bus
+         */
+        sensorBusType busType;
+        /**
+         * @brief The identifier of the bus - a pin number or a pointer
+         */
+        uintptr_t busId;
+        /**
+         * @brief The list index of the sensor holding the bus lock, or
+         * #BUS_UNLOCKED
+         */
+        uint8_t lockHolder;
+        /**
+         * @brief True once a result has been collected from a sensor on this
+         * bus in the current pass
+         */
+        bool serviced;
+    };
+    /**
+     * @brief The list of unique sensors attached to the variables in the
+     * array, in the order they are processed.
+     *
+     * This is built by begin(), or on first use if begin() was not called.
+     */
+    SensorListEntry* _sensorList = nullptr;
+    /**
+     * @brief The power rails used by the sensors in the array, built with the
+     * sensor list.
+     */
+    PowerRail* _powerRails = nullptr;
+    /**
+     * @brief The number of power rails used by the sensors in the array.
+     */
+    uint8_t _powerRailCount = 0;
+    /**
+     * @brief The communication buses shared by the sensors in the array,
+     * built with the sensor list.
+     */
+    SensorBus* _buses = nullptr;
+    /**
+     * @brief The number of communication buses in use by the sensors in the
+     * array.
+     */
+    uint8_t _busCount = 0;
+
+    /**
+     * @brief Use storage fixed at compile time for the sensor list, power
+     * rails, and buses instead of allocating them when the list is built.
+     *
+     * @param sensorStorage Storage for capacity sensor list entries
+     * @param railStorage Storage for 2 * capacity power rails
+     * @param busStorage Storage for capacity buses
+     * @param capacity The number of sensors the storage can hold
+     */
+    void useFixedStorage(SensorListEntry* sensorStorage, PowerRail* railStorage,
+                         SensorBus* busStorage, uint8_t capacity);
 
  private:
     bool    isLastVarFromSensor(int arrayIndex);
     uint8_t countMaxToAverage(void);
     bool    checkVariableUUIDs(void);
-
-#ifdef MS_VARIABLEARRAY_DEBUG_DEEP
     /**
-     * @brief Prints out the contents of an array with even spaces and commas
-     * between the members
+     * @brief Build the list of unique sensors attached to the variables in
+     * the array.
+     */
+    void buildSensorList(void);
+    /**
+     * @brief Reset the measurement counts in the sensor list at the start of
+     * an update.
+     */
+    void resetSensorList(void);
+    /**
+     * @brief Check if a sensor using adaptive averaging has settled and, if
+     * so, cut short the measurements still to be taken.
      *
-     * @tparam T Any printable type
-     * @param arrayToPrint The array of values to print.
+     * @param sensorIndex The index of the sensor in the sensor list
      */
-    template <typename T>
-    void prettyPrintArray(T arrayToPrint[]) {
-        DEEP_DEBUGGING_SERIAL_OUTPUT.print("[,\t");
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            DEEP_DEBUGGING_SERIAL_OUTPUT.print(arrayToPrint[i]);
-            DEEP_DEBUGGING_SERIAL_OUTPUT.print(",\t");
-        }
-        DEEP_DEBUGGING_SERIAL_OUTPUT.println("]");
-    }
-#else
+    void checkEarlyStop(uint8_t sensorIndex);
+    /**
+     * @brief Get the time left before a sensor runs out of either its own
+     * time budget or the array's.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **uint32_t** The time left, in ms; 0xFFFFFFFF if there is no
+     * budget.
+     */
+    uint32_t getTimeLeftInBudget(uint8_t sensorIndex);
+    /**
+     * @brief Abandon every unfinished sensor that has run out of time.
+     */
+    void checkTimeBudgets(void);
+    /**
+     * @brief Find or create the power rail for a pin and attach another sensor
+     * to it.
+     *
+     * @param powerPin The power pin of the sensor
+     * @return **uint8_t** The index of the power rail, or #NO_POWER_RAIL if
+     * the pin is not a switched power pin.
+     */
+    uint8_t attachPowerRail(int8_t powerPin);
+    /**
+     * @brief Free the sensor list, power rails, and buses, unless they are in
+     * fixed storage.
+     */
+    void freeSensorList(void);
+    /**
+     * @brief Clear the cached values of all calculated variables and
+     * calculate each calculated variable in the array once, after the
+     * variables it depends on.
+     */
+    void calculateVariables(void);
+    /**
+     * @brief Release the power rails of a sensor that has finished all of its
+     * measurements and power down any finished sensors whose rails are now all
+     * idle.
+     *
+     * @param sensorIndex The index of the finished sensor in the sensor list
+     */
+    void releaseSensorPower(uint8_t sensorIndex);
+    /**
+     * @brief Power down a sensor and mark it as off on its power rails.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     */
+    void powerDownSensor(uint8_t sensorIndex);
+    /**
+     * @brief Check if two sensors share any power rail.
+     *
+     * @param first The index of one sensor in the sensor list
+     * @param second The index of the other sensor in the sensor list
+     * @return **bool** True if powering one sensor also powers the other.
+     */
+    bool sharePowerRail(uint8_t first, uint8_t second);
+    /**
+     * @brief Check if the mcu switches the power to a sensor.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if the sensor is on at least one power rail.
+     */
+    bool isPowerSwitched(uint8_t sensorIndex);
+    /**
+     * @brief Get the current being drawn by the sensors that are powered,
+     * from the figures given to Sensor::setPowerDraw().
+     *
+     * @return **uint32_t** The current drawn, in mA.
+     */
+    uint32_t getCurrentLoad(void);
+    /**
+     * @brief Power up the waiting groups of sensors, longest warm-up first,
+     * for as long as the next group fits in the power budget.
+     */
+    void powerUpWithinBudget(void);
+    /**
+     * @brief Check if every sensor in a power group is skipped in the current
+     * update.
+     *
+     * @param group The power group (the list index of its first sensor)
+     * @return **bool** True if no sensor in the group is due to be measured.
+     */
+    bool isPowerGroupSkipped(uint8_t group);
+    /**
+     * @brief Power up every sensor in a power group and the group's rails.
+     *
+     * @param group The power group (the list index of its first sensor)
+     */
+    void powerUpGroup(uint8_t group);
+    /**
+     * @brief Find or create the entry for a sensor's communication bus.
+     *
+     * @param sensor The sensor to attach
+     * @return **uint8_t** The index of the bus, or #NO_SENSOR_BUS if the
+     * sensor isn't on a shared bus.
+     */
+    uint8_t attachSensorBus(Sensor* sensor);
+    /**
+     * @brief Reset the record of which buses have been used in a pass.
+     */
+    void startBusPass(void);
+    /**
+     * @brief Check if a sensor has a measurement started that hasn't yet been
+     * collected.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if the sensor is measuring.
+     */
+    bool isMeasuring(uint8_t sensorIndex);
+    /**
+     * @brief Check if another sensor has locked a sensor's bus.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if another sensor holds the bus lock.
+     */
+    bool isBusLockedByOther(uint8_t sensorIndex);
+    /**
+     * @brief Check if a sensor needs its bus to itself but another sensor has
+     * it locked.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if the sensor must wait for the bus.
+     */
+    bool isWaitingForBus(uint8_t sensorIndex);
+    /**
+     * @brief Check if a sensor probing for readiness must wait because
+     * another sensor has locked its bus.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if the sensor can't be checked for warm-up yet.
+     */
+    bool isProbeHeldOff(uint8_t sensorIndex);
+    /**
+     * @brief Lock a sensor's bus before it starts a measurement, if the
+     * sensor needs the bus to itself.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if the sensor can start a measurement.
+     */
+    bool acquireBus(uint8_t sensorIndex);
+    /**
+     * @brief Release any bus lock held by a sensor.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     */
+    void releaseBus(uint8_t sensorIndex);
+    /**
+     * @brief Claim the one result collection allowed on a sensor's bus in
+     * each pass.
+     *
+     * @param sensorIndex The index of the sensor in the sensor list
+     * @return **bool** True if the sensor can collect its result now.
+     */
+    bool claimBusTransaction(uint8_t sensorIndex);
+#ifndef MS_VARIABLEARRAY_BUSY_WAIT
+    /**
+     * @brief Get the time until the next unfinished sensor is ready for an
+     * action from the variable array - to be woken, to start a measurement, or
+     * to report a result.
+     *
+     * @return **uint32_t** The time until the next sensor is ready, in ms.
+     */
+    uint32_t getTimeUntilNextEvent(void);
+    /**
+     * @brief Idle the processor for the given time.
+     *
+     * @param wait_ms The time to idle, in ms.
+     * @return **uint32_t** The time actually spent idling, in µs.
+     */
+    static uint32_t idleFor(uint32_t wait_ms);
+#endif
+
+    /**
+     * @brief Fixed storage for the sensor list, if any.
+     */
+    SensorListEntry* _sensorStorage = nullptr;
+    /**
+     * @brief Fixed storage for the power rails, if any.
+     */
+    PowerRail* _railStorage = nullptr;
+    /**
+     * @brief Fixed storage for the buses, if any.
+     */
+    SensorBus* _busStorage = nullptr;
+    /**
+     * @brief The number of sensors the fixed storage can hold; 0 if there is
+     * none.
+     */
+    uint8_t _storageCapacity = 0;
+};
+
+
 /**
- * @brief Prints out the contents of an array with even spaces and commas
- * between the members
+ * @brief A variable array with the storage for its sensor list sized at
+ * compile time.
+ *
+ * A plain VariableArray allocates its list of unique sensors, power rails and
+ * buses from the heap when it is begun.  This keeps them in the object
+ * instead, so the memory they use is known when the program is compiled and
+ * the heap is never touched.  Create it with the number of variables and,
+ * since most sensors report several variables, the number of sensors:
+ * @code{cpp}
+ * Variable* variableList[] = {...};
+ * VariableArrayN<12, 4> varArray;
+ * ...
+ * varArray.begin(12, variableList);
+ * @endcode
+ *
+ * If the array is begun with more sensors than the storage holds, the list is
+ * allocated from the heap as for a plain VariableArray.
+ *
+ * @tparam NumVariables The number of variables in the array.
+ * @tparam NumSensors The most sensors the storage holds.  Optional; the
+ * default of one sensor for each variable always fits, but wastes the room of
+ * a sensor list entry, two power rails, and a bus for every variable beyond
+ * the first from each sensor.
+ *
+ * @ingroup base_classes
  */
-#define prettyPrintArray(...)
-#endif  // DEEP_DEBUGGING_SERIAL_OUTPUT
+template <uint8_t NumVariables, uint8_t NumSensors = NumVariables>
+class VariableArrayN : public VariableArray {
+ public:
+    /**
+     * @brief Construct a new Variable Array object using its own storage.
+     */
+    VariableArrayN() : VariableArray() {
+        useFixedStorage(_sensorEntries, _rails, _sensorBuses, NumSensors);
+    }
+    /**
+     * @brief Construct a new Variable Array object using its own storage.
+     *
+     * @param variableList An array of NumVariables pointers to variable
+     * objects.
+     */
+    explicit VariableArrayN(Variable* variableList[])
+        : VariableArray(NumVariables, variableList) {
+        useFixedStorage(_sensorEntries, _rails, _sensorBuses, NumSensors);
+    }
+    /**
+     * @brief Construct a new Variable Array object using its own storage.
+     *
+     * @param variableList An array of NumVariables pointers to variable
+     * objects.
+     * @param uuids An array of UUID's.  These are linked 1-to-1 with the
+     * variables by array position.
+     */
+    VariableArrayN(Variable* variableList[], const char* uuids[])
+        : VariableArray(NumVariables, variableList, uuids) {
+        useFixedStorage(_sensorEntries, _rails, _sensorBuses, NumSensors);
+    }
+
+ private:
+    SensorListEntry _sensorEntries[NumSensors];
+    PowerRail       _rails[NumSensors * 2];
+    SensorBus       _sensorBuses[NumSensors];
 };
 
 #endif  // SRC_VARIABLEARRAY_H_
@@ -114,6 +114,7 @@ void Variable::attachSensor(Sensor* parentSense) {
     if (!isCalculated) {
         parentSensor = parentSense;
         parentSensor->registerVariable(_sensorVarNum, this);
+        parentSensor->keepStatistic(_statistic);
     }
 }
 
@@ -122,12 +123,49 @@ void Variable::attachSensor(Sensor* parentSense) {
 // This function should never be called for a calculated variable
 void Variable::onSensorUpdate(Sensor* parentSense) {
     if (!isCalculated) {
-        _currentValue = parentSense->sensorValues[_sensorVarNum];
+        _currentValue = parentSense->getResultStatistic(_sensorVarNum,
+                                                        _statistic);
+        _isStale      = false;
         MS_DBG(F("... received"), _currentValue);
     }
 }
 
 
+// These get and set the flag for a value left over from an earlier update
+bool Variable::isStale(void) {
+    return _isStale;
+}
+void Variable::markStale(void) {
+    if (!isCalculated) { _isStale = true; }
+}
+
+
+// These get and set the statistic of the sensor result the variable reports
+void Variable::setStatistic(resultStatistic statistic) {
+    _statistic = statistic;
+    // The sensor only keeps the statistics that are reported
+    if (parentSensor != nullptr) { parentSensor->keepStatistic(statistic); }
+}
+resultStatistic Variable::getStatistic(void) {
+    return _statistic;
+}
+
+
+// This returns the position of the variable's value in the sensor results
+uint8_t Variable::getSensorVarNum(void) {
+    return _sensorVarNum;
+}
+
+
+// These get and set the tolerance for an adaptive early stop
+void Variable::setStandardErrorTolerance(float tolerance) {
+    _standardErrorTolerance = tolerance;
+}
+float Variable::getStandardErrorTolerance(void) {
+    return _standardErrorTolerance;
+}
+
+
 // This is a helper - it returns the name of the parent sensor, if applicable
 // This is needed for dealing with variables in arrays
 String Variable::getParentSensorName(void) {
@@ -162,6 +200,56 @@ void Variable::setCalculation(float (*calcFxn)()) {
 }
 
 
+// These declare the variables a calculated variable depends on
+bool Variable::addDependency(Variable* dependency) {
+    if (!isCalculated || dependency == nullptr ||
+        _dependencyCount >= MS_MAX_VARIABLE_DEPENDENCIES) {
+        MS_DBG(F("Cannot add a dependency to"), getVarCode());
+        return false;
+    }
+    _dependencies[_dependencyCount++] = dependency;
+    return true;
+}
+uint8_t Variable::getDependencyCount(void) {
+    return _dependencyCount;
+}
+
+
+// The cached calculated values belong to one generation; starting a new one
+// clears all of them at once.  Generation 0 is skipped because it means
+// nothing is cached.
+uint16_t Variable::_generation = 0;
+
+void Variable::startNewGeneration(void) {
+    _generation++;
+    if (_generation == 0) { _generation = 1; }
+}
+
+
+// This calculates a value, once per generation, after the variables it
+// depends on
+float Variable::calculate(bool recalculate) {
+    if (!recalculate && _generation != 0 &&
+        _calculatedGeneration == _generation) {
+        return _currentValue;
+    }
+    if (_calculating) {
+        MS_DBG(F("ERROR! The calculation of"), getVarCode(),
+               F("depends on itself!"));
+        return _currentValue;
+    }
+    _calculating = true;
+    // Calculating the dependencies first caches them for the calculation
+    for (uint8_t i = 0; i < _dependencyCount; i++) {
+        _dependencies[i]->getValue();
+    }
+    _currentValue         = _calcFxn();
+    _calculatedGeneration = _generation;
+    _calculating          = false;
+    return _currentValue;
+}
+
+
 // This gets/sets the variable's resolution for value strings
 uint8_t Variable::getResolution(void) {
     return _decimalResolution;
@@ -242,7 +330,7 @@ float Variable::getValue(bool updateValue) {
         // the calculation because we don't know which sensors those are.
         // Make sure you update the parent sensors manually for a calculated
         // variable!!
-        return _calcFxn();
+        return calculate(updateValue);
     } else {
         if (updateValue) parentSensor->update();
         return _currentValue;
@@ -253,11 +341,14 @@ float Variable::getValue(bool updateValue) {
 // This returns the current value of the variable as a string
 // with the correct number of significant figures
 String Variable::getValueString(bool updateValue) {
+    return formatValue(getValue(updateValue));
+}
+String Variable::formatValue(float value) {
     // Need this because otherwise get extra spaces in strings from int
     if (_decimalResolution == 0) {
-        auto val = static_cast<int16_t>(getValue(updateValue));
+        auto val = static_cast<int16_t>(value);
         return String(val);
     } else {
-        return String(getValue(updateValue), _decimalResolution);
+        return String(value, _decimalResolution);
     }
 }
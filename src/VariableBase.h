@@ -20,12 +20,18 @@
 #define MS_DEBUGGING_STD "VariableBase"
 #endif
 
-// Forward Declared Dependences
-class Sensor;
-
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
+#include "SensorBase.h"
+
+#ifndef MS_MAX_VARIABLE_DEPENDENCIES
+/**
+ * @brief The largest number of other variables a calculated variable can
+ * declare it depends on.
+ */
+#define MS_MAX_VARIABLE_DEPENDENCIES 4
+#endif
 
 /**
  * @brief The variable class for a value and related metadata.
@@ -50,6 +56,14 @@ class Sensor;
  *
  * Variables are expected to be grouped together into VariableArrays.
  *
+ * A calculated value is cached once it has been calculated, so that writing a
+ * record to a file and to each publisher doesn't repeat the calculation.  The
+ * cache is cleared whenever any sensor reports new values, however it was
+ * updated, so a calculated value never outlives the values it came from.  At
+ * the end of each update, a variable array calculates every calculated
+ * variable in it once, after the variables it depends on (see
+ * addDependency()).
+ *
  * @ingroup base_classes
  */
 class Variable {
@@ -256,6 +270,39 @@ class Variable {
      * @param calcFxn Any function returning a float value.
      */
     void setCalculation(float (*calcFxn)());
+    /**
+     * @brief Declare that a calculated variable is calculated from another
+     * variable.
+     *
+     * The dependencies of a calculated variable are always calculated before
+     * it, and any calculated dependency is calculated only once per update no
+     * matter how many variables use it.  For example:
+     * @code{cpp}
+     * calcWaterDepth->addDependency(calcWaterPress);
+     * calcWaterPress->addDependency(ms5803Press);
+     * calcWaterPress->addDependency(bme280Press);
+     * @endcode
+     *
+     * @param dependency The variable used in the calculation.
+     * @return **bool** True if the dependency was added; false if this
+     * variable isn't calculated or already has #MS_MAX_VARIABLE_DEPENDENCIES
+     * dependencies.
+     */
+    bool addDependency(Variable* dependency);
+    /**
+     * @brief Get the number of variables a calculated variable depends on.
+     *
+     * @return **uint8_t** The number of declared dependencies.
+     */
+    uint8_t getDependencyCount(void);
+    /**
+     * @brief Clear the cached value of every calculated variable, so each is
+     * calculated again the next time its value is requested.
+     *
+     * Every sensor calls this when it notifies its variables of new values,
+     * and variable arrays call it again at the end of each update.
+     */
+    static void startNewGeneration(void);
 
     // This gets/sets the variable's resolution for value strings
     /**
@@ -342,7 +389,8 @@ class Variable {
      * @brief Get current value of the variable as a float
      *
      * @param updateValue True to ask the parent sensor to measure and return a
-     * new value.  Default is false.
+     * new value, or for a calculated variable to calculate it again rather
+     * than use the value cached since the last update.  Default is false.
      * @return **float** The current value of the variable
      */
     float getValue(bool updateValue = false);
@@ -355,6 +403,91 @@ class Variable {
      * @return **String** The current value of the variable
      */
     String getValueString(bool updateValue = false);
+    /**
+     * @brief Format any value as a string with the variable's decimal
+     * resolution.
+     *
+     * @param value The value to format
+     * @return **String** The formatted value
+     */
+    String formatValue(float value);
+
+    /**
+     * @brief Check whether the current value is left over from an earlier
+     * update.
+     *
+     * A variable array marks the variables of a sensor stale when the sensor
+     * is skipped because it is not due to be measured in the current interval
+     * (see Sensor::setMeasurementCadence()).  The variable keeps the last value
+     * received from the sensor.  The flag is cleared the next time the sensor
+     * reports a value.
+     *
+     * @return **bool** True if the value was not refreshed by the most recent
+     * update.
+     */
+    bool isStale(void);
+
+    /**
+     * @brief Set which statistic of the parent sensor's result the variable
+     * reports.
+     *
+     * By default a variable reports the mean of the measurements taken in an
+     * update.  A second variable on the same sensor and result can instead
+     * report the minimum, maximum, standard deviation, or number of good
+     * measurements, giving the spread of one burst of readings.  For example:
+     * @code{cpp}
+     * Variable* ds18TempSD = new Variable(&ds18, DS18_TEMP_VAR_NUM, 3,
+     *                                     "temperature", "degreeCelsius",
+     *                                     "DS18TempSD", "");
+     * ds18TempSD->setStatistic(RESULT_STANDARD_DEVIATION);
+     * @endcode
+     *
+     * @param statistic The statistic to report.
+     */
+    void setStatistic(resultStatistic statistic);
+    /**
+     * @brief Get which statistic of the parent sensor's result the variable
+     * reports.
+     *
+     * @return **resultStatistic** The statistic reported.
+     */
+    resultStatistic getStatistic(void);
+
+    /**
+     * @brief Get the position of the variable's value in the parent sensor's
+     * result array.
+     *
+     * @return **uint8_t** The position of the result
+     */
+    uint8_t getSensorVarNum(void);
+
+    /**
+     * @brief Set the standard error below which the variable is considered
+     * settled.
+     *
+     * A variable array stops taking measurements from a sensor using adaptive
+     * averaging (see Sensor::setAdaptiveAveraging()) once the standard error
+     * of the mean of every variable from it with a tolerance is within that
+     * tolerance.
+     *
+     * @param tolerance The largest acceptable standard error, in the units of
+     * the variable.  0 (the default) means the variable doesn't hold up an
+     * early stop.
+     */
+    void setStandardErrorTolerance(float tolerance);
+    /**
+     * @brief Get the standard error below which the variable is considered
+     * settled.
+     *
+     * @return **float** The tolerance; 0 if none is set.
+     */
+    float getStandardErrorTolerance(void);
+    /**
+     * @brief Mark the current value as left over from an earlier update.
+     *
+     * @note This should never be called for a calculated variable.
+     */
+    void markStale(void);
 
     /**
      * @brief Pointer to the parent sensor
@@ -364,6 +497,11 @@ class Variable {
      * @brief Internal note as to whether the value is calculated.
      */
     bool isCalculated = false;
+    /**
+     * @brief Pointer to the next variable receiving the same result from the
+     * parent sensor, if any.
+     */
+    Variable* nextResultVariable = nullptr;
 
  protected:
     /**
@@ -373,6 +511,53 @@ class Variable {
      * value of -9999 (ie, a bad result).
      */
     float _currentValue = -9999;
+    /**
+     * @brief True if the current value was not refreshed by the most recent
+     * update of the parent sensor.
+     */
+    bool _isStale = false;
+    /**
+     * @brief The statistic of the parent sensor's result that the variable
+     * reports.
+     */
+    resultStatistic _statistic = RESULT_MEAN;
+    /**
+     * @brief The largest acceptable standard error of the mean for an
+     * adaptive early stop; 0 for none.
+     */
+    float _standardErrorTolerance = 0;
+    /**
+     * @brief The variables a calculated variable is calculated from.
+     */
+    Variable* _dependencies[MS_MAX_VARIABLE_DEPENDENCIES];
+    /**
+     * @brief The number of declared dependencies.
+     */
+    uint8_t _dependencyCount = 0;
+    /**
+     * @brief True while the value is being calculated; used to catch circular
+     * dependencies.
+     */
+    bool _calculating = false;
+    /**
+     * @brief The generation in which the cached calculated value was
+     * calculated.
+     */
+    uint16_t _calculatedGeneration = 0;
+    /**
+     * @brief The current generation of calculated values.  0 until a sensor
+     * first reports values, meaning calculated values aren't cached.
+     */
+    static uint16_t _generation;
+
+    /**
+     * @brief Get the value of a calculated variable, calculating it and its
+     * dependencies if there is no value cached in the current generation.
+     *
+     * @param recalculate True to calculate the value even if it is cached.
+     * @return **float** The calculated value
+     */
+    float calculate(bool recalculate);
 
 
  private:
@@ -35,6 +35,15 @@ String AOSongAM2315::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType AOSongAM2315::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t AOSongAM2315::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+
+
 bool AOSongAM2315::setup(void) {
     _i2c->begin();  // Start the wire library (sensor power not required)
     // Eliminate any potential extra waits in the wire library
@@ -55,9 +64,9 @@ bool AOSongAM2315::addSingleMeasurementResult(void) {
     float humid_val = -9999;
     bool  ret_val   = false;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         ret_val = am2315ptr->readTemperatureAndHumidity(&temp_val, &humid_val);
@@ -76,8 +85,8 @@ bool AOSongAM2315::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return ret_val;
 }
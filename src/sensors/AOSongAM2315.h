@@ -209,6 +209,14 @@ class AOSongAM2315 : public Sensor {
      * @return **String** Text describing how the sensor is attached to the mcu.
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
 
     /**
      * @brief Do any one-time preparations needed before the sensor will be able
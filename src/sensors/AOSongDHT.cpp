@@ -48,9 +48,9 @@ bool AOSongDHT::addSingleMeasurementResult(void) {
     float temp_val  = -9999;
     float hi_val    = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         // Reading temperature or humidity takes about 250 milliseconds!
         // Make 5 attempts to get a decent reading
         for (uint8_t i = 0; i < 5; i++) {
@@ -92,8 +92,8 @@ bool AOSongDHT::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -87,7 +87,7 @@ float AnalogElecConductivity::readEC(uint8_t analogPinNum) {
 bool AnalogElecConductivity::addSingleMeasurementResult(void) {
     float sensorEC_uScm = -9999;
 
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         sensorEC_uScm = readEC(_EcAdcPin);
@@ -101,8 +101,8 @@ bool AnalogElecConductivity::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     // Return true when finished
     return true;
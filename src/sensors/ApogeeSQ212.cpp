@@ -12,6 +12,7 @@
 
 
 #include "ApogeeSQ212.h"
+#include <Wire.h>
 #include <Adafruit_ADS1015.h>
 
 
@@ -41,14 +42,23 @@ String ApogeeSQ212::getSensorLocation(void) {
 }
 
 
+// This sensor is on the default I2C bus
+sensorBusType ApogeeSQ212::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t ApogeeSQ212::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(&Wire);
+}
+
+
 bool ApogeeSQ212::addSingleMeasurementResult(void) {
     // Variables to store the results in
     float adcVoltage  = -9999;
     float calibResult = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
 // Create an Auxillary ADD object
@@ -103,8 +113,8 @@ bool ApogeeSQ212::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     if (adcVoltage < 3.6 && adcVoltage > -0.3) {
         return true;
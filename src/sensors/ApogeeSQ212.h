@@ -259,6 +259,16 @@ class ApogeeSQ212 : public Sensor {
      * @return **String** Text describing how the sensor is attached to the mcu.
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     *
+     * This sensor is always on the default TwoWire instance, Wire.
+     */
+    uintptr_t getBusId(void) override;
 
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
@@ -45,6 +45,20 @@ String AtlasParent::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType AtlasParent::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t AtlasParent::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+// The sensor is ready once it acknowledges its address
+bool AtlasParent::probeReadiness(void) {
+    _i2c->beginTransmission(_i2cAddressHex);
+    return _i2c->endTransmission() == 0;
+}
+
+
 bool AtlasParent::setup(void) {
     _i2c->begin();  // Start the wire library (sensor power not required)
     // Eliminate any potential extra waits in the wire library
@@ -83,9 +97,8 @@ bool AtlasParent::sleep(void) {
         _millisSensorActivated = 0;
         // Unset the measurement request time
         _millisMeasurementRequested = 0;
-        // Unset the status bits for sensor activation (bits 3 & 4) and
-        // measurement request (bits 5 & 6)
-        _sensorStatus &= 0b10000111;
+        // Return to the powered state
+        fallBackToState(SENSOR_POWERED);
         MS_DBG(F("Done"));
     } else {
         MS_DBG(getSensorNameAndLocation(), F("did not accept sleep command"));
@@ -119,12 +132,12 @@ bool AtlasParent::startSingleMeasurement(void) {
         // Update the time that a measurement was requested
         _millisMeasurementRequested = millis();
     } else {
-        // Otherwise, make sure that the measurement start time and success bit
-        // (bit 6) are unset
+        // Otherwise, make sure that the measurement start time is unset and
+        // fall back to the measurement attempt
         MS_DBG(getSensorNameAndLocation(),
                F("did not successfully start a measurement."));
         _millisMeasurementRequested = 0;
-        _sensorStatus &= 0b10111111;
+        fallBackToState(SENSOR_MEASUREMENT_ATTEMPTED);
     }
 
     return success;
@@ -134,9 +147,9 @@ bool AtlasParent::startSingleMeasurement(void) {
 bool AtlasParent::addSingleMeasurementResult(void) {
     bool success = false;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         // call the circuit and request 40 bytes (this may be more than we need)
         _i2c->requestFrom(static_cast<int>(_i2cAddressHex), 40, 1);
         // the first byte is the response code, we read this separately.
@@ -185,8 +198,8 @@ bool AtlasParent::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -174,6 +174,20 @@ class AtlasParent : public Sensor {
      * @return **String** Text describing how the sensor is attached to the mcu.
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
+    /**
+     * @copydoc Sensor::probeReadiness()
+     *
+     * The sensor is ready once it acknowledges its I2C address.
+     */
+    bool probeReadiness(void) override;
 
     /**
      * @brief Do any one-time preparations needed before the sensor will be able
@@ -75,10 +75,10 @@ bool AtlasScientificEC::setup() {
     success &= waitForProcessing();
 
     if (!success) {
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
 
     // Turn the power back off it it had been turned on
@@ -38,6 +38,20 @@ String BoschBME280::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType BoschBME280::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t BoschBME280::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+// The sensor is ready once it acknowledges its address
+bool BoschBME280::probeReadiness(void) {
+    _i2c->beginTransmission(_i2cAddressHex);
+    return _i2c->endTransmission() == 0;
+}
+
+
 bool BoschBME280::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -57,10 +71,10 @@ bool BoschBME280::setup(void) {
         ntries++;
     }
     if (!success) {
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
     retVal &= success;
 
@@ -121,9 +135,9 @@ bool BoschBME280::addSingleMeasurementResult(void) {
     float press = -9999;
     float alt   = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Read values
@@ -163,8 +177,8 @@ bool BoschBME280::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -325,6 +325,20 @@ class BoschBME280 : public Sensor {
      * @copydoc Sensor::getSensorLocation()
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
+    /**
+     * @copydoc Sensor::probeReadiness()
+     *
+     * The sensor is ready once it acknowledges its I2C address.
+     */
+    bool probeReadiness(void) override;
 
     // bool startSingleMeasurement(void) override;  // for forced mode
     /**
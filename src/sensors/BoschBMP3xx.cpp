@@ -8,6 +8,7 @@
  */
 
 #include "BoschBMP3xx.h"
+#include <Wire.h>
 
 
 // The constructor
@@ -35,6 +36,15 @@ String BoschBMP3xx::getSensorLocation(void) {
 }
 
 
+// This sensor is on the default I2C bus
+sensorBusType BoschBMP3xx::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t BoschBMP3xx::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(&Wire);
+}
+
+
 bool BoschBMP3xx::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -192,10 +202,10 @@ bool BoschBMP3xx::setup(void) {
         ntries++;
     }
     if (!success) {
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
     retVal &= success;
 
@@ -237,10 +247,10 @@ bool BoschBMP3xx::wake(void) {
             ntries++;
         }
         if (!success) {
-            // Set the status error bit (bit 7)
-            _sensorStatus |= 0b10000000;
-            // UN-set the set-up bit (bit 0) since setup failed!
-            _sensorStatus &= 0b11111110;
+            // Set the status error bit
+            bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+            // UN-set the set-up bit since setup failed!
+            bitClear(_sensorStatus, SENSOR_SETUP_BIT);
         }
         return success;
     }
@@ -281,9 +291,9 @@ bool BoschBMP3xx::addSingleMeasurementResult(void) {
     float press = -9999;
     float alt   = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Read values
@@ -310,8 +320,8 @@ bool BoschBMP3xx::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
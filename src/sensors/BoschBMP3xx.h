@@ -446,6 +446,16 @@ class BoschBMP3xx : public Sensor {
      * @copydoc Sensor::getSensorLocation()
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     *
+     * This sensor is always on the default TwoWire instance, Wire.
+     */
+    uintptr_t getBusId(void) override;
 
     /**
      * @copydoc Sensor::startSingleMeasurement()
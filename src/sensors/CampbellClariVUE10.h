@@ -39,6 +39,11 @@
  * @note While it is supported, you should not average measurements for this sensor.
  * The sensor takes a burst of 30 readings and returns the median of those.
  *
+ * The sensor also supports the continuous (`aR0!`) and high volume (`aHA!` and
+ * `aHB!`) SDI-12 commands, which can be chosen with
+ * `setMeasurementStrategy()`.  The high volume commands return all 7 values in
+ * a single data request.
+ *
  * @section sensor_clarivue_datasheet Sensor Datasheet
  * The specifications and datasheet are available at https://www.campbellsci.com/clarivue10
  *
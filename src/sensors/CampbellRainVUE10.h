@@ -39,6 +39,11 @@
  * The sensor takes continuous readings and returns the cumulative value over
  * each logging interval.
  *
+ * Because the sensor is always measuring, its values can be read in a single
+ * transaction with the continuous measurement command (`aR0!`), without the
+ * start, wait, and data requests of a concurrent measurement.  To do this,
+ * call `setMeasurementStrategy(SDI12_CONTINUOUS)` on the sensor object.
+ *
  * @section sensor_rainvue_datasheet Sensor Datasheet
  * The specifications and datasheet are available at https://www.campbellsci.com/rainvue10
  *
@@ -38,9 +38,9 @@ bool EverlightALSPT19::addSingleMeasurementResult(void) {
     float current_val = -9999;
     float lux_val     = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         // Set the resolution for the processor ADC, only applies to SAMD
         // boards.
 #if !defined ARDUINO_ARCH_AVR
@@ -89,8 +89,8 @@ bool EverlightALSPT19::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return true;
 }
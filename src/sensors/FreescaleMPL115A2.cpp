@@ -35,6 +35,15 @@ String FreescaleMPL115A2::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType FreescaleMPL115A2::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t FreescaleMPL115A2::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+
+
 bool FreescaleMPL115A2::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -62,9 +71,9 @@ bool FreescaleMPL115A2::addSingleMeasurementResult(void) {
     float temp  = -9999;
     float press = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Read values
@@ -89,8 +98,8 @@ bool FreescaleMPL115A2::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     // no way of knowing if successful, just return true
     return true;
@@ -224,6 +224,14 @@ class FreescaleMPL115A2 : public Sensor {
      * @copydoc Sensor::getSensorLocation()
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
 
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
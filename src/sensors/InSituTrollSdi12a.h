@@ -50,6 +50,11 @@
  *
  * Tested with Level TROLL 500.
  *
+ * The TROLL keeps measuring for its internal logger, so its latest values can
+ * be read in a single transaction with the continuous measurement command
+ * (`aR0!`) by calling `setMeasurementStrategy(SDI12_CONTINUOUS)` on the sensor
+ * object.  It also supports the high volume commands (`aHA!` and `aHB!`).
+ *
  * @section sensor_insitu_troll_datasheet Sensor Datasheet
  * Documentation for the SDI-12 Protocol commands and responses
  * The In-Situ Level/Aqua TROLL can be found at:
@@ -9,6 +9,7 @@
  */
 
 #include "KellerParent.h"
+#include "ModbusBus.h"
 
 // The constructor - need the sensor type, modbus address, power pin, stream for
 // data, and number of readings to average
@@ -26,7 +27,8 @@ KellerParent::KellerParent(byte modbusAddress, Stream* stream, int8_t powerPin,
       _modbusAddress(modbusAddress),
       _stream(stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2),
+      _bus(nullptr) {}
 KellerParent::KellerParent(byte modbusAddress, Stream& stream, int8_t powerPin,
                            int8_t powerPin2, int8_t enablePin,
                            uint8_t measurementsToAverage, kellerModel model,
@@ -41,7 +43,8 @@ KellerParent::KellerParent(byte modbusAddress, Stream& stream, int8_t powerPin,
       _modbusAddress(modbusAddress),
       _stream(&stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2),
+      _bus(nullptr) {}
 // Destructor
 KellerParent::~KellerParent() {}
 
@@ -55,6 +58,55 @@ String KellerParent::getSensorLocation(void) {
 }
 
 
+// This sensor is on the modbus stream
+sensorBusType KellerParent::getBusType(void) {
+    return MODBUS_BUS;
+}
+uintptr_t KellerParent::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_stream);
+}
+// The sensor is ready once it answers a single register read; the full read
+// of the sensor library retries with long timeouts, which would hold up every
+// other sensor
+bool KellerParent::probeReadiness(void) {
+    if (!beginBusTransaction()) { return false; }
+    bool ready = ModbusBus::probeAddress(_stream, _modbusAddress,
+                                         _RS485EnablePin);
+    endBusTransaction();
+    return ready;
+}
+
+
+// The pin controlling power to the RS485 adapter
+int8_t KellerParent::getSecondaryPowerPin(void) {
+    return _powerPin2;
+}
+
+
+ModbusBus* KellerParent::getBus(void) {
+    return _bus;
+}
+// A sensor on a bus only talks on the line inside its own transaction, and
+// only ends a transaction it opened
+bool KellerParent::beginBusTransaction(void) {
+    return _bus == nullptr || _bus->beginTransaction();
+}
+void KellerParent::endBusTransaction(void) {
+    if (_bus != nullptr) { _bus->endTransaction(); }
+}
+// The sensor is switched to the pins of the bus once it has joined
+bool ModbusBus::addSensor(KellerParent* sensor) {
+    if (sensor == nullptr || sensor->_bus != nullptr) { return false; }
+    if (!attachSensor(sensor, sensor->_modbusAddress, sensor->_stream)) {
+        return false;
+    }
+    sensor->_RS485EnablePin = _enablePin;
+    sensor->_powerPin2      = _adapterPowerPin;
+    sensor->_bus            = this;
+    return true;
+}
+
+
 bool KellerParent::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -83,7 +135,10 @@ void KellerParent::powerUp(void) {
         // Mark the time that the sensor was powered
         _millisPowerOn = millis();
     }
-    if (_powerPin2 >= 0) {
+    if (_bus != nullptr) {
+        // The bus keeps the adapter on for every sensor sharing it
+        _bus->holdAdapterPower(this);
+    } else if (_powerPin2 >= 0) {
         MS_DBG(F("Applying secondary power to"), getSensorNameAndLocation(),
                F("with pin"), _powerPin2);
         digitalWrite(_powerPin2, HIGH);
@@ -92,8 +147,8 @@ void KellerParent::powerUp(void) {
         MS_DBG(F("Power to"), getSensorNameAndLocation(),
                F("is not controlled by this library."));
     }
-    // Set the status bit for sensor power attempt (bit 1) and success (bit 2)
-    _sensorStatus |= 0b00000110;
+    // Mark the sensor as powered, without forgetting that it may be awake
+    advanceToState(SENSOR_POWERED);
 }
 
 
@@ -109,11 +164,13 @@ void KellerParent::powerDown(void) {
         _millisSensorActivated = 0;
         // Unset the measurement request time
         _millisMeasurementRequested = 0;
-        // Unset the status bits for sensor power (bits 1 & 2),
-        // activation (bits 3 & 4), and measurement request (bits 5 & 6)
-        _sensorStatus &= 0b10000001;
+        // Return to the unpowered state
+        setState(SENSOR_UNPOWERED);
     }
-    if (_powerPin2 >= 0) {
+    if (_bus != nullptr) {
+        // The adapter is only switched off once no sensor on the bus needs it
+        _bus->releaseAdapterPower(this);
+    } else if (_powerPin2 >= 0) {
         MS_DBG(F("Turning off secondary power to"), getSensorNameAndLocation(),
                F("with pin"), _powerPin2);
         digitalWrite(_powerPin2, LOW);
@@ -136,13 +193,16 @@ bool KellerParent::addSingleMeasurementResult(void) {
     float waterDepthM        = -9999;
     float waterPressure_mBar = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Get Values
-        success     = _ksensor.getValues(waterPressureBar, waterTempertureC);
+        if (beginBusTransaction()) {
+            success = _ksensor.getValues(waterPressureBar, waterTempertureC);
+            endBusTransaction();
+        }
         waterDepthM = _ksensor.calcWaterDepthM(
             waterPressureBar,
             waterTempertureC);  // float calcWaterDepthM(float waterPressureBar,
@@ -171,8 +231,8 @@ bool KellerParent::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     // Return true when finished
     return success;
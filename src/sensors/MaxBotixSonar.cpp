@@ -36,6 +36,15 @@ String MaxBotixSonar::getSensorLocation(void) {
 }
 
 
+// This sensor is on its serial stream
+sensorBusType MaxBotixSonar::getBusType(void) {
+    return SERIAL_BUS;
+}
+uintptr_t MaxBotixSonar::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_stream);
+}
+
+
 bool MaxBotixSonar::setup(void) {
     // Set up the trigger, if applicable
     if (_triggerPin >= 0) {
@@ -115,9 +124,9 @@ bool MaxBotixSonar::addSingleMeasurementResult(void) {
 #endif
     }
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         uint8_t rangeAttempts = 0;
@@ -168,8 +177,8 @@ bool MaxBotixSonar::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     // Return values shows if we got a not-obviously-bad reading
     return success;
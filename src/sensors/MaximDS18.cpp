@@ -134,10 +134,10 @@ bool MaximDS18::setup(void) {
     if (!wasOn) { powerDown(); }
 
     if (!retVal) {  // if set-up failed
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
 
     return retVal;
@@ -162,12 +162,12 @@ bool MaximDS18::startSingleMeasurement(void) {
         // Update the time that a measurement was requested
         _millisMeasurementRequested = millis();
     } else {
-        // Otherwise, make sure that the measurement start time and success bit
-        // (bit 6) are unset
+        // Otherwise, make sure that the measurement start time is unset and
+        // fall back to the measurement attempt
         MS_DBG(getSensorNameAndLocation(),
                F("did not successfully start a measurement."));
         _millisMeasurementRequested = 0;
-        _sensorStatus &= 0b10111111;
+        fallBackToState(SENSOR_MEASUREMENT_ATTEMPTED);
     }
 
     return success;
@@ -180,9 +180,9 @@ bool MaximDS18::addSingleMeasurementResult(void) {
     // Initialize float variable
     float result = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
         result = _internalDallasTemp.getTempC(_OneWireAddress);
         MS_DBG(F("  Received"), result, F("°C"));
@@ -204,8 +204,8 @@ bool MaximDS18::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
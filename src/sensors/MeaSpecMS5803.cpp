@@ -10,6 +10,7 @@
  */
 
 #include "MeaSpecMS5803.h"
+#include <Wire.h>
 
 
 // The constructor - because this is I2C, only need the power pin
@@ -31,6 +32,15 @@ String MeaSpecMS5803::getSensorLocation(void) {
 }
 
 
+// This sensor is on the default I2C bus
+sensorBusType MeaSpecMS5803::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t MeaSpecMS5803::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(&Wire);
+}
+
+
 bool MeaSpecMS5803::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -59,9 +69,9 @@ bool MeaSpecMS5803::addSingleMeasurementResult(void) {
     float temp  = -9999;
     float press = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
         // Read values
         // NOTE:  These functions actually include the request to begin
@@ -93,8 +103,8 @@ bool MeaSpecMS5803::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -240,6 +240,16 @@ class MeaSpecMS5803 : public Sensor {
      * @copydoc Sensor::getSensorLocation()
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     *
+     * This sensor is always on the default TwoWire instance, Wire.
+     */
+    uintptr_t getBusId(void) override;
 
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
@@ -17,76 +17,30 @@ bool MeterTeros11::getResults(void) {
     float temp = -9999;
 
     // Check if this the currently active SDI-12 Object
-    bool wasActive = _SDI12Internal.isActive();
+    bool wasActive = _SDI12Interface->isActive();
     // If it wasn't active, activate it now.
     // Use begin() instead of just setActive() to ensure timer is set
     // correctly.
-    if (!wasActive) _SDI12Internal.begin();
+    if (!wasActive) _SDI12Interface->begin();
     // Empty the buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
-    String getDataCommand = "";
-    getDataCommand += _SDI12address;
     // SDI-12 command to get data [address][D][dataOption][!]
-    getDataCommand += "D0!";
-    _SDI12Internal.sendCommand(getDataCommand, _extraWakeTime);
-    delay(30);  // It just needs this little delay
-    MS_DEEP_DBG(F("    >>>"), getDataCommand);
-
-    // Wait for the first few charaters to arrive.  The response from a data
-    // request should always have more than three characters
-    uint32_t start = millis();
-    while (_SDI12Internal.available() < 3 && (millis() - start) < 1500) {
-        // wait
-    }
-    // read the returned address to remove it from the buffer
-    auto returnedAddress = static_cast<char>(_SDI12Internal.read());
-    // print out a warning if the address doesn't match up
-    if (returnedAddress != _SDI12address) {
-        MS_DBG(F("Warning, expecting data from"), _SDI12address,
-               F("but got data from"), returnedAddress);
-    }
-    // Start printing out the returned data
-    MS_DEEP_DBG(F("    <<<"), returnedAddress);
-
-    // read the '+' out of the buffer, and print it if we're debugging
-#ifdef MS_SDI12SENSORS_DEBUG_DEEP
-    MS_DEEP_DBG(F("    <<<"), static_cast<char>(_SDI12Internal.read()));
-#else
-    _SDI12Internal.read();
-#endif
-
-    // Read the raw VWC counts
-    raw = _SDI12Internal.parseFloat(SKIP_NONE);
-    MS_DEEP_DBG(F("    <<<"), String(raw, 10));
-
-    // read the next '+' out of the buffer
-#ifdef MS_SDI12SENSORS_DEBUG_DEEP
-    MS_DEEP_DBG(F("    <<<"), static_cast<char>(_SDI12Internal.read()));
-#else
-    _SDI12Internal.read();
-#endif
-
-    // Now read the temperature
-    temp = _SDI12Internal.parseFloat(SKIP_NONE);
-    MS_DEEP_DBG(F("    <<<"), String(temp, 10));
-
-    // read and dump anything else
-    while (_SDI12Internal.available()) {
-#ifdef MS_SDI12SENSORS_DEBUG_DEEP
-        MS_DEEP_DBG(F("    <<<"), static_cast<char>(_SDI12Internal.read()));
-#else
-        _SDI12Internal.read();
-#endif
-    }
+    SDI12Response response;
+    requestSDI12Data(0, response);
+
+    // First variable returned is the raw VWC counts
+    raw  = response.getValue(0);
+    // Now the temperature
+    temp = response.getValue(1);
 
     // Empty the buffer again
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
-    if (!wasActive) _SDI12Internal.end();
+    if (!wasActive) _SDI12Interface->end();
 
     MS_DBG(F("Raw VWC Counts:"), raw);
     MS_DBG(F("Raw Temperature Value:"), temp);
@@ -0,0 +1,188 @@
+/**
+ * @file ModbusBus.cpp
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Implements the ModbusBus class.
+ */
+
+#include "ModbusBus.h"
+#include "VariableArray.h"
+
+
+// Constructors
+ModbusBus::ModbusBus(Stream* stream, int8_t adapterPowerPin, int8_t enablePin)
+    : _stream(stream),
+      _adapterPowerPin(adapterPowerPin),
+      _enablePin(enablePin),
+      _sensorCount(0),
+      _adapterHolds(0),
+      _inTransaction(false),
+      _lastFrame_ms(0),
+      _transactionCount(0),
+      _lastUpdateTime_ms(0) {}
+ModbusBus::ModbusBus(Stream& stream, int8_t adapterPowerPin, int8_t enablePin)
+    : _stream(&stream),
+      _adapterPowerPin(adapterPowerPin),
+      _enablePin(enablePin),
+      _sensorCount(0),
+      _adapterHolds(0),
+      _inTransaction(false),
+      _lastFrame_ms(0),
+      _transactionCount(0),
+      _lastUpdateTime_ms(0) {}
+// Destructor
+ModbusBus::~ModbusBus() {}
+
+
+// Every sensor must share the stream of the bus and have its own address
+bool ModbusBus::attachSensor(Sensor* sensor, byte address, Stream* stream) {
+    if (_sensorCount >= MAX_MODBUS_BUS_SENSORS) {
+        MS_DBG(F("Modbus bus is full; cannot add"),
+               sensor->getSensorNameAndLocation());
+        return false;
+    }
+    if (stream != _stream) {
+        MS_DBG(sensor->getSensorNameAndLocation(),
+               F("is not on the stream of the modbus bus"));
+        return false;
+    }
+    for (uint8_t i = 0; i < _sensorCount; i++) {
+        if (_addresses[i] == address) {
+            MS_DBG(F("Modbus address"), address,
+                   F("is already in use on the bus"));
+            return false;
+        }
+    }
+    _addresses[_sensorCount] = address;
+    _sensors[_sensorCount++] = sensor;
+    return true;
+}
+int8_t ModbusBus::findSensor(Sensor* sensor) {
+    for (uint8_t i = 0; i < _sensorCount; i++) {
+        if (_sensors[i] == sensor) { return i; }
+    }
+    return -1;
+}
+uint8_t ModbusBus::getSensorCount(void) {
+    return _sensorCount;
+}
+Stream* ModbusBus::getStream(void) {
+    return _stream;
+}
+int8_t ModbusBus::getAdapterPowerPin(void) {
+    return _adapterPowerPin;
+}
+int8_t ModbusBus::getEnablePin(void) {
+    return _enablePin;
+}
+
+
+// The adapter is switched on by the first hold and off with the last
+void ModbusBus::holdAdapterPower(Sensor* sensor) {
+    int8_t i = findSensor(sensor);
+    if (i < 0) { return; }
+    if (_adapterHolds == 0 && _adapterPowerPin >= 0) {
+        MS_DBG(F("Powering the RS485 adapter with pin"), _adapterPowerPin);
+        digitalWrite(_adapterPowerPin, HIGH);
+    }
+    _adapterHolds |= static_cast<uint16_t>(1U << i);
+}
+void ModbusBus::releaseAdapterPower(Sensor* sensor) {
+    int8_t i = findSensor(sensor);
+    if (i < 0 || (_adapterHolds & (1U << i)) == 0) { return; }
+    _adapterHolds &= static_cast<uint16_t>(~(1U << i));
+    if (_adapterHolds == 0 && _adapterPowerPin >= 0) {
+        MS_DBG(F("Turning off the RS485 adapter with pin"), _adapterPowerPin);
+        digitalWrite(_adapterPowerPin, LOW);
+    }
+}
+bool ModbusBus::isAdapterPowered(void) {
+    return _adapterHolds != 0;
+}
+
+
+// Only one request and reply is on the line at a time
+bool ModbusBus::beginTransaction(void) {
+    if (_inTransaction) {
+        MS_DBG(F("A modbus transaction is already open"));
+        return false;
+    }
+    // Wait out the silent interval that ends the previous frame
+    while (millis() - _lastFrame_ms < MODBUS_FRAME_GAP_MS) {
+        // wait
+    }
+    // Drop any late reply left from an earlier transaction
+    while (_stream->available()) { _stream->read(); }
+    _inTransaction = true;
+    return true;
+}
+void ModbusBus::endTransaction(void) {
+    _lastFrame_ms  = millis();
+    _inTransaction = false;
+    _transactionCount++;
+}
+uint32_t ModbusBus::getTransactionCount(void) {
+    return _transactionCount;
+}
+
+
+// A sensor is ready once it answers anything at all to a single register read
+bool ModbusBus::probeAddress(Stream* stream, byte address, int8_t enablePin) {
+    // Read 1 holding register from register 0
+    byte     frame[8] = {address, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00};
+    uint16_t crc      = 0xFFFF;
+    for (uint8_t i = 0; i < 6; i++) {
+        crc ^= frame[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    // The modbus CRC is sent low byte first
+    frame[6] = static_cast<byte>(crc & 0xFF);
+    frame[7] = static_cast<byte>(crc >> 8);
+
+    while (stream->available()) { stream->read(); }
+    if (enablePin >= 0) { digitalWrite(enablePin, HIGH); }
+    stream->write(frame, 8);
+    stream->flush();
+    if (enablePin >= 0) { digitalWrite(enablePin, LOW); }
+
+    bool     answered = false;
+    uint32_t start    = millis();
+    while (!answered && millis() - start < MODBUS_PROBE_TIMEOUT_MS) {
+        if (stream->available() && stream->read() == address) {
+            answered = true;
+        }
+    }
+    // Let the rest of the reply arrive and drop it
+    uint32_t lastChar = millis();
+    while (answered && millis() - lastChar < MODBUS_FRAME_GAP_MS) {
+        if (stream->available()) {
+            stream->read();
+            lastChar = millis();
+        }
+    }
+    return answered;
+}
+
+
+// This updates every sensor on the bus at once
+bool ModbusBus::updateAll(uint32_t timeBudget_ms, void (*onPass)()) {
+    uint32_t start = millis();
+
+    // Every sensor is powered before any is updated, so the adapter is
+    // switched on once and stays on until every sensor is done
+    bool success = VariableArray::updateSensors(_sensors, _sensorCount,
+                                                timeBudget_ms, onPass);
+
+    _lastUpdateTime_ms = millis() - start;
+    MS_DBG(F("Updated"), _sensorCount, F("modbus sensors in"),
+           _lastUpdateTime_ms, F("ms with"), _transactionCount,
+           F("transactions so far"));
+    return success;
+}
+uint32_t ModbusBus::getLastUpdateTime(void) {
+    return _lastUpdateTime_ms;
+}
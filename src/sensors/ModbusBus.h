@@ -0,0 +1,338 @@
+/**
+ * @file ModbusBus.h
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Contains the ModbusBus class.
+ *
+ * @copydetails ModbusBus
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_MODBUSBUS_H_
+#define SRC_SENSORS_MODBUSBUS_H_
+
+// Debugging Statement
+// #define MS_MODBUSBUS_DEBUG
+
+#ifdef MS_MODBUSBUS_DEBUG
+#define MS_DEBUGGING_STD "ModbusBus"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "SensorBase.h"
+
+// The Keller and Vaisala libraries can't be included together, so the sensors
+// are only declared here and each adds itself to the bus in its own source
+class YosemitechParent;
+class KellerParent;
+class VaisalaParent;
+
+/**
+ * @brief The largest number of sensors that can share one ModbusBus.
+ *
+ * This can be at most 16.  Override it with a build flag if more sensors
+ * share an RS485 line.
+ */
+#ifndef MAX_MODBUS_BUS_SENSORS
+#define MAX_MODBUS_BUS_SENSORS 8
+#endif
+// Each sensor holding the adapter power is one bit of a uint16_t
+static_assert(MAX_MODBUS_BUS_SENSORS <= 16,
+              "A modbus bus can have at most 16 sensors");
+/**
+ * @brief The silent interval between modbus frames, in milliseconds.
+ *
+ * Modbus RTU ends a frame with at least 3.5 characters of silence; at 9600
+ * baud that is just under 4 ms.  Increase this for slower lines.
+ */
+#ifndef MODBUS_FRAME_GAP_MS
+#define MODBUS_FRAME_GAP_MS 4
+#endif
+/**
+ * @brief The time to wait for a sensor to answer a readiness probe, in
+ * milliseconds.
+ *
+ * A sensor that is ready answers a single register read within a few
+ * character times, so this is much shorter than the timeouts the sensor
+ * libraries use for a full read.
+ */
+#ifndef MODBUS_PROBE_TIMEOUT_MS
+#define MODBUS_PROBE_TIMEOUT_MS 100
+#endif
+
+
+/**
+ * @brief The modbus bus manager coordinates all of the Yosemitech, Keller,
+ * and Vaisala sensors sharing a single RS485 line.
+ *
+ * Without a bus, each modbus sensor is given its own stream, RS485 adapter
+ * power pin, and direction enable pin, switches the adapter on and off with
+ * its own power, and talks to the line whenever it is asked.  Once added to a
+ * bus:
+ * - every sensor uses the stream and pins of the bus, so the line is set up
+ * in one place
+ * - the adapter is powered as long as any sensor on the bus is powered and is
+ * only switched off after the last one has been powered down
+ * - each request and reply is a transaction on the bus; a transaction starts
+ * only after the silent interval that ends the previous frame, and any late
+ * reply left on the line by another sensor is dropped before the request goes
+ * out
+ *
+ * The bus does not read any registers itself.  Each sensor still reads its
+ * own values through its own library, one request at a time; the bus only
+ * keeps those requests from overlapping and shares the adapter power.
+ *
+ * The sensors on a bus can still be updated by a variable array.  To update
+ * only the sensors on the bus, use updateAll(), which powers the adapter and
+ * every sensor once, starts all of their measurements back to back, and reads
+ * all of their results one after another as soon as each is due.
+ *
+ * For example, for a four probe sonde string on one RS485 line:
+ * @code{cpp}
+ * ModbusBus modbusBus(&modbusSerial, adapterPower, rs485EnablePin);
+ * modbusBus.addSensor(&y504);
+ * modbusBus.addSensor(&y520);
+ * modbusBus.addSensor(&y532);
+ * modbusBus.addSensor(&keller);
+ * @endcode
+ *
+ * @note Only one bus should be made for each stream, and each sensor on it
+ * must have its own modbus address.
+ *
+ * @ingroup the_sensors
+ */
+class ModbusBus {
+ public:
+    /**
+     * @brief Construct a new Modbus Bus object with no sensors.
+     *
+     * @param stream An Arduino data stream for modbus communication.  See
+     * [notes](@ref page_arduino_streams) for more information on what streams
+     * can be used.
+     * @param adapterPowerPin The pin on the mcu controlling power to the RS485
+     * adapter.  Use -1 or omit if not applicable.
+     * @param enablePin The pin on the mcu controlling the direction enable on
+     * the RS485 adapter, if necessary; use -1 or omit if not applicable.
+     */
+    explicit ModbusBus(Stream* stream, int8_t adapterPowerPin = -1,
+                       int8_t enablePin = -1);
+    /**
+     * @copydoc ModbusBus::ModbusBus
+     */
+    explicit ModbusBus(Stream& stream, int8_t adapterPowerPin = -1,
+                       int8_t enablePin = -1);
+    /**
+     * @brief Destroy the Modbus Bus object - no action taken.
+     */
+    ~ModbusBus();
+
+    /**
+     * @brief Add a sensor to the bus.
+     *
+     * The sensor must use the same stream as the bus and have a modbus
+     * address not already used on it.  The sensor is switched to the adapter
+     * power and enable pins of the bus, so it must be added before it is set
+     * up.
+     *
+     * @param sensor The modbus sensor to add
+     * @return **bool** True if the sensor was added.
+     */
+    bool addSensor(YosemitechParent* sensor);
+    /**
+     * @copydoc ModbusBus::addSensor(YosemitechParent*)
+     */
+    bool addSensor(KellerParent* sensor);
+    /**
+     * @copydoc ModbusBus::addSensor(YosemitechParent*)
+     */
+    bool addSensor(VaisalaParent* sensor);
+    /**
+     * @brief Get the number of sensors on the bus.
+     *
+     * @return **uint8_t** The number of sensors on the bus.
+     */
+    uint8_t getSensorCount(void);
+    /**
+     * @brief Get the stream of the bus.
+     *
+     * @return **Stream\*** The stream used for modbus communication.
+     */
+    Stream* getStream(void);
+    /**
+     * @brief Get the pin controlling power to the RS485 adapter.
+     *
+     * @return **int8_t** The adapter power pin, or -1 if there is none.
+     */
+    int8_t getAdapterPowerPin(void);
+    /**
+     * @brief Get the pin controlling the direction enable on the RS485
+     * adapter.
+     *
+     * @return **int8_t** The enable pin, or -1 if there is none.
+     */
+    int8_t getEnablePin(void);
+
+    /**
+     * @brief Hold the RS485 adapter powered for a sensor.
+     *
+     * The adapter is switched on by the first sensor to hold it.  Holding it
+     * again for the same sensor has no effect.
+     *
+     * @param sensor The sensor being powered
+     */
+    void holdAdapterPower(Sensor* sensor);
+    /**
+     * @brief Release a sensor's hold on the RS485 adapter power, switching the
+     * adapter off if no other sensor on the bus is holding it.
+     *
+     * @param sensor The sensor being powered down
+     */
+    void releaseAdapterPower(Sensor* sensor);
+    /**
+     * @brief Check if the RS485 adapter is being held powered.
+     *
+     * @return **bool** True if at least one sensor on the bus is holding the
+     * adapter power.
+     */
+    bool isAdapterPowered(void);
+
+    /**
+     * @brief Start a transaction on the bus.
+     *
+     * This waits out the silent interval after the previous frame and drops
+     * anything left in the stream buffer, so the reply to the coming request
+     * can't be mixed up with the end of an earlier one.
+     *
+     * @return **bool** True if the transaction was started; false if another
+     * transaction is already open, in which case the caller must not talk on
+     * the line or call endTransaction().
+     */
+    bool beginTransaction(void);
+    /**
+     * @brief End a transaction on the bus, marking the end of the last frame.
+     */
+    void endTransaction(void);
+    /**
+     * @brief Get the number of transactions on the bus since it was created.
+     *
+     * @return **uint32_t** The number of transactions.
+     */
+    uint32_t getTransactionCount(void);
+
+    /**
+     * @brief Check whether a sensor answers a single register read.
+     *
+     * This sends one request to read holding register 0 and waits up to
+     * #MODBUS_PROBE_TIMEOUT_MS for any reply from the address, either the
+     * value or an exception.  It makes no retries, so a sensor that is not
+     * yet ready costs only the short timeout.
+     *
+     * @param stream The stream of the RS485 line
+     * @param address The modbus address of the sensor
+     * @param enablePin The pin controlling the direction enable on the RS485
+     * adapter, or -1 if there is none.
+     * @return **bool** True if the sensor answered.
+     */
+    static bool probeAddress(Stream* stream, byte address, int8_t enablePin);
+
+    /**
+     * @brief Update every sensor on the bus at once.
+     *
+     * This powers the adapter and every sensor that was off, then runs the
+     * non-blocking update of every sensor together.  Each sensor's
+     * measurement is started as soon as it is stable and its result is read
+     * as soon as its measurement time has passed.  Once all of the sensors are
+     * done, the sensors that were off are powered down again, and with them
+     * the adapter.
+     *
+     * The sensors are updated by VariableArray::updateSensors(), which idles
+     * the processor between steps and abandons any sensor that runs out of
+     * time.
+     *
+     * @note This is "blocking" - it does not return until every sensor on the
+     * bus has finished or been abandoned.
+     *
+     * @param timeBudget_ms The longest the whole update may take, in ms.
+     * Optional with a default value of 0, meaning no limit.
+     * @param onPass A function to call on every pass through the sensors,
+     * such as one resetting the logger's watchdog.  Optional with a default
+     * value of nullptr.
+     * @return **bool** True if every sensor updated successfully.
+     */
+    bool updateAll(uint32_t timeBudget_ms = 0, void (*onPass)() = nullptr);
+    /**
+     * @brief Get the time the last call to updateAll() took.
+     *
+     * @return **uint32_t** The duration of the last update, in milliseconds.
+     */
+    uint32_t getLastUpdateTime(void);
+
+ protected:
+    /**
+     * @brief Check a sensor can join the bus and add it to the list.
+     *
+     * @param sensor The sensor to add
+     * @param address The modbus address of the sensor
+     * @param stream The stream the sensor was created with
+     * @return **bool** True if the sensor was added.
+     */
+    bool attachSensor(Sensor* sensor, byte address, Stream* stream);
+    /**
+     * @brief Find a sensor in the list.
+     *
+     * @param sensor The sensor
+     * @return **int8_t** The position of the sensor, or -1 if it is not on
+     * the bus.
+     */
+    int8_t findSensor(Sensor* sensor);
+    /**
+     * @brief The stream of the bus.
+     */
+    Stream* _stream;
+    /**
+     * @brief The pin controlling power to the RS485 adapter.
+     */
+    int8_t _adapterPowerPin;
+    /**
+     * @brief The pin controlling the direction enable on the RS485 adapter.
+     */
+    int8_t _enablePin;
+    /**
+     * @brief The sensors on the bus.
+     */
+    Sensor* _sensors[MAX_MODBUS_BUS_SENSORS];
+    /**
+     * @brief The modbus addresses of the sensors on the bus.
+     */
+    byte _addresses[MAX_MODBUS_BUS_SENSORS];
+    /**
+     * @brief The number of sensors on the bus.
+     */
+    uint8_t _sensorCount;
+    /**
+     * @brief One bit for each sensor holding the adapter power.
+     */
+    uint16_t _adapterHolds;
+    /**
+     * @brief True while a transaction is open.
+     */
+    bool _inTransaction;
+    /**
+     * @brief The time the last frame on the bus ended.
+     */
+    uint32_t _lastFrame_ms;
+    /**
+     * @brief The number of transactions on the bus.
+     */
+    uint32_t _transactionCount;
+    /**
+     * @brief The duration of the last update of every sensor on the bus.
+     */
+    uint32_t _lastUpdateTime_ms;
+};
+
+#endif  // SRC_SENSORS_MODBUSBUS_H_
@@ -81,6 +81,15 @@ String      PaleoTerraRedox::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType PaleoTerraRedox::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t PaleoTerraRedox::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+
+
 bool PaleoTerraRedox::setup(void) {
     _i2c->begin();  // Start the wire library (sensor power not required)
     // Eliminate any potential extra waits in the wire library
@@ -151,10 +160,8 @@ bool PaleoTerraRedox::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bit for a measurement having been requested (bit 5)
-    _sensorStatus &= 0b11011111;
-    // Set the status bit for measurement completion (bit 6)
-    _sensorStatus |= 0b01000000;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -75,6 +75,15 @@ String      RainCounterI2C::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType RainCounterI2C::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t RainCounterI2C::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+
+
 bool RainCounterI2C::setup(void) {
     _i2c->begin();  // Start the wire library (sensor power not required)
     // Eliminate any potential extra waits in the wire library
@@ -151,8 +160,8 @@ bool RainCounterI2C::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     // Return true when finished
     return true;
@@ -0,0 +1,108 @@
+/**
+ * @file SDI12Bus.cpp
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Implements the SDI12Bus class.
+ */
+
+#include "SDI12Bus.h"
+#include "VariableArray.h"
+
+
+// Constructor
+SDI12Bus::SDI12Bus()
+    : _sensorCount(0),
+      _interface(nullptr),
+      _holds(0),
+      _lastUpdateTime_ms(0) {}
+// Destructor
+SDI12Bus::~SDI12Bus() {}
+
+
+bool SDI12Bus::addSensor(SDI12Sensors* sensor) {
+    if (sensor == nullptr || sensor->_bus != nullptr) { return false; }
+    if (_sensorCount >= MAX_SDI12_BUS_SENSORS) {
+        MS_DBG(F("SDI-12 bus is full; cannot add"),
+               sensor->getSensorNameAndLocation());
+        return false;
+    }
+    if (_sensorCount > 0) {
+        // Every sensor must share the data pin of the first
+        if (sensor->_dataPin != getDataPin()) {
+            MS_DBG(sensor->getSensorNameAndLocation(),
+                   F("is not on data pin"), getDataPin());
+            return false;
+        }
+        // And every sensor must have its own address
+        for (uint8_t i = 0; i < _sensorCount; i++) {
+            if (_sensors[i]->_SDI12address == sensor->_SDI12address) {
+                MS_DBG(F("SDI-12 address"), sensor->_SDI12address,
+                       F("is already in use on pin"), getDataPin());
+                return false;
+            }
+        }
+    } else {
+        // The first sensor lends its SDI-12 object to the whole bus
+        _interface = &sensor->_SDI12Internal;
+    }
+    sensor->_SDI12Interface = _interface;
+    sensor->_bus            = this;
+    _sensors[_sensorCount++] = sensor;
+    return true;
+}
+uint8_t SDI12Bus::getSensorCount(void) {
+    return _sensorCount;
+}
+int8_t SDI12Bus::getDataPin(void) {
+    return _sensorCount > 0 ? _sensors[0]->_dataPin : -1;
+}
+
+
+// The interface is started by the first hold and stopped with the last
+void SDI12Bus::begin(void) {
+    if (_interface == nullptr) { return; }
+    if (_holds == 0) {
+        MS_DEEP_DBG(F("Activating SDI-12 bus on pin"), getDataPin());
+        // Use begin() instead of just setActive() to ensure timer is set
+        // correctly.
+        _interface->begin();
+    }
+    _holds++;
+}
+void SDI12Bus::end(void) {
+    if (_holds == 0) { return; }
+    _holds--;
+    if (_holds == 0) {
+        MS_DEEP_DBG(F("De-activating SDI-12 bus on pin"), getDataPin());
+        // Use end() instead of just forceHold to un-set the timers
+        _interface->end();
+    }
+}
+bool SDI12Bus::isActive(void) {
+    return _holds > 0;
+}
+
+
+// This updates every sensor on the bus at once
+bool SDI12Bus::updateAll(uint32_t timeBudget_ms, void (*onPass)()) {
+    uint32_t start = millis();
+
+    Sensor* sensors[MAX_SDI12_BUS_SENSORS];
+    for (uint8_t i = 0; i < _sensorCount; i++) { sensors[i] = _sensors[i]; }
+
+    // Hold the interface active for the whole update
+    begin();
+    bool success = VariableArray::updateSensors(sensors, _sensorCount,
+                                                timeBudget_ms, onPass);
+    end();
+
+    _lastUpdateTime_ms = millis() - start;
+    MS_DBG(F("Updated"), _sensorCount, F("SDI-12 sensors on pin"),
+           getDataPin(), F("in"), _lastUpdateTime_ms, F("ms"));
+    return success;
+}
+uint32_t SDI12Bus::getLastUpdateTime(void) {
+    return _lastUpdateTime_ms;
+}
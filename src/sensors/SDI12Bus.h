@@ -0,0 +1,182 @@
+/**
+ * @file SDI12Bus.h
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Contains the SDI12Bus class.
+ *
+ * @copydetails SDI12Bus
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_SDI12BUS_H_
+#define SRC_SENSORS_SDI12BUS_H_
+
+// Debugging Statement
+// #define MS_SDI12BUS_DEBUG
+
+#ifdef MS_SDI12BUS_DEBUG
+#define MS_DEBUGGING_STD "SDI12Bus"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "sensors/SDI12Sensors.h"
+
+/**
+ * @brief The largest number of sensors that can share one SDI12Bus.
+ *
+ * Override this with a build flag if more sensors share a data pin.
+ */
+#ifndef MAX_SDI12_BUS_SENSORS
+#define MAX_SDI12_BUS_SENSORS 10
+#endif
+
+
+/**
+ * @brief The SDI-12 bus coordinator runs concurrent measurements on all of
+ * the SDI-12 sensors sharing a single data pin.
+ *
+ * Without a bus, each SDI-12 sensor has its own SDI-12 object and starts and
+ * stops the interface around every command.  Once added to a bus, the
+ * sensors all share one SDI-12 object.  The bus holds the interface active
+ * from the first concurrent measurement (`aC!`) started on it until the last
+ * sensor's data (`aD0!`..`aD9!`) has been collected, so the measurements on
+ * every address can be started back to back.
+ *
+ * A sensor on a bus also waits only for the time (`ttt`) it announced in its
+ * reply to the measurement command before its data is collected, rather than
+ * the fixed measurement time of the sensor model.
+ *
+ * Sensors on a bus can still be updated by a variable array, which starts
+ * every ready measurement before collecting any results.  To update only the
+ * sensors on the bus, use updateAll().  Either way, a set of sensors on one
+ * cable finishes in about the time of the slowest sensor rather than the sum
+ * of all of them.
+ *
+ * For example, for three sensors on data pin 7:
+ * @code{cpp}
+ * SDI12Bus sdi12Bus;
+ * sdi12Bus.addSensor(&ctd);
+ * sdi12Bus.addSensor(&fiveTM);
+ * sdi12Bus.addSensor(&hydros21);
+ * @endcode
+ *
+ * @note Only one bus should be made for each data pin, and only sensors
+ * using concurrent measurements benefit from it; with the build flag
+ * `MS_SDI12_NON_CONCURRENT` each sensor still has the bus to itself.
+ *
+ * @ingroup sdi12_group
+ */
+class SDI12Bus {
+ public:
+    /**
+     * @brief Construct a new SDI-12 Bus object with no sensors.
+     */
+    SDI12Bus();
+    /**
+     * @brief Destroy the SDI-12 Bus object - no action taken.
+     */
+    ~SDI12Bus();
+
+    /**
+     * @brief Add a sensor to the bus.
+     *
+     * The first sensor added sets the data pin of the bus and lends it its
+     * SDI-12 object; every later sensor must be on the same data pin and
+     * have a different address.
+     *
+     * @param sensor The SDI-12 sensor to add
+     * @return **bool** True if the sensor was added.
+     */
+    bool addSensor(SDI12Sensors* sensor);
+    /**
+     * @brief Get the number of sensors on the bus.
+     *
+     * @return **uint8_t** The number of sensors on the bus.
+     */
+    uint8_t getSensorCount(void);
+    /**
+     * @brief Get the data pin of the bus.
+     *
+     * @return **int8_t** The data pin, or -1 if no sensor has been added.
+     */
+    int8_t getDataPin(void);
+
+    /**
+     * @brief Hold the shared SDI-12 interface active.
+     *
+     * The interface is started by the first hold and stays active until
+     * every hold has been released with end().  The sensors on the bus take
+     * a hold for each concurrent measurement they start.
+     */
+    void begin(void);
+    /**
+     * @brief Release a hold on the shared SDI-12 interface, stopping it if
+     * this was the last hold.
+     */
+    void end(void);
+    /**
+     * @brief Check if the shared SDI-12 interface is being held active.
+     *
+     * @return **bool** True if there is at least one hold on the interface.
+     */
+    bool isActive(void);
+
+    /**
+     * @brief Update every sensor on the bus at once.
+     *
+     * This powers every sensor that was off, then runs the non-blocking
+     * update of every sensor together.  Each sensor's measurement is started
+     * as soon as it is stable and its data is collected as soon as its
+     * announced wait has passed.  Once all of the sensors are done, the
+     * sensors that were off are powered down again.
+     *
+     * The sensors are updated by VariableArray::updateSensors(), which idles
+     * the processor between steps and abandons any sensor that runs out of
+     * time.
+     *
+     * @note This is "blocking" - it does not return until every sensor on the
+     * bus has finished or been abandoned.
+     *
+     * @param timeBudget_ms The longest the whole update may take, in ms.
+     * Optional with a default value of 0, meaning no limit.
+     * @param onPass A function to call on every pass through the sensors,
+     * such as one resetting the logger's watchdog.  Optional with a default
+     * value of nullptr.
+     * @return **bool** True if every sensor updated successfully.
+     */
+    bool updateAll(uint32_t timeBudget_ms = 0, void (*onPass)() = nullptr);
+    /**
+     * @brief Get the time the last call to updateAll() took.
+     *
+     * @return **uint32_t** The duration of the last update, in milliseconds.
+     */
+    uint32_t getLastUpdateTime(void);
+
+ protected:
+    /**
+     * @brief The sensors on the bus.
+     */
+    SDI12Sensors* _sensors[MAX_SDI12_BUS_SENSORS];
+    /**
+     * @brief The number of sensors on the bus.
+     */
+    uint8_t _sensorCount;
+    /**
+     * @brief The SDI-12 object shared by every sensor on the bus.
+     */
+    SDI12* _interface;
+    /**
+     * @brief The number of holds keeping the interface active.
+     */
+    uint8_t _holds;
+    /**
+     * @brief The duration of the last update of every sensor on the bus.
+     */
+    uint32_t _lastUpdateTime_ms;
+};
+
+#endif  // SRC_SENSORS_SDI12BUS_H_
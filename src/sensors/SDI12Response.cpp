@@ -0,0 +1,258 @@
+/**
+ * @file SDI12Response.cpp
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Implements the SDI12Response class.
+ */
+
+#include "SDI12Response.h"
+
+// A value has at most 7 digits, but leave room for sensors that send more
+#define SDI12_VALUE_MAX_DIGITS 9
+
+// Powers of ten for placing the decimal point
+static const float sdi12PowersOfTen[SDI12_VALUE_MAX_DIGITS + 1] = {
+    1.0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+
+
+// Constructor
+SDI12Response::SDI12Response() {
+    reset();
+}
+
+
+void SDI12Response::reset(void) {
+    _state          = SDI12_PARSE_ADDRESS;
+    _text[0]        = '\0';
+    _length         = 0;
+    _valueCount     = 0;
+    _mantissa       = 0;
+    _decimals       = 0;
+    _digits         = 0;
+    _negative       = false;
+    _wait           = 0;
+    _announcedCount = 0;
+    _crc            = 0;
+    _crcChars       = 0;
+    _crcStart       = 0;
+    _invalid        = 0;
+    _overflowed     = false;
+}
+
+
+// This steps the parser through one character of the response
+bool SDI12Response::parse(char c) {
+    if (_state == SDI12_PARSE_COMPLETE) { return true; }
+    // The break and marking before a response can leave a null in the buffer
+    if (c == '\0') { return false; }
+
+    // The <CR><LF> ends the response; a lone <LF> is accepted as well
+    if (c == '\n') {
+        if (_state == SDI12_PARSE_INTEGER || _state == SDI12_PARSE_FRACTION) {
+            finishValue();
+        }
+        _state = SDI12_PARSE_COMPLETE;
+        return true;
+    }
+    if (c == '\r') {
+        if (_state == SDI12_PARSE_INTEGER || _state == SDI12_PARSE_FRACTION) {
+            finishValue();
+        }
+        _state = SDI12_PARSE_END;
+        return false;
+    }
+    if (_state == SDI12_PARSE_END) {
+        _invalid++;
+        return false;
+    }
+
+    // Keep the character
+    if (_length < SDI12_RESPONSE_MAX_LENGTH) {
+        _text[_length++] = c;
+        _text[_length]   = '\0';
+    } else {
+        _overflowed = true;
+    }
+
+    if (_state == SDI12_PARSE_ADDRESS) {
+        _state = SDI12_PARSE_BODY;
+        return false;
+    }
+
+    if (c == '+' || c == '-') {
+        // A sign starts a new value
+        if (_state == SDI12_PARSE_INTEGER || _state == SDI12_PARSE_FRACTION) {
+            finishValue();
+        } else if (_state == SDI12_PARSE_CRC) {
+            // The "CRC" was noise in the middle of the values
+            _invalid += _crcChars;
+            _crcChars = 0;
+            _crc      = 0;
+        }
+        _negative = (c == '-');
+        _mantissa = 0;
+        _decimals = 0;
+        _digits   = 0;
+        _state    = SDI12_PARSE_INTEGER;
+    } else if (c >= '0' && c <= '9') {
+        uint8_t digit = static_cast<uint8_t>(c - '0');
+        switch (_state) {
+            case SDI12_PARSE_BODY:
+                // Digits without a sign are the wait and count of a reply to
+                // a measurement command
+                if (_digits < 3) {
+                    _wait = _wait * 10 + digit;
+                } else {
+                    _announcedCount = _announcedCount * 10 + digit;
+                }
+                // Keep them as a value too, in case a decimal point follows
+                if (_digits < SDI12_VALUE_MAX_DIGITS) {
+                    _mantissa = _mantissa * 10 + digit;
+                }
+                _digits++;
+                break;
+            case SDI12_PARSE_INTEGER:
+            case SDI12_PARSE_FRACTION:
+                if (_digits < SDI12_VALUE_MAX_DIGITS) {
+                    _mantissa = _mantissa * 10 + digit;
+                    _digits++;
+                    if (_state == SDI12_PARSE_FRACTION) { _decimals++; }
+                } else {
+                    _overflowed = true;
+                }
+                break;
+            default: _invalid++; break;
+        }
+    } else if (c == '.') {
+        switch (_state) {
+            case SDI12_PARSE_BODY:
+                // A value sent without a sign
+                _negative = false;
+                _decimals = 0;
+                _state    = SDI12_PARSE_FRACTION;
+                break;
+            case SDI12_PARSE_INTEGER: _state = SDI12_PARSE_FRACTION; break;
+            default: _invalid++; break;
+        }
+    } else if (static_cast<uint8_t>(c) >= 0x40 &&
+               static_cast<uint8_t>(c) <= 0x7F && _crcChars < 3) {
+        // Each CRC character carries 6 bits of the CRC in the range 0x40-0x7F
+        if (_state == SDI12_PARSE_INTEGER || _state == SDI12_PARSE_FRACTION) {
+            finishValue();
+        }
+        if (_state != SDI12_PARSE_CRC) { _crcStart = _length - 1; }
+        _crc = static_cast<uint16_t>((_crc << 6) | (c & 0x3F));
+        _crcChars++;
+        _state = SDI12_PARSE_CRC;
+    } else {
+        // Anything else ends the value in progress
+        if (_state == SDI12_PARSE_INTEGER || _state == SDI12_PARSE_FRACTION) {
+            finishValue();
+            _state = SDI12_PARSE_BODY;
+        }
+        _invalid++;
+    }
+    return false;
+}
+bool SDI12Response::parse(const char* text) {
+    while (*text != '\0') {
+        if (parse(*text++)) { return true; }
+    }
+    return isComplete();
+}
+
+
+// This adds the value in progress to the values
+void SDI12Response::finishValue(void) {
+    if (_digits == 0) {
+        // A sign or decimal point with no digits
+        _invalid++;
+    } else if (_valueCount < SDI12_RESPONSE_MAX_VALUES) {
+        float value = static_cast<float>(_mantissa) /
+            sdi12PowersOfTen[_decimals];
+        _values[_valueCount++] = _negative ? -value : value;
+    } else {
+        _overflowed = true;
+    }
+    _mantissa = 0;
+    _decimals = 0;
+    _digits   = 0;
+}
+
+
+bool SDI12Response::isComplete(void) {
+    return _state == SDI12_PARSE_COMPLETE;
+}
+char SDI12Response::getAddress(void) {
+    return _length > 0 ? _text[0] : '\0';
+}
+const char* SDI12Response::getText(void) {
+    return _text;
+}
+uint8_t SDI12Response::getLength(void) {
+    return _length;
+}
+bool SDI12Response::isOverflowed(void) {
+    return _overflowed;
+}
+uint8_t SDI12Response::getInvalidCount(void) {
+    return _invalid;
+}
+
+
+uint8_t SDI12Response::getValueCount(void) {
+    return _valueCount;
+}
+float SDI12Response::getValue(uint8_t i) {
+    return i < _valueCount ? _values[i] : -9999;
+}
+
+
+// A reply to a measurement command is only digits: 3 of wait and 1-3 of count
+bool SDI12Response::isMeasurementReply(void) {
+    return _valueCount == 0 && _digits >= 4 && _digits <= 6 &&
+        (_state == SDI12_PARSE_BODY || _state == SDI12_PARSE_END ||
+         _state == SDI12_PARSE_COMPLETE);
+}
+int16_t SDI12Response::getWait(void) {
+    return isMeasurementReply() ? static_cast<int16_t>(_wait) : -1;
+}
+uint16_t SDI12Response::getAnnouncedCount(void) {
+    return isMeasurementReply() ? _announcedCount : 0;
+}
+
+
+bool SDI12Response::hasCRC(void) {
+    return _crcChars == 3;
+}
+uint16_t SDI12Response::getCRC(void) {
+    return _crc;
+}
+uint8_t SDI12Response::getCRCLength(void) {
+    return hasCRC() ? _crcStart : _length;
+}
+// The CRC covers the address and values, everything before the CRC itself
+bool SDI12Response::isCRCValid(void) {
+    if (!hasCRC() || _overflowed) { return false; }
+    uint16_t crc = 0;
+    for (uint8_t i = 0; i < _crcStart; i++) {
+        crc = addToCRC(crc, static_cast<uint8_t>(_text[i]));
+    }
+    return crc == _crc;
+}
+
+
+// The SDI-12 CRC is a CRC-16 with the reflected polynomial 0xA001
+uint16_t SDI12Response::addToCRC(uint16_t crc, uint8_t c) {
+    crc ^= c;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        if (crc & 0x0001) {
+            crc = (crc >> 1) ^ 0xA001;
+        } else {
+            crc >>= 1;
+        }
+    }
+    return crc;
+}
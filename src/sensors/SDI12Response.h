@@ -0,0 +1,292 @@
+/**
+ * @file SDI12Response.h
+ * @copyright 2017-2022 Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino
+ * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
+ *
+ * @brief Contains the SDI12Response class.
+ *
+ * @copydetails SDI12Response
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_SDI12RESPONSE_H_
+#define SRC_SENSORS_SDI12RESPONSE_H_
+
+// Included Dependencies
+// This has no dependency on the Arduino core, so it can be benchmarked on a
+// host computer
+#include <stdint.h>
+
+/**
+ * @brief The longest SDI-12 response kept, not counting the <CR><LF>.
+ *
+ * The longest standard response is 75 characters of values from a concurrent
+ * measurement, plus the address and 3 CRC characters.
+ */
+#ifndef SDI12_RESPONSE_MAX_LENGTH
+#define SDI12_RESPONSE_MAX_LENGTH 80
+#endif
+/**
+ * @brief The largest number of values kept from a single SDI-12 response.
+ */
+#ifndef SDI12_RESPONSE_MAX_VALUES
+#define SDI12_RESPONSE_MAX_VALUES 20
+#endif
+
+
+/**
+ * @brief The states of the SDI-12 response parser.
+ */
+typedef enum sdi12ParseState {
+    SDI12_PARSE_ADDRESS = 0,  ///< Waiting for the address character
+    SDI12_PARSE_BODY,         ///< After the address, before any signed value
+    SDI12_PARSE_INTEGER,      ///< In the integer part of a value
+    SDI12_PARSE_FRACTION,     ///< In the fractional part of a value
+    SDI12_PARSE_CRC,          ///< In the CRC characters after the values
+    SDI12_PARSE_END,          ///< After the <CR>, waiting for the <LF>
+    SDI12_PARSE_COMPLETE      ///< The <LF> has been received
+} sdi12ParseState;
+
+
+/**
+ * @brief The SDI-12 response parser reads the reply to an SDI-12 command one
+ * character at a time as the characters arrive, without any heap allocation.
+ *
+ * Each character is passed to parse() as soon as it is read from the SDI-12
+ * buffer.  The parser steps through the address, the body, the values, and
+ * any CRC, and reports the response complete as soon as the <LF> arrives, so
+ * the caller never has to wait out a stream timeout.
+ *
+ * It understands:
+ * - acknowledgements, `a<CR><LF>`
+ * - replies to measurement commands, `atttn`, `atttnn`, and `atttnnn`, with
+ * the wait in seconds and the number of values to come
+ * - data responses, `a+1.23-4.5+67`, with each value starting at its `+` or
+ * `-` sign
+ * - the 3 CRC characters that follow the values in the reply to a CRC
+ * measurement
+ *
+ * The characters of the response, without the <CR><LF>, are kept in a fixed
+ * buffer for debugging and CRC checks.
+ *
+ * @ingroup sdi12_group
+ */
+class SDI12Response {
+ public:
+    /**
+     * @brief Construct a new, empty, SDI-12 Response object.
+     */
+    SDI12Response();
+
+    /**
+     * @brief Clear the response to parse a new one.
+     */
+    void reset(void);
+    /**
+     * @brief Parse the next character of the response.
+     *
+     * @param c The character
+     * @return **bool** True once the response is complete.
+     */
+    bool parse(char c);
+    /**
+     * @brief Parse all of the characters of a string, up to its end or the end
+     * of the response.
+     *
+     * @param text A null-terminated string
+     * @return **bool** True if the response is complete.
+     */
+    bool parse(const char* text);
+
+    /**
+     * @brief Check if the full response, through the <LF>, has been parsed.
+     *
+     * @return **bool** True if the response is complete.
+     */
+    bool isComplete(void);
+    /**
+     * @brief Get the address the response came from.
+     *
+     * @return **char** The address; 0 if none has been received.
+     */
+    char getAddress(void);
+    /**
+     * @brief Get the characters of the response, without the <CR><LF>.
+     *
+     * @return **const char\*** The response text.
+     */
+    const char* getText(void);
+    /**
+     * @brief Get the number of characters of the response kept.
+     *
+     * @return **uint8_t** The length of the response text.
+     */
+    uint8_t getLength(void);
+    /**
+     * @brief Check if the response was longer than the buffer or had more
+     * values than could be kept.
+     *
+     * @return **bool** True if any characters or values were dropped.
+     */
+    bool isOverflowed(void);
+    /**
+     * @brief Get the number of characters that were not part of any value,
+     * such as noise on the line.
+     *
+     * @return **uint8_t** The number of unexpected characters.
+     */
+    uint8_t getInvalidCount(void);
+
+    /**
+     * @brief Get the number of values in the response.
+     *
+     * @return **uint8_t** The number of values.
+     */
+    uint8_t getValueCount(void);
+    /**
+     * @brief Get a value from the response.
+     *
+     * @param i The index of the value
+     * @return **float** The value, or -9999 if there is no such value.
+     */
+    float getValue(uint8_t i);
+
+    /**
+     * @brief Check if the response is the reply to a measurement command,
+     * `atttn`, with only digits after the address.
+     *
+     * @return **bool** True if the response has a wait and a value count.
+     */
+    bool isMeasurementReply(void);
+    /**
+     * @brief Get the wait announced in the reply to a measurement command.
+     *
+     * @return **int16_t** The wait in seconds, or -1 if the response is not a
+     * reply to a measurement command.
+     */
+    int16_t getWait(void);
+    /**
+     * @brief Get the number of values announced in the reply to a
+     * measurement command.
+     *
+     * @return **uint16_t** The number of values to come.
+     */
+    uint16_t getAnnouncedCount(void);
+
+    /**
+     * @brief Check if the response ended with 3 CRC characters.
+     *
+     * @return **bool** True if there is a CRC.
+     */
+    bool hasCRC(void);
+    /**
+     * @brief Get the CRC sent with the response, decoded from its 3
+     * characters.
+     *
+     * @return **uint16_t** The CRC sent by the sensor.
+     */
+    uint16_t getCRC(void);
+    /**
+     * @brief Get the number of characters of the response covered by its CRC,
+     * that is, everything before the CRC characters.
+     *
+     * @return **uint8_t** The number of characters covered by the CRC.
+     */
+    uint8_t getCRCLength(void);
+    /**
+     * @brief Check the CRC sent with the response against the characters
+     * received.
+     *
+     * @return **bool** True if the response has a CRC and it matches.
+     */
+    bool isCRCValid(void);
+
+    /**
+     * @brief Add a character to an SDI-12 CRC.
+     *
+     * The SDI-12 CRC is a CRC-16 with the reflected polynomial 0xA001,
+     * starting from 0.
+     *
+     * @param crc The CRC of the characters before this one
+     * @param c The character
+     * @return **uint16_t** The CRC including the character.
+     */
+    static uint16_t addToCRC(uint16_t crc, uint8_t c);
+
+ protected:
+    /**
+     * @brief Finish the value in progress and add it to the values.
+     */
+    void finishValue(void);
+
+    /**
+     * @brief The current state of the parser.
+     */
+    sdi12ParseState _state;
+    /**
+     * @brief The characters of the response, null-terminated.
+     */
+    char _text[SDI12_RESPONSE_MAX_LENGTH + 1];
+    /**
+     * @brief The number of characters in #_text.
+     */
+    uint8_t _length;
+    /**
+     * @brief The values of the response.
+     */
+    float _values[SDI12_RESPONSE_MAX_VALUES];
+    /**
+     * @brief The number of values in #_values.
+     */
+    uint8_t _valueCount;
+    /**
+     * @brief The digits of the value in progress, without the decimal point.
+     */
+    uint32_t _mantissa;
+    /**
+     * @brief The number of digits after the decimal point in the value in
+     * progress.
+     */
+    uint8_t _decimals;
+    /**
+     * @brief The number of digits in the value in progress, or in the body of
+     * a reply to a measurement command.
+     */
+    uint8_t _digits;
+    /**
+     * @brief True if the value in progress is negative.
+     */
+    bool _negative;
+    /**
+     * @brief The announced wait, from the first 3 digits of the body.
+     */
+    uint16_t _wait;
+    /**
+     * @brief The announced value count, from the digits of the body after the
+     * wait.
+     */
+    uint16_t _announcedCount;
+    /**
+     * @brief The CRC characters, decoded.
+     */
+    uint16_t _crc;
+    /**
+     * @brief The number of CRC characters received.
+     */
+    uint8_t _crcChars;
+    /**
+     * @brief The position of the first CRC character in #_text.
+     */
+    uint8_t _crcStart;
+    /**
+     * @brief The number of unexpected characters.
+     */
+    uint8_t _invalid;
+    /**
+     * @brief True if characters or values were dropped.
+     */
+    bool _overflowed;
+};
+
+#endif  // SRC_SENSORS_SDI12RESPONSE_H_
@@ -11,6 +11,7 @@
 #include <EnableInterrupt.h>     // To handle external and pin change interrupts
 
 #include "SDI12Sensors.h"
+#include "sensors/SDI12Bus.h"
 
 
 // The constructor - need the number of measurements the sensor will return,
@@ -27,6 +28,7 @@ SDI12Sensors::SDI12Sensors(char SDI12address, int8_t powerPin, int8_t dataPin,
              stabilizationTime_ms, measurementTime_ms, powerPin, dataPin,
              measurementsToAverage, incCalcValues),
       _SDI12Internal(dataPin),
+      _SDI12Interface(&_SDI12Internal),
       _SDI12address(SDI12address),
       _extraWakeTime(extraWakeTime) {}
 SDI12Sensors::SDI12Sensors(char* SDI12address, int8_t powerPin, int8_t dataPin,
@@ -41,6 +43,7 @@ SDI12Sensors::SDI12Sensors(char* SDI12address, int8_t powerPin, int8_t dataPin,
              stabilizationTime_ms, measurementTime_ms, powerPin, dataPin,
              measurementsToAverage, incCalcValues),
       _SDI12Internal(dataPin),
+      _SDI12Interface(&_SDI12Internal),
       _SDI12address(*SDI12address),
       _extraWakeTime(extraWakeTime) {}
 SDI12Sensors::SDI12Sensors(int SDI12address, int8_t powerPin, int8_t dataPin,
@@ -55,6 +58,7 @@ SDI12Sensors::SDI12Sensors(int SDI12address, int8_t powerPin, int8_t dataPin,
              stabilizationTime_ms, measurementTime_ms, powerPin, dataPin,
              measurementsToAverage, incCalcValues),
       _SDI12Internal(dataPin),
+      _SDI12Interface(&_SDI12Internal),
       _SDI12address(static_cast<char>(SDI12address + '0')),
       _extraWakeTime(extraWakeTime) {}
 // Destructor
@@ -71,14 +75,14 @@ bool SDI12Sensors::setup(void) {
     waitForWarmUp();
 
     // Begin the SDI-12 interface
-    _SDI12Internal.begin();
+    _SDI12Interface->begin();
 
     // Library default timeout should be 150ms, which is 10 times that specified
     // by the SDI-12 protocol for a sensor response.
     // May want to bump it up even further here.
-    _SDI12Internal.setTimeout(150);
+    _SDI12Interface->setTimeout(150);
     // Force the timeout value to be -9999 (This should be library default.)
-    _SDI12Internal.setTimeoutValue(-9999);
+    _SDI12Interface->setTimeoutValue(-9999);
 
 #if defined(__AVR__) || defined(ARDUINO_ARCH_AVR)
     // Allow the SDI-12 library access to interrupts
@@ -89,56 +93,52 @@ bool SDI12Sensors::setup(void) {
     retVal &= getSensorInfo();
 
     // Empty the SDI-12 buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
-    _SDI12Internal.end();
+    _SDI12Interface->end();
 
     // Turn the power back off it it had been turned on
     if (!wasOn) { powerDown(); }
 
     if (!retVal) {  // if set-up failed
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
 
     return retVal;
 }
 
 
-bool SDI12Sensors::requestSensorAcknowledgement(void) {
+bool SDI12Sensors::requestSensorAcknowledgement(uint8_t maxTries) {
     // Empty the buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     MS_DBG(F("  Asking for sensor acknowlegement"));
-    String myCommand = "";
-    myCommand += _SDI12address;
-    myCommand += "!";  // sends 'acknowledge active' command [address][!]
+    SDI12Response response;
 
     bool    didAcknowledge = false;
     uint8_t ntries         = 0;
-    while (!didAcknowledge && ntries < 5) {
-        _SDI12Internal.sendCommand(myCommand, _extraWakeTime);
-        MS_DEEP_DBG(F("    >>>"), myCommand);
-        delay(30);
+    while (!didAcknowledge && ntries < maxTries) {
+        // sends 'acknowledge active' command [address][!]
+        sendSDI12Command("!");
 
         // wait for acknowlegement with format:
         // [address]<CR><LF>
-        String sdiResponse = _SDI12Internal.readStringUntil('\n');
-        sdiResponse.trim();
-        MS_DEEP_DBG(F("    <<<"), sdiResponse);
+        readSDI12Response(response, SDI12_ACK_TIMEOUT_MS);
 
         // Empty the buffer again
-        _SDI12Internal.clearBuffer();
+        _SDI12Interface->clearBuffer();
 
-        if (sdiResponse == String(_SDI12address)) {
+        if (response.getAddress() == _SDI12address &&
+            response.getLength() == 1) {
             MS_DBG(F("   "), getSensorNameAndLocation(),
                    F("replied as expected."));
             didAcknowledge = true;
-        } else if (sdiResponse.startsWith(String(_SDI12address))) {
+        } else if (response.getAddress() == _SDI12address) {
             MS_DBG(F("   "), getSensorNameAndLocation(),
                    F("replied, unexpectedly"));
             didAcknowledge = true;
@@ -157,12 +157,12 @@ bool SDI12Sensors::requestSensorAcknowledgement(void) {
 // A helper function to run the "sensor info" SDI12 command
 bool SDI12Sensors::getSensorInfo(void) {
     // Check if this the currently active SDI-12 Object
-    bool wasActive = _SDI12Internal.isActive();
+    bool wasActive = _SDI12Interface->isActive();
     // If it wasn't active, activate it now.
     // Use begin() instead of just setActive() to ensure timer is set correctly.
-    if (!wasActive) _SDI12Internal.begin();
+    if (!wasActive) _SDI12Interface->begin();
     // Empty the buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // Check that the sensor is there and responding
     if (!requestSensorAcknowledgement()) return false;
@@ -171,23 +171,23 @@ bool SDI12Sensors::getSensorInfo(void) {
     String myCommand = "";
     myCommand += _SDI12address;
     myCommand += "I!";  // sends 'info' command [address][I][!]
-    _SDI12Internal.sendCommand(myCommand, _extraWakeTime);
+    _SDI12Interface->sendCommand(myCommand, _extraWakeTime);
     MS_DEEP_DBG(F("    >>>"), myCommand);
     delay(30);
 
     // wait for acknowlegement with format:
     // [address][SDI12 version supported (2 char)][vendor (8 char)][model (6
     // char)][version (3 char)][serial number (<14 char)]<CR><LF>
-    String sdiResponse = _SDI12Internal.readStringUntil('\n');
+    String sdiResponse = _SDI12Interface->readStringUntil('\n');
     sdiResponse.trim();
     MS_DEEP_DBG(F("    <<<"), sdiResponse);
 
     // Empty the buffer again
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
-    if (!wasActive) _SDI12Internal.end();
+    if (!wasActive) _SDI12Interface->end();
 
     if (sdiResponse.length() > 1) {
         String sdi12Address = sdiResponse.substring(0, 1);
@@ -218,10 +218,10 @@ bool SDI12Sensors::getSensorInfo(void) {
                                   // [address][XO][suppressionState][!]
                                   // 0: DDI unsuppressed
                                   // 1: DDI suppressed
-            _SDI12Internal.sendCommand(myCommand, _extraWakeTime);
+            _SDI12Interface->sendCommand(myCommand, _extraWakeTime);
             MS_DEEP_DBG(F("    >>>"), myCommand);
             delay(30);
-            String supressionResponse = _SDI12Internal.readStringUntil('\n');
+            String supressionResponse = _SDI12Interface->readStringUntil('\n');
             supressionResponse.trim();
             MS_DEEP_DBG(F("    <<<"), supressionResponse);
         }
@@ -260,15 +260,40 @@ String SDI12Sensors::getSensorLocation(void) {
     return sensorLocation;
 }
 
+
+// This sensor is on the SDI-12 bus on its data pin
+sensorBusType SDI12Sensors::getBusType(void) {
+    return SDI12_BUS;
+}
+uintptr_t SDI12Sensors::getBusId(void) {
+    return static_cast<uintptr_t>(_dataPin);
+}
+// The sensor is ready once it acknowledges its address
+bool SDI12Sensors::probeReadiness(void) {
+    // Check if this the currently active SDI-12 Object
+    bool wasActive = _SDI12Interface->isActive();
+    // If it wasn't active, activate it now.
+    if (!wasActive) _SDI12Interface->begin();
+    // Ask only once; if it doesn't answer it will be asked again later
+    bool ready = requestSensorAcknowledgement(1);
+    // De-activate the SDI-12 Object
+    if (!wasActive) _SDI12Interface->end();
+    return ready;
+}
+#ifdef MS_SDI12_NON_CONCURRENT
+bool SDI12Sensors::needsExclusiveBus(void) {
+    return true;
+}
+#endif
+
 // Sending the command to start a measurement
 int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
-    String startCommand;
-    String sdiResponse;
+    SDI12Response response;
 
     // Try up to 3 times to start a measurement
-    uint8_t numVariables = 0;
-    uint8_t ntries       = 0;
-    int8_t  wait         = -1;  // NOTE: The wait time can be 0!
+    uint16_t numVariables = 0;
+    uint8_t  ntries       = 0;
+    int8_t   wait         = -1;  // NOTE: The wait time can be 0!
     while (numVariables != (_numReturnedValues - _incCalcValues) &&
            ntries < 5) {
         if (isConcurrent) {
@@ -278,37 +303,41 @@ int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
             MS_DBG(F("  Beginning NON-concurrent (standard) measurement on"),
                    getSensorNameAndLocation());
         }
-        startCommand = "";
-        startCommand += _SDI12address;
-        if (isConcurrent) {
-            startCommand += "C!";  // Start concurrent measurement - format
-                                   // [address]['C'][!]
+        _SDI12Interface->clearBuffer();
+        if (_strategy == SDI12_HIGH_VOLUME_ASCII) {
+            // Start high volume ASCII measurement - format [address][HA][!]
+            sendSDI12Command("HA!");
+        } else if (_strategy == SDI12_HIGH_VOLUME_BINARY) {
+            // Start high volume binary measurement - format [address][HB][!]
+            sendSDI12Command("HB!");
+        } else if (isConcurrent) {
+            // Start concurrent measurement - format [address]['C'][!], or
+            // [address]['CC'][!] to have a CRC added to each data block
+            sendSDI12Command(_verifyCRC ? "CC!" : "C!");
         } else {
-            startCommand += "M!";  // Start standard measurement - format
-            // [address]['M'][!]
+            // Start standard measurement - format [address]['M'][!], or
+            // [address]['MC'][!] to have a CRC added to each data block
+            sendSDI12Command(_verifyCRC ? "MC!" : "M!");
         }
-        _SDI12Internal.clearBuffer();
-        _SDI12Internal.sendCommand(startCommand, _extraWakeTime);
-        delay(30);  // It just needs this little delay
-        MS_DEEP_DBG(F("    >>>"), startCommand);
 
         // wait for acknowlegement with format
         // [address][ttt (3 char, seconds)][number of values to be returned,
-        // 0-9]<CR><LF>
-        sdiResponse = _SDI12Internal.readStringUntil('\n');
-        sdiResponse.trim();
-        _SDI12Internal.clearBuffer();
-        MS_DEEP_DBG(F("    <<<"), sdiResponse);
+        // 0-9, 00-99 for concurrent, or 000-999 for high volume]<CR><LF>
+        readSDI12Response(response, SDI12_ACK_TIMEOUT_MS);
 
         // find out how long we have to wait (in seconds).
-        if (sdiResponse.length() > 3) {
-            wait = static_cast<uint8_t>(sdiResponse.substring(1, 4).toInt());
-            numVariables =
-                static_cast<uint8_t>(sdiResponse.substring(4).toInt());
+        if (response.getAddress() == _SDI12address &&
+            response.isMeasurementReply()) {
+            // Keep the full announced wait; ttt can be up to 999 seconds
+            _announcedWait_ms = 1000UL * response.getWait();
+            wait = response.getWait() > 127
+                ? 127
+                : static_cast<int8_t>(response.getWait());
+            numVariables = response.getAnnouncedCount();
         }
 
         // Empty the buffer again
-        _SDI12Internal.clearBuffer();
+        _SDI12Interface->clearBuffer();
         ntries++;
     }
 
@@ -334,18 +363,35 @@ bool SDI12Sensors::startSingleMeasurement(void) {
     // reason to go on.
     if (!Sensor::startSingleMeasurement()) return false;
 
+    // A sensor measuring continuously already has its values; they are read
+    // with aR0! once the "measurement" is complete, which is right away
+    if (_strategy == SDI12_CONTINUOUS) {
+        MS_DBG(F("    Continuous measurement will be read."));
+        _millisMeasurementRequested = millis();
+        setState(SENSOR_MEASURING);
+        return true;
+    }
+
+    // A sensor on a bus holds the shared SDI-12 object active until its
+    // results are collected, so the interface isn't restarted for each sensor
+    if (_bus != nullptr && !_holdingBus) {
+        _bus->begin();
+        _holdingBus = true;
+    }
+
     // Check if this the currently active SDI-12 Object
-    bool wasActive = _SDI12Internal.isActive();
+    bool wasActive = _SDI12Interface->isActive();
     // If it wasn't active, activate it now.
     // Use begin() instead of just setActive() to ensure timer is set correctly.
-    if (!wasActive) _SDI12Internal.begin();
+    if (!wasActive) _SDI12Interface->begin();
     // Empty the buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // Check that the sensor is there and responding
     if (!requestSensorAcknowledgement()) {
         _millisMeasurementRequested = 0;
-        _sensorStatus &= 0b10111111;
+        fallBackToState(SENSOR_MEASUREMENT_ATTEMPTED);
+        releaseBus();
         return false;
     }
 
@@ -355,21 +401,22 @@ bool SDI12Sensors::startSingleMeasurement(void) {
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
-    if (!wasActive) _SDI12Internal.end();
+    if (!wasActive) _SDI12Interface->end();
 
     // Set the times we've activated the sensor and asked for a measurement
     if (wait >= 0) {
         MS_DBG(F("    Concurrent measurement started."));
         // Update the time that a measurement was requested
         _millisMeasurementRequested = millis();
-        // Set the status bit for measurement start success (bit 6)
-        _sensorStatus |= 0b01000000;
+        // Mark the measurement as started
+        setState(SENSOR_MEASURING);
         return true;
     } else {
         MS_DBG(getSensorNameAndLocation(),
                F("did not respond to measurement request!"));
         _millisMeasurementRequested = 0;
-        _sensorStatus &= 0b10111111;
+        fallBackToState(SENSOR_MEASUREMENT_ATTEMPTED);
+        releaseBus();
         return false;
     }
 }
@@ -377,97 +424,55 @@ bool SDI12Sensors::startSingleMeasurement(void) {
 
 bool SDI12Sensors::getResults(void) {
     // Check if this the currently active SDI-12 Object
-    bool wasActive = _SDI12Internal.isActive();
+    bool wasActive = _SDI12Interface->isActive();
     // If it wasn't active, activate it now.
     // Use begin() instead of just setActive() to ensure timer is set
     // correctly.
-    if (!wasActive) _SDI12Internal.begin();
+    if (!wasActive) _SDI12Interface->begin();
     // Empty the buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
+
+    // High volume binary data comes in binary packets rather than text
+    if (_strategy == SDI12_HIGH_VOLUME_BINARY) {
+        bool success = getBinaryResults();
+        if (!wasActive) _SDI12Interface->end();
+        return success;
+    }
 
     MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
-    uint8_t resultsReceived = 0;
-    uint8_t cmd_number      = 0;
+    uint8_t       resultsReceived = 0;
+    uint16_t      cmd_number      = 0;
+    SDI12Response response;
+    // A high volume measurement can have up to 1000 blocks of data
+    uint16_t lastCommand = _strategy == SDI12_HIGH_VOLUME_ASCII ? 999 : 9;
 
     // When requesting data, the sensor sends back up to ~80 characters at a
     // time to each data request.  If it needs to return more results than can
     // fit in the first data request (D0), we need to make additional requests
     // (D1-9).  Since this is a parent to all sensors, we're going to keep
     // requesting data until we either get as many results as we expect or no
-    // more data is returned.
+    // more data is returned.  Continuous measurements are read the same way
+    // with R0-R9 instead.
     while (resultsReceived < (_numReturnedValues - _incCalcValues) &&
-           cmd_number <= 9) {
+           cmd_number <= lastCommand) {
         bool gotResults = false;
-        // Assemble the command based on how many commands we've already sent,
-        // starting with D0 and ending with D9
+        // Request the data and parse the values out of the reply
         // SDI-12 command to get data [address][D][dataOption][!]
-        String getDataCommand = "";
-        getDataCommand += _SDI12address;
-        getDataCommand += "D";
-        getDataCommand += cmd_number;
-        getDataCommand += "!";
-        _SDI12Internal.sendCommand(getDataCommand, _extraWakeTime);
-        delay(30);  // It just needs this little delay
-        MS_DEEP_DBG(F("    >>>"), getDataCommand);
-
-        // Wait for the first few charaters to arrive.  The response from a data
-        // request should always have more than three characters
-        uint32_t start = millis();
-        while (_SDI12Internal.available() < 3 && (millis() - start) < 1500) {
-            // wait
-        }
-        // read the returned address to remove it from the buffer
-        auto returnedAddress = static_cast<char>(_SDI12Internal.read());
-        // print out a warning if the address doesn't match up
-        if (returnedAddress != _SDI12address) {
-            MS_DBG(F("Warning, expecting data from"), _SDI12address,
-                   F("but got data from"), returnedAddress);
-        }
-        // Start printing out the returned data
-        MS_DEEP_DBG(F("    <<<"), returnedAddress);
-
-        // While there is any data left in the buffer
-        while (_SDI12Internal.available() && (millis() - start) < 3000) {
-            // First peek to see if the next character in the buffer is a number
-            int c = _SDI12Internal.peek();
-            // if there's a number, a decimal, or a negative sign next in the
-            // buffer, start reading it as a float.
-            if (c == '-' || (c >= '0' && c <= '9') || c == '.') {
-                // Read the float without skipping any in-valid characters.
-                // We don't want to skip anything because we want to be able to
-                // debug and see exactly which characters the sensor sent over
-                // if they weren't numbers.
-                // Reading the numbers as a float will remove them from the
-                // buffer.
-                float result = _SDI12Internal.parseFloat(SKIP_NONE);
-                // The SDI-12 library should return -9999 on timeout
-                if (result == -9999 || isnan(result)) result = -9999;
-                // Print out what we got
-                MS_DBG(F("    <<<"), String(result, 10));
-                // Verify that the number is valid and add it to the result
-                // array. After each result is read, tick up the number of
-                // results received so that the next one goes in the next spot
-                // in the variable array.
-                verifyAndAddMeasurementResult(resultsReceived, result);
-                if (result != -9999) {
-                    gotResults = true;
-                    resultsReceived++;
-                }
-                // if the next spot in the buffer isn't a number, we don't want
-                // to try and parse it, but we do want to print it out to the
-                // debugging port
-            } else {
-// if we're debugging print out the non-numeric character
-#ifdef MS_SDI12SENSORS_DEBUG_DEEP
-                MS_DEEP_DBG(F("    <<<"),
-                            static_cast<char>(_SDI12Internal.read()));
-#else
-                // if we're not debugging, just read the character to make sure
-                // it's removed from the buffer
-                _SDI12Internal.read();
-#endif
+        requestSDI12Data(cmd_number, response);
+
+        for (uint8_t i = 0; i < response.getValueCount(); i++) {
+            float result = response.getValue(i);
+            // Print out what we got
+            MS_DBG(F("    <<<"), String(result, 10));
+            // Verify that the number is valid and add it to the result
+            // array. After each result is read, tick up the number of
+            // results received so that the next one goes in the next spot
+            // in the variable array.
+            verifyAndAddMeasurementResult(resultsReceived, result);
+            if (result != -9999) {
+                gotResults = true;
+                resultsReceived++;
             }
-            delay(10);  // 1 character ~ 7.5ms
         }
         if (!gotResults) {
             MS_DBG(F("  No results received, will not continue requests!"));
@@ -480,11 +485,11 @@ bool SDI12Sensors::getResults(void) {
     }
 
     // Empty the buffer again
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
-    if (!wasActive) _SDI12Internal.end();
+    if (!wasActive) _SDI12Interface->end();
 
     return (_numReturnedValues - _incCalcValues) == resultsReceived;
 }
@@ -494,9 +499,9 @@ bool SDI12Sensors::getResults(void) {
 bool SDI12Sensors::addSingleMeasurementResult(void) {
     bool success = false;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         success = getResults();
     } else {
         // If there's no measurement, need to make sure we send over all
@@ -509,8 +514,10 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
+    // Let the bus go idle if this was the last sensor measuring on it
+    releaseBus();
 
     return success;
 }
@@ -518,31 +525,31 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
 bool SDI12Sensors::addSingleMeasurementResult(void) {
     bool success = false;
 
-    String startCommand;
-    String sdiResponse;
-
     // Check if this the currently active SDI-12 Object
-    bool wasActive = _SDI12Internal.isActive();
+    bool wasActive = _SDI12Interface->isActive();
     // If it wasn't active, activate it now.
     // Use begin() instead of just setActive() to ensure timer is set
     // correctly.
-    if (!wasActive) _SDI12Internal.begin();
+    if (!wasActive) _SDI12Interface->begin();
     // Empty the buffer
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // Check that the sensor is there and responding
     if (requestSensorAcknowledgement()) {
         // send the commands to start the measurement; false = not concurrent
         // the returned wait time should always be non-zero
-        int8_t wait = startSDI12Measurement(false);
+        // A sensor measuring continuously has nothing to start or wait for
+        int8_t wait = _strategy == SDI12_CONTINUOUS
+            ? 0
+            : startSDI12Measurement(false);
 
         // Set the times we've activated the sensor and asked for a measurement
         if (wait >= 0) {
             MS_DBG(F("    NON-concurrent measurement started."));
             // Update the time that a measurement was requested
             _millisMeasurementRequested = millis();
-            // Set the status bit for measurement start success (bit 6)
-            _sensorStatus |= 0b01000000;
+            // Mark the measurement as started
+            setState(SENSOR_MEASURING);
 
             // Since this is not a concurrent measurement, we must sit around
             // and wait for the sensor to issue a service request telling us
@@ -551,25 +558,18 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
             uint32_t timerStart = millis();
             while ((millis() - timerStart) < (1000 * (wait))) {
                 // sensor can interrupt us to let us know it is done early
-                if (_SDI12Internal.available()) {
-#ifdef MS_SDI12SENSORS_DEBUG_DEEP
-                    // if we're debugging print out early response
-                    MS_DEEP_DBG(F("    <<<"),
-                                _SDI12Internal.readStringUntil('\n'));
-                    _SDI12Internal.clearBuffer();
-                    break;
-#else
-                    // if we're not debugging, just read the response to make
+                if (_SDI12Interface->available()) {
+                    // read the service request, [address]<CR><LF>, to make
                     // sure it's removed from the buffer
-                    _SDI12Internal.readStringUntil('\n');
-                    _SDI12Internal.clearBuffer();
+                    SDI12Response serviceRequest;
+                    readSDI12Response(serviceRequest, SDI12_ACK_TIMEOUT_MS);
+                    _SDI12Interface->clearBuffer();
                     break;
-#endif
                 }
             }
             // Wait for anything else and clear it out
             delay(30);
-            _SDI12Internal.clearBuffer();
+            _SDI12Interface->clearBuffer();
 
             // get the results
             success = getResults();
@@ -591,17 +591,348 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
     }
 
     // Empty the buffer again
-    _SDI12Internal.clearBuffer();
+    _SDI12Interface->clearBuffer();
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
-    if (!wasActive) _SDI12Internal.end();
+    if (!wasActive) _SDI12Interface->end();
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
 #endif  // #ifndef MS_SDI12_NON_CONCURRENT
+
+
+// A sensor on a bus waits for the time it announced, not the model's time,
+// as does a high volume measurement, which the model's time is not for.  A
+// sensor measuring continuously doesn't wait at all.
+uint32_t SDI12Sensors::getMeasurementWait(void) {
+    switch (_strategy) {
+        case SDI12_CONTINUOUS: return 0;
+        case SDI12_HIGH_VOLUME_ASCII:
+        case SDI12_HIGH_VOLUME_BINARY: return _announcedWait_ms;
+        default:
+            return _bus != nullptr ? _announcedWait_ms : _measurementTime_ms;
+    }
+}
+bool SDI12Sensors::isMeasurementComplete(bool debug) {
+    if (getState() != SENSOR_MEASURING) {
+        return Sensor::isMeasurementComplete(debug);
+    }
+    uint32_t elapsed_since_meas_start = millis() - _millisMeasurementRequested;
+    if (elapsed_since_meas_start > getMeasurementWait()) {
+        if (debug) {
+            MS_DBG(F("It's been"), elapsed_since_meas_start,
+                   F("ms, and measurement by"), getSensorNameAndLocation(),
+                   F("should be complete!"));
+        }
+        return true;
+    }
+    return false;
+}
+uint32_t SDI12Sensors::getTimeUntilMeasurementComplete(void) {
+    if (getState() != SENSOR_MEASURING) { return 0; }
+    uint32_t elapsed_since_meas_start = millis() - _millisMeasurementRequested;
+    if (elapsed_since_meas_start > getMeasurementWait()) { return 0; }
+    return getMeasurementWait() - elapsed_since_meas_start + 1;
+}
+
+
+void SDI12Sensors::setMeasurementStrategy(sdi12MeasurementStrategy strategy) {
+    _strategy = strategy;
+}
+sdi12MeasurementStrategy SDI12Sensors::getMeasurementStrategy(void) {
+    return _strategy;
+}
+void SDI12Sensors::setCRCVerification(bool verifyCRC) {
+    _verifyCRC = verifyCRC;
+}
+bool SDI12Sensors::getCRCVerification(void) {
+    return _verifyCRC;
+}
+uint16_t SDI12Sensors::getCRCFailureCount(void) {
+    return _crcFailures;
+}
+
+
+SDI12Bus* SDI12Sensors::getBus(void) {
+    return _bus;
+}
+// Release the hold on the bus taken when a measurement was started
+void SDI12Sensors::releaseBus(void) {
+    if (_holdingBus) {
+        _holdingBus = false;
+        _bus->end();
+    }
+}
+// A measurement that is abandoned or loses its power will never have its
+// results collected, so it can't keep holding the bus
+void SDI12Sensors::markTimedOut(void) {
+    Sensor::markTimedOut();
+    releaseBus();
+}
+void SDI12Sensors::powerDown(void) {
+    releaseBus();
+    Sensor::powerDown();
+}
+
+
+// Send a command, [address][command], to the sensor
+void SDI12Sensors::sendSDI12Command(const char* command) {
+    char    fullCommand[SDI12_COMMAND_MAX_LENGTH + 1];
+    uint8_t i        = 0;
+    fullCommand[i++] = _SDI12address;
+    while (*command != '\0' && i < SDI12_COMMAND_MAX_LENGTH) {
+        fullCommand[i++] = *command++;
+    }
+    fullCommand[i] = '\0';
+    _SDI12Interface->sendCommand(fullCommand, _extraWakeTime);
+    MS_DEEP_DBG(F("    >>>"), fullCommand);
+}
+
+
+// Read a response as its characters arrive, stopping at the <CR><LF> instead
+// of waiting for a stream timeout
+bool SDI12Sensors::readSDI12Response(SDI12Response& response,
+                                     uint32_t       timeout_ms) {
+    response.reset();
+    uint32_t lastChar = millis();
+    while (millis() - lastChar < timeout_ms) {
+        if (_SDI12Interface->available()) {
+            lastChar = millis();
+            if (response.parse(static_cast<char>(_SDI12Interface->read()))) {
+                MS_DEEP_DBG(F("    <<<"), response.getText());
+                return true;
+            }
+        }
+    }
+    MS_DEEP_DBG(F("    <<<"), response.getText(), F("(timed out)"));
+    return false;
+}
+
+
+// Request a block of data, [address][D][dataOption][!], and read the reply
+bool SDI12Sensors::requestSDI12Data(uint16_t       dataOption,
+                                    SDI12Response& response) {
+    // Continuous measurements are read with [address][R][dataOption][!], or
+    // [address][RC][dataOption][!] to have a CRC added
+    char    dataCommand[7];
+    uint8_t i = 0;
+    if (_strategy == SDI12_CONTINUOUS) {
+        dataCommand[i++] = 'R';
+        if (_verifyCRC) { dataCommand[i++] = 'C'; }
+    } else {
+        dataCommand[i++] = 'D';
+    }
+    writeDataOption(&dataCommand[i], dataOption);
+
+    // A block that fails its CRC check is requested again on its own; the
+    // sensor keeps its data until the next measurement is started
+    for (uint8_t attempt = 0; attempt <= SDI12_CRC_RETRIES; attempt++) {
+        sendSDI12Command(dataCommand);
+        bool valid = readSDI12Response(response, SDI12_DATA_TIMEOUT_MS);
+        // print out a warning if the address doesn't match up
+        if (response.getAddress() != _SDI12address) {
+            MS_DBG(F("Warning, expecting data from"), _SDI12address,
+                   F("but got data from"), response.getAddress());
+            valid = false;
+        }
+        if (!_verifyCRC) { return valid; }
+        if (valid && response.isCRCValid()) { return true; }
+
+        // Only a full reply from this sensor can fail its CRC check; a
+        // timeout or a reply from another address is requested again too,
+        // but isn't counted
+        if (valid) {
+            _crcFailures++;
+            MS_DBG(F("  Data block"), dataOption, F("from"),
+                   getSensorNameAndLocation(), F("failed its CRC check!"));
+        }
+        _SDI12Interface->clearBuffer();
+    }
+
+    // Don't use any values from a block that never passed its CRC check
+    response.reset();
+    return false;
+}
+
+
+// Write a data option, 0-999, and the closing '!' into a command
+void SDI12Sensors::writeDataOption(char* command, uint16_t dataOption) {
+    if (dataOption >= 100) {
+        *command++ = static_cast<char>('0' + dataOption / 100);
+    }
+    if (dataOption >= 10) {
+        *command++ = static_cast<char>('0' + (dataOption / 10) % 10);
+    }
+    *command++ = static_cast<char>('0' + dataOption % 10);
+    *command++ = '!';
+    *command   = '\0';
+}
+
+
+// Read raw bytes, as for a binary packet, waiting up to the timeout for each
+uint16_t SDI12Sensors::readSDI12Bytes(uint8_t* buffer, uint16_t length,
+                                      uint32_t timeout_ms) {
+    uint16_t received = 0;
+    uint32_t lastChar = millis();
+    while (received < length && millis() - lastChar < timeout_ms) {
+        if (_SDI12Interface->available()) {
+            lastChar           = millis();
+            buffer[received++] = static_cast<uint8_t>(_SDI12Interface->read());
+        }
+    }
+    return received;
+}
+
+
+// Get the results of a high volume binary measurement
+bool SDI12Sensors::getBinaryResults(void) {
+    MS_DBG(getSensorNameAndLocation(), F("is reporting binary data:"));
+    uint8_t  resultsReceived = 0;
+    uint8_t  expected        = _numReturnedValues - _incCalcValues;
+    uint16_t packet          = 0;
+    // The values of a packet are held until its CRC has been checked; no
+    // packet can add more than the values still expected
+    float* packetValues = new float[expected > 0 ? expected : 1];
+    _SDI12Interface->clearBuffer();
+
+    while (resultsReceived < expected && packet <= 999) {
+        // A packet that fails its CRC check is requested again on its own;
+        // the sensor keeps its data until the next measurement is started
+        uint8_t            packetCount = 0;
+        binaryPacketStatus status      = SDI12_PACKET_MISSING;
+        for (uint8_t attempt = 0; attempt <= SDI12_CRC_RETRIES; attempt++) {
+            status = readBinaryPacket(packet, packetValues,
+                                      expected - resultsReceived, packetCount);
+            if (status != SDI12_PACKET_BAD_CRC &&
+                status != SDI12_PACKET_MISSING) {
+                break;
+            }
+            if (status == SDI12_PACKET_BAD_CRC) {
+                _crcFailures++;
+                MS_DBG(F("  Binary packet"), packet, F("from"),
+                       getSensorNameAndLocation(), F("failed its CRC check!"));
+            }
+            _SDI12Interface->clearBuffer();
+        }
+        // Stop at an empty packet, which means there is no more data, or at
+        // any packet that never arrived whole and passed its CRC check
+        if (status != SDI12_PACKET_OK) { break; }
+
+        for (uint8_t i = 0; i < packetCount; i++) {
+            verifyAndAddMeasurementResult(resultsReceived++, packetValues[i]);
+        }
+        packet++;
+    }
+
+    delete[] packetValues;
+
+    // Empty the buffer again
+    _SDI12Interface->clearBuffer();
+
+    return expected == resultsReceived;
+}
+
+
+// Request one binary packet, [address][DB][packet][!], and read it
+// Each packet is [address][size, 2 bytes][type][values][CRC, 2 bytes], with
+// every number little-endian
+SDI12Sensors::binaryPacketStatus
+SDI12Sensors::readBinaryPacket(uint16_t packet, float* values, uint8_t room,
+                               uint8_t& count) {
+    // The size in bytes of a value of each binary data type, 1-10; 0 is
+    // invalid
+    static const uint8_t typeSizes[11] = {0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8};
+
+    count               = 0;
+    char dataCommand[7] = "DB";
+    writeDataOption(&dataCommand[2], packet);
+    sendSDI12Command(dataCommand);
+
+    uint8_t header[4];
+    if (readSDI12Bytes(header, 4, SDI12_DATA_TIMEOUT_MS) < 4 ||
+        static_cast<char>(header[0]) != _SDI12address) {
+        MS_DBG(F("  No binary packet received!"));
+        return SDI12_PACKET_MISSING;
+    }
+    uint16_t size = header[1] | (static_cast<uint16_t>(header[2]) << 8);
+    uint8_t  type = header[3];
+    if (size == 0) { return SDI12_PACKET_EMPTY; }
+    if (type == 0 || type > 10 || size % typeSizes[type] != 0) {
+        MS_DBG(F("  Invalid binary packet type"), type, F("or size"), size);
+        return SDI12_PACKET_INVALID;
+    }
+    uint16_t crc = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        crc = SDI12Response::addToCRC(crc, header[i]);
+    }
+
+    // Decode the values as they arrive; the caller holds them until the CRC
+    // has been checked
+    for (uint16_t v = 0; v < size / typeSizes[type]; v++) {
+        uint8_t bytes[8];
+        if (readSDI12Bytes(bytes, typeSizes[type], SDI12_DATA_TIMEOUT_MS) <
+            typeSizes[type]) {
+            MS_DBG(F("  Binary packet"), packet, F("is incomplete!"));
+            return SDI12_PACKET_MISSING;
+        }
+        uint64_t raw = 0;
+        for (uint8_t b = 0; b < typeSizes[type]; b++) {
+            crc = SDI12Response::addToCRC(crc, bytes[b]);
+            raw |= static_cast<uint64_t>(bytes[b]) << (8 * b);
+        }
+        float result = decodeBinaryValue(raw, type);
+        MS_DBG(F("    <<<"), String(result, 10));
+        if (count < room) { values[count++] = result; }
+    }
+
+    uint8_t crcBytes[2];
+    if (readSDI12Bytes(crcBytes, 2, SDI12_DATA_TIMEOUT_MS) < 2) {
+        MS_DBG(F("  Binary packet"), packet, F("is incomplete!"));
+        return SDI12_PACKET_MISSING;
+    }
+    if ((crcBytes[0] | (static_cast<uint16_t>(crcBytes[1]) << 8)) != crc) {
+        return SDI12_PACKET_BAD_CRC;
+    }
+    return SDI12_PACKET_OK;
+}
+
+
+// Convert a little-endian binary value of the given SDI-12 type to a float
+float SDI12Sensors::decodeBinaryValue(uint64_t raw, uint8_t type) {
+    switch (type) {
+        case 1: return static_cast<int8_t>(raw);
+        case 2: return static_cast<uint8_t>(raw);
+        case 3: return static_cast<int16_t>(raw);
+        case 4: return static_cast<uint16_t>(raw);
+        case 5: return static_cast<int32_t>(raw);
+        case 6: return static_cast<uint32_t>(raw);
+        case 7: return static_cast<float>(static_cast<int64_t>(raw));
+        case 8: return static_cast<float>(raw);
+        case 9: {
+            uint32_t bits = static_cast<uint32_t>(raw);
+            float    value;
+            memcpy(&value, &bits, sizeof(value));
+            return isnan(value) ? -9999 : value;
+        }
+        case 10: {
+            // A double may only be 4 bytes on the board, so build the float
+            // from the sign, exponent, and fraction of the 8 byte double
+            int16_t exponent = static_cast<int16_t>((raw >> 52) & 0x7FF);
+            if (exponent == 0x7FF) { return -9999; }  // infinity or NaN
+            float value = 0;
+            if (exponent != 0) {
+                float fraction = static_cast<float>(raw & 0xFFFFFFFFFFFFFULL) /
+                    4503599627370496.0f;  // 2^52
+                value = ldexp(1.0f + fraction, exponent - 1023);
+            }
+            return (raw >> 63) ? -value : value;
+        }
+        default: return -9999;
+    }
+}
@@ -82,6 +82,7 @@
 #undef MS_DEBUGGING_DEEP
 #include "VariableBase.h"
 #include "SensorBase.h"
+#include "sensors/SDI12Response.h"
 #ifdef SDI12_EXTERNAL_PCINT
 #include <SDI12.h>
 #else
@@ -91,10 +92,74 @@
 // SDI12_EXTERNAL_PCINT Unfortunately, that is not compatible with the Arduino
 // IDE
 
+/**
+ * @brief The longest command sent to an SDI-12 sensor, including the address
+ * and the '!'.
+ */
+#define SDI12_COMMAND_MAX_LENGTH 7
+/**
+ * @brief The time in ms to wait for each character of a reply to a command,
+ * other than a data request.
+ *
+ * This is 10 times the longest gap allowed by the SDI-12 protocol before a
+ * sensor's response.
+ */
+#define SDI12_ACK_TIMEOUT_MS 150
+/**
+ * @brief The time in ms to wait for each character of a reply to a data
+ * request.
+ */
+#define SDI12_DATA_TIMEOUT_MS 1500
+/**
+ * @brief The number of times a data block that fails its CRC check is
+ * requested again before its values are given up on.
+ */
+#ifndef SDI12_CRC_RETRIES
+#define SDI12_CRC_RETRIES 3
+#endif
+
+/**
+ * @brief The ways an SDI-12 sensor can be asked for its values.
+ *
+ * @ingroup sdi12_group
+ */
+typedef enum sdi12MeasurementStrategy {
+    /**
+     * @brief Start a concurrent measurement (`aC!`), or a standard measurement
+     * (`aM!`) with the build flag `MS_SDI12_NON_CONCURRENT`, wait for it, and
+     * then collect the data with `aD0!`..`aD9!`.  This is the default.
+     */
+    SDI12_MEASURE = 0,
+    /**
+     * @brief Read the values of a sensor that measures continuously with
+     * `aR0!`..`aR9!`, without starting a measurement or waiting for one.
+     */
+    SDI12_CONTINUOUS,
+    /**
+     * @brief Start a high volume ASCII measurement (`aHA!`) of up to 999
+     * values, wait for it, and collect the data with `aD0!`..`aD999!`, each of
+     * which can hold up to 75 characters of values.
+     */
+    SDI12_HIGH_VOLUME_ASCII,
+    /**
+     * @brief Start a high volume binary measurement (`aHB!`), wait for it, and
+     * collect the data as binary packets with `aDB0!`..`aDB999!`.
+     *
+     * @note Binary packets are sent with 8 data bits rather than 7, so this
+     * needs a version of the SDI-12 library that passes all 8 bits of each
+     * character through.
+     */
+    SDI12_HIGH_VOLUME_BINARY
+} sdi12MeasurementStrategy;
+
+class SDI12Bus;
+
 /**
  * @brief The main class for SDI-12 Sensors
  */
 class SDI12Sensors : public Sensor {
+    friend class SDI12Bus;
+
  public:
     /**
      * @brief Construct a new SDI 12 Sensors object.  This is only intended to
@@ -198,6 +263,28 @@ class SDI12Sensors : public Sensor {
      * and the SDI-12 address.
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
+    /**
+     * @copydoc Sensor::probeReadiness()
+     *
+     * The sensor is ready once it acknowledges its address (`a!`).
+     */
+    bool probeReadiness(void) override;
+#ifdef MS_SDI12_NON_CONCURRENT
+    /**
+     * @copydoc Sensor::needsExclusiveBus()
+     *
+     * Non-concurrent SDI-12 measurements must have the bus to themselves.
+     */
+    bool needsExclusiveBus(void) override;
+#endif
 
     /**
      * @brief Do any one-time preparations needed before the sensor will be able
@@ -235,15 +322,100 @@ class SDI12Sensors : public Sensor {
      */
     bool addSingleMeasurementResult(void) override;
 
+    /**
+     * @copydoc Sensor::isMeasurementComplete()
+     *
+     * For a sensor on an SDI12Bus, the measurement is complete once the wait
+     * the sensor announced in its reply to the measurement command has
+     * passed, rather than the fixed measurement time of the sensor model.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+    /**
+     * @copydoc Sensor::getTimeUntilMeasurementComplete()
+     *
+     * For a sensor on an SDI12Bus, this counts down the wait the sensor
+     * announced.
+     */
+    uint32_t getTimeUntilMeasurementComplete(void) override;
+    /**
+     * @copydoc Sensor::markTimedOut()
+     *
+     * This also releases any hold the sensor has on its SDI12Bus, so an
+     * abandoned measurement doesn't keep the shared interface active.
+     */
+    void markTimedOut(void) override;
+    /**
+     * @copydoc Sensor::powerDown()
+     *
+     * This also releases any hold the sensor has on its SDI12Bus.
+     */
+    void powerDown(void) override;
+
+    /**
+     * @brief Set how the sensor is asked for its values.
+     *
+     * Sensors that keep sampling on their own can be read in one transaction
+     * with #SDI12_CONTINUOUS, and sensors with many values can return them in
+     * fewer, larger, blocks with #SDI12_HIGH_VOLUME_ASCII or
+     * #SDI12_HIGH_VOLUME_BINARY.  Check that the sensor supports the commands
+     * before choosing anything other than the default, #SDI12_MEASURE.
+     *
+     * @param strategy The measurement strategy
+     */
+    void setMeasurementStrategy(sdi12MeasurementStrategy strategy);
+    /**
+     * @brief Get how the sensor is asked for its values.
+     *
+     * @return **sdi12MeasurementStrategy** The measurement strategy
+     */
+    sdi12MeasurementStrategy getMeasurementStrategy(void);
+    /**
+     * @brief Set whether the sensor should add a CRC to its data.
+     *
+     * With CRC verification on, measurements are started with `aMC!` or
+     * `aCC!`, and continuous measurements are read with `aRC0!`..`aRC9!`.
+     * The CRC of each data block is checked as it arrives, and only a block
+     * that fails the check is requested again, up to #SDI12_CRC_RETRIES
+     * times.  If it never passes, its values are not used.
+     *
+     * This does not change high volume measurements; binary packets always
+     * have a CRC.
+     *
+     * @param verifyCRC True to request and check a CRC on every data block
+     */
+    void setCRCVerification(bool verifyCRC);
+    /**
+     * @brief Get whether the sensor adds a CRC to its data.
+     *
+     * @return **bool** True if CRC verification is on.
+     */
+    bool getCRCVerification(void);
+    /**
+     * @brief Get the number of data blocks that have failed their CRC check.
+     *
+     * @return **uint16_t** The number of failed CRC checks since the sensor
+     * was created.
+     */
+    uint16_t getCRCFailureCount(void);
+
+    /**
+     * @brief Get the SDI-12 bus coordinator the sensor has been added to.
+     *
+     * @return **SDI12Bus\*** The bus, or nullptr if the sensor is not on one.
+     */
+    SDI12Bus* getBus(void);
+
  protected:
     /**
      * @brief Send the SDI-12 'acknowledge active' command [address][!] to a
      * sensor and confirm that the correct sensor responded.
      *
+     * @param maxTries The number of times to send the command before giving
+     * up.  Optional with a default value of 5.
      * @return **bool** True if the correct SDI-12 sensor replied to the
      * command.
      */
-    bool requestSensorAcknowledgement(void);
+    bool requestSensorAcknowledgement(uint8_t maxTries = 5);
     /**
      * @brief Send the SDI-12 'info' command [address][I][!] to a sensor and
      * parse the result into the vendor, model, version, and serial number.
@@ -274,10 +446,151 @@ class SDI12Sensors : public Sensor {
      * returned.
      */
     virtual bool getResults(void);
+    /**
+     * @brief Send a command to the sensor, prefixed with its address.
+     *
+     * @param command The command, without the address; for example "C!".
+     */
+    void sendSDI12Command(const char* command);
+    /**
+     * @brief Read the sensor's reply to a command into a response parser,
+     * character by character as it arrives.
+     *
+     * This returns as soon as the <CR><LF> ending the reply arrives, or when
+     * no character has arrived for the timeout.
+     *
+     * @param response The response parser to fill; it is reset first.
+     * @param timeout_ms The longest time to wait for each character.
+     * @return **bool** True if the full reply was received.
+     */
+    bool readSDI12Response(SDI12Response& response, uint32_t timeout_ms);
+    /**
+     * @brief Send a data request, [address][D][dataOption][!], and read the
+     * reply.
+     *
+     * For a sensor measuring continuously this sends
+     * [address][R][dataOption][!] instead.
+     *
+     * With CRC verification on, a reply that fails its CRC check is requested
+     * again, and the response is left empty if it never passes.
+     *
+     * @param dataOption The data block to request, 0-9, or 0-999 for a high
+     * volume measurement.
+     * @param response The response parser to fill with the reply.
+     * @return **bool** True if the full reply was received from the sensor's
+     * address.
+     */
+    bool requestSDI12Data(uint16_t dataOption, SDI12Response& response);
+    /**
+     * @brief Gets the results of a high volume binary measurement.
+     *
+     * The values of each packet are only added to the results once the
+     * packet has passed its CRC check.  A packet that fails is discarded and
+     * requested again, up to #SDI12_CRC_RETRIES times; if it never passes,
+     * no more packets are requested.
+     *
+     * @return **bool** True if the full number of expected results was
+     * returned.
+     */
+    bool getBinaryResults(void);
+    /**
+     * @brief The outcomes of reading a single binary packet.
+     */
+    enum binaryPacketStatus {
+        SDI12_PACKET_OK,       ///< A full packet passed its CRC check
+        SDI12_PACKET_EMPTY,    ///< An empty packet; there is no more data
+        SDI12_PACKET_BAD_CRC,  ///< A full packet failed its CRC check
+        SDI12_PACKET_MISSING,  ///< No full packet from this sensor arrived
+        SDI12_PACKET_INVALID   ///< The packet had an invalid type or size
+    };
+    /**
+     * @brief Request a single binary packet, [address][DB][packet][!], and
+     * read it.
+     *
+     * @param packet The packet number, 0-999
+     * @param values The array to hold the values of the packet
+     * @param room The most values to keep in the array
+     * @param count Set to the number of values kept in the array
+     * @return **binaryPacketStatus** Whether a full packet arrived and passed
+     * its CRC check.
+     */
+    binaryPacketStatus readBinaryPacket(uint16_t packet, float* values,
+                                        uint8_t room, uint8_t& count);
+    /**
+     * @brief Read raw bytes, as for a binary packet.
+     *
+     * @param buffer The buffer for the bytes
+     * @param length The number of bytes to read
+     * @param timeout_ms The longest time to wait for each byte
+     * @return **uint16_t** The number of bytes read.
+     */
+    uint16_t readSDI12Bytes(uint8_t* buffer, uint16_t length,
+                            uint32_t timeout_ms);
+    /**
+     * @brief Convert a value from a binary packet to a float.
+     *
+     * @param raw The little-endian bytes of the value
+     * @param type The SDI-12 binary data type, 1-10
+     * @return **float** The value, or -9999 if it is not a number.
+     */
+    static float decodeBinaryValue(uint64_t raw, uint8_t type);
+    /**
+     * @brief Write a data option, 0-999, followed by a '!' into a command.
+     *
+     * @param command Where to write; must have room for 5 characters.
+     * @param dataOption The data option
+     */
+    static void writeDataOption(char* command, uint16_t dataOption);
+    /**
+     * @brief Get the time the sensor should be given to finish its current
+     * measurement.
+     *
+     * @return **uint32_t** The wait the sensor announced if it is on an
+     * SDI12Bus, otherwise the measurement time of the sensor model.
+     */
+    uint32_t getMeasurementWait(void);
+    /**
+     * @brief Release the hold on the SDI12Bus taken when a concurrent
+     * measurement was started, if there is one.
+     */
+    void releaseBus(void);
     /**
      * @brief Internal reference to the SDI-12 object.
      */
     SDI12 _SDI12Internal;
+    /**
+     * @brief The SDI-12 object used to talk to the sensor.
+     *
+     * This is #_SDI12Internal unless the sensor has been added to an SDI12Bus,
+     * in which case every sensor on the bus shares one SDI-12 object.
+     */
+    SDI12* _SDI12Interface;
+    /**
+     * @brief The SDI-12 bus coordinator the sensor has been added to, if any.
+     */
+    SDI12Bus* _bus = nullptr;
+    /**
+     * @brief The wait in ms the sensor announced when its current
+     * measurement was started.
+     */
+    uint32_t _announcedWait_ms = 0;
+    /**
+     * @brief True while the sensor is holding its bus active for a
+     * measurement.
+     */
+    bool _holdingBus = false;
+    /**
+     * @brief How the sensor is asked for its values.
+     */
+    sdi12MeasurementStrategy _strategy = SDI12_MEASURE;
+    /**
+     * @brief True to request and check a CRC on every data block.
+     */
+    bool _verifyCRC = false;
+    /**
+     * @brief The number of data blocks that have failed their CRC check.
+     */
+    uint16_t _crcFailures = 0;
     /**
      * @brief Internal reference to the SDI-12 address.
      */
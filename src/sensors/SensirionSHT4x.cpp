@@ -34,6 +34,15 @@ String SensirionSHT4x::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType SensirionSHT4x::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t SensirionSHT4x::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+
+
 bool SensirionSHT4x::setup(void) {
     _i2c->begin();  // Start the wire library (sensor power not required)
     // Eliminate any potential extra waits in the wire library
@@ -71,10 +80,10 @@ bool SensirionSHT4x::setup(void) {
 
     // Set status bits
     if (!success) {
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
     retVal &= success;
 
@@ -91,9 +100,9 @@ bool SensirionSHT4x::addSingleMeasurementResult(void) {
     float humid_val = -9999;
     bool  ret_val   = false;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Make sure the heater is *not* going to run.  We want the ambient
@@ -123,8 +132,8 @@ bool SensirionSHT4x::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return ret_val;
 }
@@ -171,9 +180,8 @@ bool SensirionSHT4x::sleep(void) {
         _millisSensorActivated = 0;
         // Unset the measurement request time
         _millisMeasurementRequested = 0;
-        // Unset the status bits for sensor activation (bits 3 & 4) and
-        // measurement request (bits 5 & 6)
-        _sensorStatus &= 0b10000111;
+        // Return to the powered state
+        fallBackToState(SENSOR_POWERED);
         MS_DBG(F("Done"));
     } else {
         MS_DBG(getSensorNameAndLocation(),
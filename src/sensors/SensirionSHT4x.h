@@ -247,6 +247,14 @@ class SensirionSHT4x : public Sensor {
      * @return **String** Text describing how the sensor is attached to the mcu.
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
 
     /**
      * @brief Do any one-time preparations needed before the sensor will be able
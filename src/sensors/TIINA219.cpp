@@ -36,6 +36,15 @@ String TIINA219::getSensorLocation(void) {
 }
 
 
+// This sensor is on its I2C instance
+sensorBusType TIINA219::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t TIINA219::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_i2c);
+}
+
+
 bool TIINA219::setup(void) {
     bool wasOn;
     Sensor::setup();  // this will set pin modes and the setup status bit
@@ -77,9 +86,9 @@ bool TIINA219::addSingleMeasurementResult(void) {
     float busV_V     = -9999;
     float power_mW   = -9999;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Read values
@@ -106,8 +115,8 @@ bool TIINA219::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -9,6 +9,7 @@
  */
 
 #include "TallyCounterI2C.h"
+#include <Wire.h>
 
 
 // The constructor
@@ -28,6 +29,15 @@ String TallyCounterI2C::getSensorLocation(void) {
 }
 
 
+// This sensor is on the default I2C bus
+sensorBusType TallyCounterI2C::getBusType(void) {
+    return I2C_BUS;
+}
+uintptr_t TallyCounterI2C::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(&Wire);
+}
+
+
 bool TallyCounterI2C::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -51,10 +61,10 @@ bool TallyCounterI2C::setup(void) {
         ntries++;
     }
     if (!success) {
-        // Set the status error bit (bit 7)
-        _sensorStatus |= 0b10000000;
-        // UN-set the set-up bit (bit 0) since setup failed!
-        _sensorStatus &= 0b11111110;
+        // Set the status error bit
+        bitSet(_sensorStatus, SENSOR_ERROR_BIT);
+        // UN-set the set-up bit since setup failed!
+        bitClear(_sensorStatus, SENSOR_SETUP_BIT);
     }
     retVal &= success;
 
@@ -71,9 +81,9 @@ bool TallyCounterI2C::addSingleMeasurementResult(void) {
     // Initialize variables
     int16_t events = -9999;  // Number of events
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Read values
@@ -107,8 +117,8 @@ bool TallyCounterI2C::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     return success;
 }
@@ -200,6 +200,16 @@ class TallyCounterI2C : public Sensor {
      */
 
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     *
+     * This sensor is always on the default TwoWire instance, Wire.
+     */
+    uintptr_t getBusId(void) override;
 
     // bool startSingleMeasurement(void) override;  // for forced mode
     /**
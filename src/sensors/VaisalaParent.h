@@ -87,6 +87,8 @@
 #include "SensorBase.h"
 #include <VaisalaModbus.h>
 
+class ModbusBus;
+
 // Sensor Specific Defines
 /** @ingroup vaisala_group */
 /**@{*/
@@ -102,6 +104,8 @@
  */
 /* clang-format on */
 class VaisalaParent : public Sensor {
+    friend class ModbusBus;
+
  public:
     /**
      * @brief Construct a new Vaisala Parent object.  This is only intended
@@ -162,6 +166,21 @@ class VaisalaParent : public Sensor {
      * @copydoc Sensor::getSensorLocation()
      */
     String getSensorLocation(void) override;
+    /**
+     * @copydoc Sensor::getBusType()
+     */
+    sensorBusType getBusType(void) override;
+    /**
+     * @copydoc Sensor::getBusId()
+     */
+    uintptr_t getBusId(void) override;
+    /**
+     * @copydoc Sensor::probeReadiness()
+     *
+     * The sensor is ready once it answers a single modbus register read,
+     * with a short timeout and no retries.
+     */
+    bool probeReadiness(void) override;
 
     /**
      * @brief Do any one-time preparations needed before the sensor will be able
@@ -191,19 +210,43 @@ class VaisalaParent : public Sensor {
     // Override these to use two power pins
     void powerUp(void) override;
     void powerDown(void) override;
+    /**
+     * @copydoc Sensor::getSecondaryPowerPin()
+     */
+    int8_t getSecondaryPowerPin(void) override;
 
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
 
+    /**
+     * @brief Get the modbus bus manager the sensor has been added to.
+     *
+     * @return **ModbusBus\*** The bus, or nullptr if the sensor is not on one.
+     */
+    ModbusBus* getBus(void);
+
  private:
+    /**
+     * @brief Open a transaction on the modbus bus, if the sensor is on one.
+     *
+     * @return **bool** True if the sensor may talk on the line: either it is
+     * not on a bus, or its transaction was opened.
+     */
+    bool beginBusTransaction(void);
+    /**
+     * @brief Close the transaction opened by beginBusTransaction().
+     */
+    void endBusTransaction(void);
+
     vaisala      _vsensor;
     vaisalaModel _model;
     byte            _modbusAddress;
     Stream*         _stream;
     int8_t          _RS485EnablePin;
     int8_t          _powerPin2;
+    ModbusBus*      _bus;
 };
 
 #endif  // SRC_SENSORS_VAISALAPARENT_H_
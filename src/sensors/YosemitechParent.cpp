@@ -8,6 +8,7 @@
  */
 
 #include "YosemitechParent.h"
+#include "ModbusBus.h"
 
 // The constructor - need the sensor type, modbus address, power pin, stream for
 // data, and number of readings to average
@@ -24,7 +25,8 @@ YosemitechParent::YosemitechParent(
       _modbusAddress(modbusAddress),
       _stream(stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2),
+      _bus(nullptr) {}
 YosemitechParent::YosemitechParent(
     byte modbusAddress, Stream& stream, int8_t powerPin, int8_t powerPin2,
     int8_t enablePin, uint8_t measurementsToAverage, yosemitechModel model,
@@ -38,7 +40,8 @@ YosemitechParent::YosemitechParent(
       _modbusAddress(modbusAddress),
       _stream(&stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2),
+      _bus(nullptr) {}
 // Destructor
 YosemitechParent::~YosemitechParent() {}
 
@@ -52,6 +55,55 @@ String YosemitechParent::getSensorLocation(void) {
 }
 
 
+// This sensor is on the modbus stream
+sensorBusType YosemitechParent::getBusType(void) {
+    return MODBUS_BUS;
+}
+uintptr_t YosemitechParent::getBusId(void) {
+    return reinterpret_cast<uintptr_t>(_stream);
+}
+// The sensor is ready once it answers a single register read; the full read
+// of the sensor library retries with long timeouts, which would hold up every
+// other sensor
+bool YosemitechParent::probeReadiness(void) {
+    if (!beginBusTransaction()) { return false; }
+    bool ready = ModbusBus::probeAddress(_stream, _modbusAddress,
+                                         _RS485EnablePin);
+    endBusTransaction();
+    return ready;
+}
+
+
+// The pin controlling power to the RS485 adapter
+int8_t YosemitechParent::getSecondaryPowerPin(void) {
+    return _powerPin2;
+}
+
+
+ModbusBus* YosemitechParent::getBus(void) {
+    return _bus;
+}
+// A sensor on a bus only talks on the line inside its own transaction, and
+// only ends a transaction it opened
+bool YosemitechParent::beginBusTransaction(void) {
+    return _bus == nullptr || _bus->beginTransaction();
+}
+void YosemitechParent::endBusTransaction(void) {
+    if (_bus != nullptr) { _bus->endTransaction(); }
+}
+// The sensor is switched to the pins of the bus once it has joined
+bool ModbusBus::addSensor(YosemitechParent* sensor) {
+    if (sensor == nullptr || sensor->_bus != nullptr) { return false; }
+    if (!attachSensor(sensor, sensor->_modbusAddress, sensor->_stream)) {
+        return false;
+    }
+    sensor->_RS485EnablePin = _enablePin;
+    sensor->_powerPin2      = _adapterPowerPin;
+    sensor->_bus            = this;
+    return true;
+}
+
+
 bool YosemitechParent::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
@@ -85,7 +137,10 @@ bool YosemitechParent::wake(void) {
     MS_DBG(F("Start Measurement on"), getSensorNameAndLocation());
     while (!success && ntries < 5) {
         MS_DBG('(', ntries + 1, F("):"));
-        success = _ysensor.startMeasurement();
+        if (beginBusTransaction()) {
+            success = _ysensor.startMeasurement();
+            endBusTransaction();
+        }
         ntries++;
     }
 
@@ -95,10 +150,10 @@ bool YosemitechParent::wake(void) {
         MS_DBG(getSensorNameAndLocation(), F("activated and measuring."));
     } else {
         MS_DBG(getSensorNameAndLocation(), F("was NOT activated!"));
-        // Make sure the activation time is zero and the wake success bit (bit
-        // 4) is unset
+        // Make sure the activation time is zero and fall back to the wake
+        // attempt
         _millisSensorActivated = 0;
-        _sensorStatus &= 0b11101111;
+        fallBackToState(SENSOR_WAKE_ATTEMPTED);
     }
 
     // Manually activate the brush
@@ -106,7 +161,12 @@ bool YosemitechParent::wake(void) {
     if (_model == Y511 || _model == Y514 || _model == Y551 || _model == Y560 ||
         _model == Y4000) {
         MS_DBG(F("Activate Brush on"), getSensorNameAndLocation());
-        if (_ysensor.activateBrush()) {
+        bool brushed = false;
+        if (beginBusTransaction()) {
+            brushed = _ysensor.activateBrush();
+            endBusTransaction();
+        }
+        if (brushed) {
             MS_DBG(F("Brush activated."));
         } else {
             MS_DBG(F("Brush NOT activated!"));
@@ -132,7 +192,10 @@ bool YosemitechParent::sleep(void) {
     MS_DBG(F("Stop Measurement on"), getSensorNameAndLocation());
     while (!success && ntries < 5) {
         MS_DBG('(', ntries + 1, F("):"));
-        success = _ysensor.stopMeasurement();
+        if (beginBusTransaction()) {
+            success = _ysensor.stopMeasurement();
+            endBusTransaction();
+        }
         ntries++;
     }
     if (success) {
@@ -140,9 +203,8 @@ bool YosemitechParent::sleep(void) {
         _millisSensorActivated = 0;
         // Unset the measurement request time
         _millisMeasurementRequested = 0;
-        // Unset the status bits for sensor activation (bits 3 & 4) and
-        // measurement request (bits 5 & 6)
-        _sensorStatus &= 0b10000111;
+        // Return to the powered state
+        fallBackToState(SENSOR_POWERED);
         MS_DBG(F("Measurements stopped."));
     } else {
         MS_DBG(F("Measurements NOT stopped!"));
@@ -161,7 +223,10 @@ void YosemitechParent::powerUp(void) {
         // Mark the time that the sensor was powered
         _millisPowerOn = millis();
     }
-    if (_powerPin2 >= 0) {
+    if (_bus != nullptr) {
+        // The bus keeps the adapter on for every sensor sharing it
+        _bus->holdAdapterPower(this);
+    } else if (_powerPin2 >= 0) {
         MS_DBG(F("Applying secondary power to"), getSensorNameAndLocation(),
                F("with pin"), _powerPin2);
         digitalWrite(_powerPin2, HIGH);
@@ -170,8 +235,8 @@ void YosemitechParent::powerUp(void) {
         MS_DBG(F("Power to"), getSensorNameAndLocation(),
                F("is not controlled by this library."));
     }
-    // Set the status bit for sensor power attempt (bit 1) and success (bit 2)
-    _sensorStatus |= 0b00000110;
+    // Mark the sensor as powered, without forgetting that it may be awake
+    advanceToState(SENSOR_POWERED);
 }
 
 
@@ -187,11 +252,13 @@ void YosemitechParent::powerDown(void) {
         _millisSensorActivated = 0;
         // Unset the measurement request time
         _millisMeasurementRequested = 0;
-        // Unset the status bits for sensor power (bits 1 & 2),
-        // activation (bits 3 & 4), and measurement request (bits 5 & 6)
-        _sensorStatus &= 0b10000001;
+        // Return to the unpowered state
+        setState(SENSOR_UNPOWERED);
     }
-    if (_powerPin2 >= 0) {
+    if (_bus != nullptr) {
+        // The adapter is only switched off once no sensor on the bus needs it
+        _bus->releaseAdapterPower(this);
+    } else if (_powerPin2 >= 0) {
         MS_DBG(F("Turning off secondary power to"), getSensorNameAndLocation(),
                F("with pin"), _powerPin2);
         digitalWrite(_powerPin2, LOW);
@@ -208,9 +275,9 @@ void YosemitechParent::powerDown(void) {
 bool YosemitechParent::addSingleMeasurementResult(void) {
     bool success = false;
 
-    // Check a measurement was *successfully* started (status bit 6 set)
+    // Check a measurement was *successfully* started
     // Only go on to get a result if it was
-    if (bitRead(_sensorStatus, 6)) {
+    if (getState() == SENSOR_MEASURING) {
         switch (_model) {
             case Y4000: {
                 // Initialize float variables
@@ -225,8 +292,11 @@ bool YosemitechParent::addSingleMeasurementResult(void) {
 
                 // Get Values
                 MS_DBG(F("Get Values from"), getSensorNameAndLocation());
-                success = _ysensor.getValues(DOmgL, Turbidity, Cond, pH, Temp,
-                                             ORP, Chlorophyll, BGA);
+                if (beginBusTransaction()) {
+                    success = _ysensor.getValues(DOmgL, Turbidity, Cond, pH,
+                                                 Temp, ORP, Chlorophyll, BGA);
+                    endBusTransaction();
+                }
 
                 // Fix not-a-number values
                 if (!success || isnan(DOmgL)) DOmgL = -9999;
@@ -265,7 +335,11 @@ bool YosemitechParent::addSingleMeasurementResult(void) {
 
                 // Get Values
                 MS_DBG(F("Get Values from"), getSensorNameAndLocation());
-                success = _ysensor.getValues(parmValue, tempValue, thirdValue);
+                if (beginBusTransaction()) {
+                    success = _ysensor.getValues(parmValue, tempValue,
+                                                 thirdValue);
+                    endBusTransaction();
+                }
 
                 // Fix not-a-number values
                 if (!success || isnan(parmValue)) parmValue = -9999;
@@ -295,8 +369,8 @@ bool YosemitechParent::addSingleMeasurementResult(void) {
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
-    // Unset the status bits for a measurement request (bits 5 & 6)
-    _sensorStatus &= 0b10011111;
+    // Return to the awake state now that the measurement is done
+    fallBackToState(SENSOR_AWAKE);
 
     // Return true when finished
     return success;